@@ -0,0 +1,125 @@
+#include "ns3/core-module.h"
+#include "ns3/sparkrtc-module.h"
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("HairpinSolve");
+
+// Regenerate the Hairpin beta and block-size tables for another QoE
+// coefficient, deadline range or grid resolution. The default grid is the
+// one HairpinPolicy indexes, so the tables can be passed to rtc-test with
+// --fectables directly:
+//
+//   ./ns3 run "hairpin-solve --coeff=1e-6 --output=tables"
+//   ./ns3 run "rtc-test --fecPolicy=hairpin --coeff=1e-6 --fectables=tables"
+//
+// Every axis is given as "<start>:<step>:<count>", e.g. --loss=0:0.005:101.
+//
+// With --check the solved beta table is compared entry by entry with an
+// existing one, e.g. the shipped table, which the defaults reproduce:
+//
+//   ./ns3 run "hairpin-solve --check=src/sparkrtc/model/fec/beta-array-rtx1-cap0-coeff1e-07.bin --block=0"
+
+static std::vector<uint8_t>
+ReadTable (std::string path)
+{
+  std::ifstream file (path, std::ifstream::binary);
+  if (!file.is_open ()) {
+    NS_FATAL_ERROR ("Cannot read the table " + path);
+  }
+  return std::vector<uint8_t> (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+}
+
+static void
+ParseAxis (std::string value, HairpinSolver::Axis & axis)
+{
+  if (value.empty ())
+    return;
+  std::stringstream ss (value);
+  char sep1 = 0, sep2 = 0;
+  ss >> axis.start >> sep1 >> axis.step >> sep2 >> axis.count;
+  if (ss.fail () || sep1 != ':' || sep2 != ':' || axis.count == 0)
+    NS_FATAL_ERROR ("Axis " + axis.name + " must be <start>:<step>:<count>, got " + value);
+}
+
+int
+main (int argc, char *argv[])
+{
+    HairpinSolver::Config config;
+    std::string output = ".";
+    bool block = true;
+    std::string loss, frame, layer, packet, ddl, rtt, rdisp;
+    std::string check;
+
+    CommandLine cmd;
+    cmd.AddValue("coeff",    "QoE coefficient, the weight of the bandwidth against the deadline misses", config.coeff);
+    cmd.AddValue("rtx",      "Blocks missing after a round are retransmitted", config.isRtx);
+    cmd.AddValue("cap",      "At most as many FEC packets as data packets", config.isCap);
+    cmd.AddValue("maxratio", "Largest ratio of FEC to data packets without --cap", config.maxFecRatio);
+    cmd.AddValue("maxfec",   "Largest number of FEC packets of a block, < 255", config.maxFecCnt);
+    cmd.AddValue("threads",  "Solver threads, 0 for one per core", config.threads);
+    cmd.AddValue("block",    "Also write the block-size table", block);
+    cmd.AddValue("output",   "Directory of the tables", output);
+    cmd.AddValue("check",    "Beta table to compare the solved one with, entry by entry", check);
+    cmd.AddValue("loss",     "Loss rate axis", loss);
+    cmd.AddValue("frame",    "Frame size axis, in packets", frame);
+    cmd.AddValue("layer",    "Remaining rounds axis of the beta table", layer);
+    cmd.AddValue("packet",   "Block size axis of the beta table, in packets", packet);
+    cmd.AddValue("ddl",      "Deadline axis of the block table, in ms", ddl);
+    cmd.AddValue("rtt",      "RTT axis of the block table, in ms", rtt);
+    cmd.AddValue("rdisp",    "Per-packet dispersion axis of the block table, in ms", rdisp);
+    cmd.Parse (argc, argv);
+
+    ParseAxis (loss, config.loss);
+    ParseAxis (frame, config.frame);
+    ParseAxis (layer, config.layer);
+    ParseAxis (packet, config.packet);
+    ParseAxis (ddl, config.ddl);
+    ParseAxis (rtt, config.rtt);
+    ParseAxis (rdisp, config.rdisp);
+
+    HairpinSolver solver (config);
+    auto start = std::chrono::steady_clock::now ();
+    solver.Solve ();
+    double_t elapsed = std::chrono::duration<double_t> (std::chrono::steady_clock::now () - start).count ();
+    if (!solver.Write (output, block)) {
+      NS_FATAL_ERROR ("Cannot write the tables to " + output);
+    }
+    std::cout << "Solved " << solver.GetBetaTable ().size () << " beta and "
+              << (block ? solver.GetBlockTable ().size () : 0) << " block entries in "
+              << elapsed << "s -> " << output << std::endl;
+
+    if (!check.empty ()) {
+      const std::vector<uint8_t> & solved = solver.GetBetaTable ();
+      std::vector<uint8_t> expected = ReadTable (check);
+      if (expected.size () != solved.size ()) {
+        NS_FATAL_ERROR ("The beta table " + check + " has " + std::to_string (expected.size ())
+                        + " entries, the solved one " + std::to_string (solved.size ()));
+      }
+      /* row-major [loss][frame][layer][packet] */
+      uint64_t diff = 0;
+      for (uint64_t i = 0; i < solved.size (); i++) {
+        if (solved[i] == expected[i])
+          continue;
+        if (diff++ < 10) {
+          uint64_t rest = i;
+          uint32_t pi = rest % config.packet.count; rest /= config.packet.count;
+          uint32_t li = rest % config.layer.count; rest /= config.layer.count;
+          uint32_t fi = rest % config.frame.count; rest /= config.frame.count;
+          std::cout << "loss " << config.loss.At (rest) << " frame " << config.frame.At (fi)
+                    << " layer " << config.layer.At (li) << " packet " << config.packet.At (pi)
+                    << ": solved " << (int) solved[i] << ", expected " << (int) expected[i] << std::endl;
+        }
+      }
+      if (diff > 0) {
+        NS_FATAL_ERROR (std::to_string (diff) + " of " + std::to_string (solved.size ())
+                        + " entries differ from " + check);
+      }
+      std::cout << "All " << solved.size () << " entries match " << check << std::endl;
+    }
+    return 0;
+}
@@ -7,10 +7,13 @@
 #include "ns3/nstime.h"
 #include "ns3/sparkrtc-module.h"
 #include "ns3/flow-monitor-module.h"
+#include "ns3/traffic-control-module.h"
 #include "ns3/common-header.h"
 
 #include <memory>
 #include <fstream>
+#include <sstream>
+#include <vector>
 #include <boost/filesystem.hpp>
 
 
@@ -48,7 +51,16 @@ static NodeContainer BuildExampleTopo (uint64_t bps,
                                        double_t ms_delay,
                                        uint32_t msQdelay,
                                        std::string dir,
-                                       bool isPcapEnabled)
+                                       bool isPcapEnabled,
+                                       Ptr<TraceStore> traceStore,
+                                       bool bwChange,
+                                       uint16_t interval,
+                                       std::string deliveryTrace,
+                                       double_t lossRate,
+                                       double_t burstLen,
+                                       Ptr<CrossTraffic> crossTraffic,
+                                       std::string aqm,
+                                       Ptr<ZhugeAgent> zhuge)
 {
   NS_LOG_INFO ("Create nodes.");
   NodeContainer c;
@@ -60,18 +72,72 @@ static NodeContainer BuildExampleTopo (uint64_t bps,
   internet.Install (c);
 
   NS_LOG_INFO ("Create channels.");
+  NetDeviceContainer d0d1, d2d1;
   PointToPointHelper p2p;
-  /* Far beyond max bw, related to delay smoothness params */
-  p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (1e9)));
-  p2p.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (ms_delay - 1)));
-  NetDeviceContainer d0d1 = p2p.Install (n0n1);
-
-  DEBUG("bps: " << bps << ", ms_delay: " << ms_delay);
-  // PointToPointHelper p2p2;
-  p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (bps)));
-  p2p.SetChannelAttribute ("Delay", StringValue("1ms"));
-  p2p.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("1000p"));
-  NetDeviceContainer d2d1 = p2p.Install (n2n1);
+  TraceLinkHelper traceLink;
+  bool useTraceLink = traceStore != NULL || !deliveryTrace.empty ();
+  /* with an AQM the queue builds in the queue disc, keep the device queue short */
+  std::string bottleneckQueue = aqm == "none" ? "1000p" : "2p";
+  if (!useTraceLink) {
+    /* Far beyond max bw, related to delay smoothness params */
+    p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (1e9)));
+    p2p.SetChannelAttribute ("Delay", TimeValue (MilliSeconds (ms_delay - 1)));
+    d0d1 = p2p.Install (n0n1);
+
+    DEBUG("bps: " << bps << ", ms_delay: " << ms_delay);
+    // PointToPointHelper p2p2;
+    p2p.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (bps)));
+    p2p.SetChannelAttribute ("Delay", StringValue("1ms"));
+    p2p.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue(bottleneckQueue));
+    d2d1 = p2p.Install (n2n1);
+  }
+  else {
+    /* Network varies according to the trace, looked up per packet by the devices:
+       n0-n1: delay rtt/2 - 1ms in both directions, trace loss on n0 -> n1
+       n1-n2: 1ms, n1 -> n2 rate limited to 1.5 * trace bw if bwChange,
+              or replaying the Mahimahi delivery trace if given */
+    traceLink.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (1e9)));
+    traceLink.SetDeviceAttribute ("Delay", TimeValue (MilliSeconds (ms_delay - 1)));
+    if (traceStore != NULL) {
+      traceLink.SetTraceStore (traceStore, Seconds (0), MilliSeconds (interval));
+      traceLink.SetDeviceAttribute ("TraceDelay", BooleanValue (true));
+      traceLink.SetDeviceAttribute ("TraceDelayOffset", TimeValue (MilliSeconds (1)));
+    }
+    d0d1 = traceLink.Install (n0n1);
+    if (traceStore != NULL && burstLen <= 0 && !traceStore->HasBurstParams ()) {
+      d0d1.Get (0)->SetAttribute ("TraceLoss", BooleanValue (true));
+      DynamicCast<TraceLinkNetDevice> (d0d1.Get (0))->AssignStreams (1);
+    }
+
+    traceLink.SetDeviceAttribute ("DataRate", DataRateValue (DataRate (bps)));
+    traceLink.SetDeviceAttribute ("TraceDelay", BooleanValue (false));
+    traceLink.SetDeviceAttribute ("Delay", TimeValue (MilliSeconds (1)));
+    traceLink.SetQueue ("ns3::DropTailQueue<Packet>", "MaxSize", StringValue (bottleneckQueue));
+    d2d1 = traceLink.Install (n2n1);
+    if (!deliveryTrace.empty ()) {
+      DynamicCast<TraceLinkNetDevice> (d2d1.Get (1))->SetDeliveryTrace (deliveryTrace, Seconds (0));
+    }
+    else if (bwChange) {
+      d2d1.Get (1)->SetAttribute ("TraceRateScale", DoubleValue (1.5));
+    }
+  }
+
+  if (aqm != "none") {
+    /* ECN-marking AQM on the n1 -> n2 bottleneck, installed before the
+       address assignment which would add the default queue disc */
+    TrafficControlHelper tch;
+    if (aqm == "codel")
+      tch.SetRootQueueDisc ("ns3::CoDelQueueDisc", "UseEcn", BooleanValue (true));
+    else if (aqm == "fqcodel")
+      tch.SetRootQueueDisc ("ns3::FqCoDelQueueDisc", "UseEcn", BooleanValue (true));
+    else if (aqm == "l4s")
+      /* shallow CE marking of ECT(1) packets, classic packets keep the CoDel target */
+      tch.SetRootQueueDisc ("ns3::FqCoDelQueueDisc", "UseEcn", BooleanValue (true),
+        "UseL4s", BooleanValue (true), "CeThreshold", TimeValue (MilliSeconds (1)));
+    else
+      NS_FATAL_ERROR ("Unknown AQM: " + aqm);
+    tch.Install (d2d1.Get (1));
+  }
 
   NS_LOG_INFO ("Assign IP Addresses.");
   Ipv4AddressHelper ipv4;
@@ -80,13 +146,29 @@ static NodeContainer BuildExampleTopo (uint64_t bps,
   ipv4.SetBase ("10.1.2.0", "255.255.255.0");
   ipv4.Assign (d2d1);
 
+  if (zhuge != NULL) {
+    /* delay hints from n1, which sees the n1 -> n2 queue build up */
+    zhuge->Install (d2d1.Get (1));
+  }
+
+  if (crossTraffic != NULL) {
+    /* cross traffic enters at n1 and competes for the n1 -> n2 bottleneck */
+    crossTraffic->Install (c.Get (1), c.Get (2), 9000);
+    crossTraffic->AssignStreams (2);
+  }
+
   NS_LOG_INFO ("Use global routing.");
   Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
 
   if (isPcapEnabled) {
-    p2p.EnablePcapAll (dir + "/pcap");
-    AsciiTraceHelper ascii;
-    p2p.EnableAsciiAll (ascii.CreateFileStream (dir + "/pcap.log"));
+    if (!useTraceLink) {
+      p2p.EnablePcapAll (dir + "/pcap");
+      AsciiTraceHelper ascii;
+      p2p.EnableAsciiAll (ascii.CreateFileStream (dir + "/pcap.log"));
+    }
+    else {
+      traceLink.EnablePcapAll (dir + "/pcap");
+    }
   }
 
 
@@ -94,165 +176,99 @@ static NodeContainer BuildExampleTopo (uint64_t bps,
   //TrafficControlHelper tch;
   //tch.Uninstall (devices);
 
-	// add random loss
-	std::string errorModelType = "ns3::RateErrorModel";
-  ObjectFactory factory;
-  factory.SetTypeId (errorModelType);
-  Ptr<ErrorModel> em = factory.Create<ErrorModel> ();
-	d0d1.Get(1)->SetAttribute ("ReceiveErrorModel", PointerValue (em)); /* Set error model for n1 */
+  if (burstLen > 0 || (traceStore != NULL && traceStore->HasBurstParams ())) {
+    // add burst loss, the trace decides the parameters if given
+    Ptr<GilbertElliottErrorModel> em = CreateObject<GilbertElliottErrorModel> ();
+    em->SetAttribute ("MeanBurstLength", DoubleValue (burstLen));
+    if (traceStore != NULL) {
+      em->SetTraceStore (traceStore, Seconds (0), MilliSeconds (interval));
+    }
+    else if (lossRate > 0) {
+      double_t r = 1. / MAX (burstLen, 1.);
+      em->SetParams (lossRate >= 1 ? 1 : MIN (r * lossRate / (1 - lossRate), 1.), r);
+    }
+    em->AssignStreams (0);
+    d0d1.Get(1)->SetAttribute ("ReceiveErrorModel", PointerValue (em)); /* Set error model for n1 */
+  }
+  else if (traceStore == NULL) {
+	  // add random loss, the trace decides the loss rate otherwise
+	  std::string errorModelType = "ns3::RateErrorModel";
+    ObjectFactory factory;
+    factory.SetTypeId (errorModelType);
+    Ptr<ErrorModel> em = factory.Create<ErrorModel> ();
+	  d0d1.Get(1)->SetAttribute ("ReceiveErrorModel", PointerValue (em)); /* Set error model for n1 */
+  }
 
   return c;
 }
 
-double_t oldDelay, newDelay;
-double_t remainInterval;
-std::streampos pos = std::ios::beg;
-double_t minSetIntervalMs = 0.013;
-double_t maxAllowedDiffMs = 0.011;
-
-
 double_t appStart          = 0.;
 double_t appStop;
 
-void BandwidthTrace (Ptr<Node> node0, 
-                     Ptr<Node> node1, 
-                     std::string trace, 
-                     bool bwChange, 
-                     int interval,
-                     bool readNewLine) {
-  Ptr<PointToPointNetDevice> n0SndDev = StaticCast<PointToPointNetDevice,NetDevice> (node0->GetDevice (1));
-  Ptr<PointToPointNetDevice> n1RcvDev = StaticCast<PointToPointNetDevice,NetDevice> (node1->GetDevice (1));
-  Ptr<PointToPointNetDevice> n1SndDev = StaticCast<PointToPointNetDevice,NetDevice> (node1->GetDevice (2));
-  std::ifstream traceFile;
-  std::string newBwStr = "300Mbps";
-  double newErrorRate = DEFAULT_ERROR_RATE;
-  NS_ASSERT (maxAllowedDiffMs <= minSetIntervalMs);
-
-  if (readNewLine) {
-    std::string traceLine;
-    StringVector traceData;
-    StringVector bwValue;
-    StringVector rttValue;
-
-    traceLine.clear ();
-    traceFile.open (trace);
-    traceFile.seekg (pos);
-    std::getline (traceFile, traceLine);
-    pos = traceFile.tellg ();
-    if (traceLine.find (' ') == std::string::npos) {
-      traceFile.close ();
-      return;
-    }
-    rttValue.clear ();
-    bwValue.clear ();
-    traceData.clear ();
-    traceData = SplitString(traceLine, " ");
-    bwValue = SplitString(traceData[0], "Mbps");
-    rttValue = SplitString(traceData[1], "ms");
-    
-    /* Set delay of n0-n1 as rtt/2 - 1, the delay of n1-n2 is 1ms */ 
-    newDelay = std::stod (rttValue[0]) / 2. - 1;
-    newBwStr = std::to_string (std::stod (bwValue[0]) * 1.5) + "Mbps";
-    newErrorRate = std::stod (traceData[2]);
-    NS_LOG_FUNCTION (Simulator::Now ().GetMilliSeconds () << 
-      " delay " << newDelay << " bw " << newBwStr << " errorRate " << newErrorRate);
-
-    if (bwChange) {
-      // Set bandwidth
-      n1SndDev->SetAttribute ("DataRate", StringValue (newBwStr));
-    }
+/* Split a comma-separated per-flow option, flow i takes the last entry if there are fewer */
+static std::vector<std::string> SplitFlowOption (std::string value, uint32_t nFlows)
+{
+  std::vector<std::string> items;
+  std::stringstream ss (value);
+  std::string item;
+  while (std::getline (ss, item, ','))
+    items.push_back (item);
+  if (items.empty ())
+    items.push_back ("");
+  while (items.size () < nFlows)
+    items.push_back (items.back ());
+  return items;
+}
 
-    // Set error rate
-    ObjectFactory factoryErrModel;
-    factoryErrModel.SetTypeId ("ns3::RateErrorModel");
-    factoryErrModel.Set ("ErrorUnit", EnumValue (RateErrorModel::ERROR_UNIT_PACKET),
-                         "ErrorRate", DoubleValue (newErrorRate));
-    Ptr<ErrorModel> em = factoryErrModel.Create<ErrorModel> ();
-    n1RcvDev->SetAttribute ("ReceiveErrorModel", PointerValue (em));
-    remainInterval = interval;
-  }
-  
-  /* Set propagation delay, smoothsize to decrease 0.3ms every 0.33ms to avoid out of order
-     These values are calculated based on 30Mbps and 1500B MTU --> 0.4ms / pkt */
-  Ptr<Channel> channel = n0SndDev->GetChannel ();
-  bool smoothDecrease = newDelay < oldDelay - maxAllowedDiffMs ? 1 : 0;
-  oldDelay = smoothDecrease ? (oldDelay - maxAllowedDiffMs) : newDelay;
-  channel->SetAttribute ("Delay", StringValue (std::to_string (oldDelay) + "ms"));
-  if (smoothDecrease && remainInterval > minSetIntervalMs) {
-    Simulator::Schedule (MicroSeconds (minSetIntervalMs * 1000), &BandwidthTrace, node0, node1, trace, 
-      bwChange, interval, false);
-    remainInterval -= minSetIntervalMs;
-  } else {
-    if ((!traceFile.eof ()) && Simulator::Now () < Seconds (appStop + 2)) {
-      traceFile.close ();
-      Simulator::Schedule (MicroSeconds (remainInterval * 1000), &BandwidthTrace, node0, node1, trace, 
-        bwChange, interval, true);
+static Ptr<FECPolicy> CreateFecPolicy (std::string fecPolicy, uint16_t delayDdl, double_t qoeCoeff, double_t param1)
+{
+    Ptr<FECPolicy> fecPolicyIns;
+    if(fecPolicy == "hairpin" || fecPolicy == "hairpinbound") {
+        fecPolicyIns = CreateObject<HairpinPolicy> (delayDdl, qoeCoeff, 1, 0);
+    } else if(fecPolicy == "hairpinone") {
+        fecPolicyIns = CreateObject<HairpinPolicy> (0, qoeCoeff, 1, 0);
+    } else if(fecPolicy == "fixed") {
+        fecPolicyIns = CreateObject<FixedPolicy> (param1);
+    } else if(fecPolicy == "webrtc") {
+        fecPolicyIns = CreateObject<WebRTCPolicy> ();
+    } else if(fecPolicy == "awebrtc") {
+        fecPolicyIns = CreateObject<WebRTCAdaptivePolicy> ();
+    // } else if(fecPolicy == "sqrt") {
+    //     fecPolicyIns = CreateObject<WebRTCStarPolicy> (0);
+    } else if(fecPolicy == "lin") {
+        fecPolicyIns = CreateObject<WebRTCStarPolicy> (1, param1);
+    // } else if(fecPolicy == "quad") {
+    //     fecPolicyIns = CreateObject<WebRTCStarPolicy> (2);
+    } else if(fecPolicy == "rtx") {
+        fecPolicyIns = CreateObject<RtxOnlyPolicy> ();
+    // } else if(fecPolicy == "fec" || fecPolicy == "feconly") {
+    //     fecPolicyIns = CreateObject<HairpinPolicy> (delayDdl, (uint8_t) qoeCoeffPow, 0, 0);
+    } else if(fecPolicy == "bolot") {
+        fecPolicyIns = CreateObject<BolotPolicy> ();
+    } else if(fecPolicy == "usf") {
+        fecPolicyIns = CreateObject<UsfPolicy> ();
+    } else if(fecPolicy == "fixedrtx") {
+        fecPolicyIns = CreateObject<FixedRtxPolicy> (param1);
+    } else if(fecPolicy == "tokenrtx") {
+        fecPolicyIns = CreateObject<TokenRtxPolicy> ();
+    } else {
+        NS_ASSERT_MSG(false, "FECPolicy must be one of [hairpin, hairpinbound, fixed, webrtc, awebrtc, rtx, fec].");
     }
-  } 
+    return fecPolicyIns;
 }
 
-static void InstallApp (Ptr<Node> sender,
-                        Ptr<Node> receiver,
-                        uint16_t port,
-                        float startTime_s,
-                        float stopTime_s,
-                        Ptr<FECPolicy> fecPolicy,
-                        std::string rtxPolicy,
-                        uint8_t fps,
-                        uint16_t interval,
-                        uint8_t delay_ddl_ms,
-                        uint32_t bitrate_bps,
-                        int ccOption,
-                        uint16_t default_rtt /* in ms */,
-                        double_t default_bw/* in Mbps */,
-                        double_t default_loss,
-                        uint32_t receiver_window/* in ms*/,
-                        bool set_trace,
-                        std::string tracefile,
-                        std::string dir)
+/* Log directory name of a policy pair */
+static std::string PolicyDirName (std::string rtxPolicy, std::string fecPolicy, double_t qoeCoeff, double_t param1)
 {
-  AsciiTraceHelper ascii;
-  std::string fecLogFileName = dir + "/fec.log";
-  std::string appLogFileName = dir + "/app.log";
-  std::string debugLogFileName = dir + "/debug.log";
-  Ptr<OutputStreamWrapper> fecStream = ascii.CreateFileStream (fecLogFileName);
-  Ptr<OutputStreamWrapper> appStream = ascii.CreateFileStream (appLogFileName);
-  Ptr<OutputStreamWrapper> debugStream = ascii.CreateFileStream (debugLogFileName);
-
-  // Install applications
-  Ptr<GameServer> sendApp = CreateObject<GameServer> ();
-  Ptr<GameClient> recvApp = CreateObject<GameClient> ();
-
-  Ptr<Ipv4> ipv4_recv = receiver->GetObject<Ipv4> ();
-  Ipv4Address receiverIp = ipv4_recv->GetAddress (1, 0).GetLocal ();
-  Ptr<Ipv4> ipv4_send = sender->GetObject<Ipv4> ();
-  Ipv4Address senderIp = ipv4_send->GetAddress (1, 0).GetLocal ();
-
-  sender->AddApplication (sendApp);
-  receiver->AddApplication (recvApp);
-
-  sendApp->Setup (
-    senderIp, port, receiverIp, port,
-    fps, MilliSeconds(delay_ddl_ms), bitrate_bps / 1e3, interval,
-    fecPolicy, rtxPolicy, MilliSeconds (receiver_window),
-    default_rtt, default_bw, default_loss, 0.01,
-    set_trace, tracefile, fecStream, debugStream
-  );
-  recvApp->Setup (senderIp, port, port, fps, MicroSeconds(delay_ddl_ms * 1e3), receiver_window * 1000, default_rtt,
-    appStream, debugStream);
-
-  EventId stop_encoding_event = Simulator::Schedule(Seconds(stopTime_s), &GameServer::StopEncoding, sendApp);
-
-  if (ccOption == GCC) {
-    sendApp->SetController (GCC);
-  } else if (ccOption == NADA) {
-    sendApp->SetController (NADA);
-  }
-
-  sendApp->SetStartTime(Seconds(startTime_s));
-  sendApp->SetStopTime(Seconds(stopTime_s + 2));
-  recvApp->SetStartTime(Seconds(startTime_s));
-  recvApp->SetStopTime(Seconds(stopTime_s + 2));
+    std::string name = rtxPolicy + fecPolicy;
+    if (fecPolicy == "hairpin" || fecPolicy == "hairpinone") {
+      char buf[10];
+      snprintf (buf, sizeof (buf), "%.0e", qoeCoeff);
+      name += buf;
+    }
+    else if (fecPolicy == "fixed" || fecPolicy == "lin" || fecPolicy == "fixedrtx")
+      name += std::to_string (param1).substr (0, 4);
+    return name;
 }
 
 static void EnableLogging(LogLevel log_level) {
@@ -294,7 +310,8 @@ main (int argc, char *argv[])
     uint16_t fps            = FRAME_PER_SECOND;
     uint32_t bitrate        = BITRATE_MBPS;
     float duration          = EMULATION_DURATION;  // in s
-    int cc_option           = NOT_USE_CC;
+    std::string ccOption    = "0";   /* CC_ALG of each flow */
+    std::string pktSize     = "0";   /* packet size of each flow in bytes, 0 for the default 1460 */
     bool network_variation  = false;
     bool set_trace          = false;
     uint16_t variation_interval  = DEFAULT_NETWORK_CHANGE_INTERVAL;
@@ -305,17 +322,42 @@ main (int argc, char *argv[])
 
     double_t qoeCoeff = 1e-7;
 
-    int port = 8000;    /* application port */
+    int port = 8000;    /* application port of the first flow, flow i uses port + i */
+    uint32_t nFlows = 1;
+    std::string flowTrace = "";       /* network statistics trace of each flow with --settrace, --trace if empty */
+    std::string crossBulk = "";       /* TCP congestion control of each bulk cross flow, e.g. cubic,bbr */
+    std::string crossOnOff = "";      /* peak rate of each on/off cross flow, in Mbps */
+    std::string crossCbr = "";        /* rate of each constant-bitrate cross flow, in Mbps */
+    uint32_t crossOnMs = 200;         /* mean length of the on (sending) periods of the on/off cross flows, in ms */
+    uint32_t crossOffMs = 800;        /* mean length of their off (silent) periods, in ms */
     std::string trace = DEFAULT_TRACE;
+    double_t burstLen = 0;            /* mean loss burst length in packets, 0 for independent losses */
+    std::string mmTrace = "";         /* Mahimahi delivery trace of the n1 -> n2 bottleneck */
+    std::string frameTrace = "";      /* per-frame size trace, empty for constant frame sizes */
+    uint16_t rcDelay = 0;             /* encoder rate-control response time, in ms */
+    std::string aqm = "none";         /* queue disc of the n1 -> n2 bottleneck */
+    bool zhuge = false;               /* in-network delay feedback from n1 */
+    uint32_t zhugeInterval = 1;       /* batching of the delay hints, in ms */
 
     // fixed-hairpin-policy
     uint16_t fixed_group_size = 0;
+    // hairpin-policy
+    std::string fecTableDir = "";     /* searched for the Hairpin tables before the module directory */
+    bool blockOpt = false;            /* Hairpin chooses the FEC block size */
+    // real payload mode
+    std::string fecCodec = "";        /* rs or xor, empty to simulate the payload sizes only */
+    std::string gfKernel = "";        /* GF(2^8) kernel of the codec, empty for the best supported */
+    // sliding-window FEC
+    uint16_t windowFec = 0;           /* packets covered by a repair, 0 for the batch FEC only */
+    bool rtxRepair = false;           /* retransmit fresh repairs instead of the lost data packets */
+    bool nack = false;                /* the receiver requests the retransmissions */
 
     double_t param1 = 1;
 
     CommandLine cmd;
-    cmd.AddValue("fecPolicy",   "FECPolicy, one of [hairpin, fixed, webrtc, awebrtc, webrtcstar, rtx, fec]", fecPolicy);
-    cmd.AddValue("rtxPolicy",   "FECPolicy, one of [hairpin, fixed, webrtc, awebrtc, webrtcstar, rtx, fec]", rtxPolicy);
+    cmd.AddValue("flows",       "Number of RTC flows sharing the bottleneck", nFlows);
+    cmd.AddValue("fecPolicy",   "FECPolicy of each flow, one of [hairpin, fixed, webrtc, awebrtc, webrtcstar, rtx, fec]", fecPolicy);
+    cmd.AddValue("rtxPolicy",   "FECPolicy of each flow, one of [hairpin, fixed, webrtc, awebrtc, webrtcstar, rtx, fec]", rtxPolicy);
     cmd.AddValue("ddl",      "Frame deadline, in ms", delayDdl);
     cmd.AddValue("loss",     "Link packet loss rate, [0, 1]", loss_rate);
     cmd.AddValue("bw",       "Link bandwidth, in Mbps", linkBw);
@@ -324,20 +366,43 @@ main (int argc, char *argv[])
     cmd.AddValue("bitrate",  "Video encoding bitrate, in Mbps", bitrate);
     cmd.AddValue("duration", "Duration of the emulation in seconds", duration);
 
-    cmd.AddValue("cc", "Congestion control algorithm [NOT_USE_CC, GCC]", cc_option);
+    cmd.AddValue("cc", "Congestion control algorithm [NOT_USE_CC, GCC, NADA, SCREAM] of each flow", ccOption);
+    cmd.AddValue("pktsize", "Media packet size of each flow in bytes, 0 for ns3::NetworkPacket::MaxPacketSize", pktSize);
     cmd.AddValue("vary", "Network varies according to traces", network_variation);
     cmd.AddValue("trace", "Trace file directory", trace);
     cmd.AddValue("interval", "Network condition change interval, in ms", variation_interval);
     cmd.AddValue("window", "Receiver sliding window size, in ms", receiver_wnd);
     cmd.AddValue("settrace", "Receiver feedbacks online traces as network states", set_trace);
+    cmd.AddValue("flowtrace", "Trace used as network states by each flow with --settrace", flowTrace);
     cmd.AddValue("log", "output log directory", logDir);
     cmd.AddValue("isPcapEnabled", "Capture all the packets", isPcapEnabled);
+    cmd.AddValue("crossbulk", "TCP bulk cross flows on the bottleneck, comma-separated congestion controls [cubic, bbr, newreno]", crossBulk);
+    cmd.AddValue("crossonoff", "On/off UDP cross flows on the bottleneck, comma-separated peak rates in Mbps", crossOnOff);
+    cmd.AddValue("crosson", "Mean on time of the on/off cross flows, in ms", crossOnMs);
+    cmd.AddValue("crossoff", "Mean off time of the on/off cross flows, in ms", crossOffMs);
+    cmd.AddValue("crosscbr", "Constant-bitrate UDP cross flows on the bottleneck, comma-separated rates in Mbps", crossCbr);
+    cmd.AddValue("burstlen", "Mean loss burst length (Gilbert-Elliott) in packets, 0 for independent losses", burstLen);
+    cmd.AddValue("mmtrace", "Mahimahi packet-delivery trace replayed on the n1 -> n2 bottleneck", mmTrace);
+    cmd.AddValue("frametrace", "Per-frame size trace for the encoder, e.g. ./src/sparkrtc/examples/sample-frames.tr", frameTrace);
+    cmd.AddValue("rcdelay", "Encoder rate-control response time, in ms", rcDelay);
+    cmd.AddValue("aqm", "ECN-marking AQM on the bottleneck, one of [none, codel, fqcodel, l4s]", aqm);
+    cmd.AddValue("zhuge", "Router in front of the bottleneck sends predicted delays to the CC senders", zhuge);
+    cmd.AddValue("zhugeinterval", "Batching interval of the router delay hints with --zhuge, in ms, 0 for per packet", zhugeInterval);
     /* Do not modify this unless you understand what you're doing 
        The backend interface may not support the parameters you enter */
     // fixed-hairpin-policy
     cmd.AddValue("group_size",  "Fixed group size", fixed_group_size);
     // hairpin-policy
     cmd.AddValue("coeff",       "QoE Coefficent", qoeCoeff);
+    cmd.AddValue("fectables",   "Directory searched first for the Hairpin tables", fecTableDir);
+    cmd.AddValue("blockopt",    "Hairpin chooses the FEC block size from its block table", blockOpt);
+    // real payload mode
+    cmd.AddValue("fecCodec",    "Encode and decode real FEC payloads with a [rs, xor] codec, empty to simulate sizes only", fecCodec);
+    cmd.AddValue("gfkernel",    "GF(2^8) kernel of --fecCodec, one of [scalar, ssse3, avx2], empty for the best supported", gfKernel);
+    // sliding-window FEC
+    cmd.AddValue("windowfec",   "Protect first transmissions with sliding-window repairs over this many packets across frames, 0 for the batch FEC", windowFec);
+    cmd.AddValue("rtxrepair",   "Retransmit a group as fresh repairs sized to its unacknowledged packets instead of the packets themselves", rtxRepair);
+    cmd.AddValue("nack",        "The receiver detects losses and requests retransmissions with NACKs, the sender timer is kept as a fallback", nack);
     // webrtc policy
     cmd.AddValue("fixed_loss", "Fixed loss rate directly passed to WebRTCPolicy  and WebRTCPolicyStarPolicy", fixed_loss_flag);
     // webrtcstar policy
@@ -348,14 +413,30 @@ main (int argc, char *argv[])
 
     cmd.Parse (argc, argv);
 
-    std::string dir = logDir + "/" + rtxPolicy + fecPolicy;
-    if (fecPolicy == "hairpin" || fecPolicy == "hairpinone") {
-      char buf[10];
-      snprintf (buf, sizeof (buf), "%.0e", qoeCoeff);
-      dir += buf;
-    }
-    else if (fecPolicy == "fixed" || fecPolicy == "lin" || fecPolicy == "fixedrtx")
-      dir += std::to_string (param1).substr (0, 4);
+    NS_ABORT_MSG_IF (nFlows == 0, "At least one flow is needed");
+    if (!fecTableDir.empty ())
+      HairpinTable::AddSearchPath (fecTableDir);
+    if (gfKernel == "scalar")
+      GaloisField::SetKernel (GaloisField::SCALAR);
+    else if (gfKernel == "ssse3")
+      GaloisField::SetKernel (GaloisField::SSSE3);
+    else if (gfKernel == "avx2")
+      GaloisField::SetKernel (GaloisField::AVX2);
+    else
+      NS_ABORT_MSG_IF (!gfKernel.empty (), "Unknown GF(2^8) kernel " + gfKernel);
+    /* per-flow options are comma-separated, e.g. --flows=3 --fecPolicy=hairpin,webrtc --cc=1 */
+    std::vector<std::string> fecPolicies = SplitFlowOption (fecPolicy, nFlows);
+    std::vector<std::string> rtxPolicies = SplitFlowOption (rtxPolicy, nFlows);
+    std::vector<std::string> ccOptions = SplitFlowOption (ccOption, nFlows);
+    std::vector<std::string> pktSizes = SplitFlowOption (pktSize, nFlows);
+    std::vector<std::string> flowTraces = SplitFlowOption (flowTrace.empty () ? trace : flowTrace, nFlows);
+
+    /* logs of a single flow go to <log>/<policy>, of multiple flows to <log>/<n>flows/flow<i>-<policy> */
+    std::string dir = logDir + "/";
+    if (nFlows == 1)
+      dir += PolicyDirName (rtxPolicies[0], fecPolicies[0], qoeCoeff, param1);
+    else
+      dir += std::to_string (nFlows) + "flows";
 
     if (network_variation) {
     //   std::string traceDir, traceName;
@@ -375,22 +456,10 @@ main (int argc, char *argv[])
       if (!boost::filesystem::exists (trace))
         NS_ABORT_MSG ("Trace file does not exist: " + trace);
     
-      std::string tmp;
-      std::ifstream trace_file;
-      float n = 0.;
-      trace_file.open(trace, std::ios::in);
-      if (trace_file.fail ()) {
-        NS_FATAL_ERROR ("Trace file fail to open!" + trace);
-      }
-      else {
-        while (getline(trace_file, tmp)) {
-          n += 1.;
-        }
-        trace_file.close();
-        duration = std::min (duration, (float) (n * variation_interval / 1000.));
-        if (duration < 2) {
-          NS_FATAL_ERROR ("Trace file too short!" + trace);
-        }
+      float n = TraceStore::Get (trace)->GetSize ();
+      duration = std::min (duration, (float) (n * variation_interval / 1000.));
+      if (duration < 2) {
+        NS_FATAL_ERROR ("Trace file too short!" + trace);
       }
     }
 
@@ -413,90 +482,125 @@ main (int argc, char *argv[])
         "\n"
     );
     
-    // set FEC policy
-    Ptr<FECPolicy> fecPolicyIns;
-    if(fecPolicy == "hairpin" || fecPolicy == "hairpinbound") {
-        fecPolicyIns = CreateObject<HairpinPolicy> (delayDdl, qoeCoeff, 1, 0);
-    } else if(fecPolicy == "hairpinone") {
-        fecPolicyIns = CreateObject<HairpinPolicy> (0, qoeCoeff, 1, 0);
-    } else if(fecPolicy == "fixed") {
-        fecPolicyIns = CreateObject<FixedPolicy> (param1);
-    } else if(fecPolicy == "webrtc") {
-        fecPolicyIns = CreateObject<WebRTCPolicy> ();
-    } else if(fecPolicy == "awebrtc") {
-        fecPolicyIns = CreateObject<WebRTCAdaptivePolicy> ();
-    // } else if(fecPolicy == "sqrt") {
-    //     fecPolicyIns = CreateObject<WebRTCStarPolicy> (0);
-    } else if(fecPolicy == "lin") {
-        fecPolicyIns = CreateObject<WebRTCStarPolicy> (1, param1);
-    // } else if(fecPolicy == "quad") {
-    //     fecPolicyIns = CreateObject<WebRTCStarPolicy> (2);
-    } else if(fecPolicy == "rtx") {
-        fecPolicyIns = CreateObject<RtxOnlyPolicy> ();
-    // } else if(fecPolicy == "fec" || fecPolicy == "feconly") {
-    //     fecPolicyIns = CreateObject<HairpinPolicy> (delayDdl, (uint8_t) qoeCoeffPow, 0, 0);
-    } else if(fecPolicy == "bolot") {
-        fecPolicyIns = CreateObject<BolotPolicy> ();
-    } else if(fecPolicy == "usf") {
-        fecPolicyIns = CreateObject<UsfPolicy> ();
-    } else if(fecPolicy == "fixedrtx") {
-        fecPolicyIns = CreateObject<FixedRtxPolicy> (param1);
-    } else if(fecPolicy == "tokenrtx") {
-        fecPolicyIns = CreateObject<TokenRtxPolicy> ();
-    } else {
-        NS_ASSERT_MSG(false, "FECPolicy must be one of [hairpin, hairpinbound, fixed, webrtc, awebrtc, rtx, fec].");
-    }
-    fecPolicyIns->SetMaxFECRate (max_fec_rate);
-    if (fixed_loss_flag) {
-      fecPolicyIns->SetFixedLoss (loss_rate);
-    }
-
-
   Config::SetDefault ("ns3::RateErrorModel::ErrorRate", DoubleValue (loss_rate));
 	Config::SetDefault ("ns3::RateErrorModel::ErrorUnit", StringValue ("ERROR_UNIT_PACKET"));
 
 
-  NodeContainer nodes = BuildExampleTopo (linkBw * 1e6, ms_delay, msQDelay, dir, isPcapEnabled);
+  NS_LOG_INFO ("track network dynamics: " << network_variation);
+
+  bool ccUsed = false;
+  for (uint32_t i = 0; i < nFlows; i++) {
+    int cc = std::stoi (ccOptions[i]);
+    switch (cc)
+    {
+    case NOT_USE_CC:
+      NS_LOG_INFO("CC algorithm of flow " << i << ": NOT_USE_CC");
+      break;
+
+    case GCC:
+    case NADA:
+    case SCREAM:
+      NS_LOG_INFO("CC algorithm of flow " << i << ": " << cc);
+      ccUsed = true;
+      break;
+
+    default:
+      NS_ASSERT_MSG(false, "Invalid CC algorithm selected.");
+      break;
+    }
+  }
+  if (aqm != "none")
+    Config::SetDefault ("ns3::TcpSocketBase::UseEcn", StringValue ("On"));
+
+  Ptr<CrossTraffic> crossTraffic;
+  if (!crossBulk.empty () || !crossOnOff.empty () || !crossCbr.empty ()) {
+    crossTraffic = CreateObject<CrossTraffic> ();
+    Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (1448));
+    std::string item;
+    std::stringstream bulk (crossBulk), onOff (crossOnOff), cbr (crossCbr);
+    while (std::getline (bulk, item, ','))
+      crossTraffic->AddBulk (item, Seconds (appStart), Seconds (appStop));
+    while (std::getline (onOff, item, ','))
+      crossTraffic->AddOnOff (DataRate (std::stod (item) * 1e6), MilliSeconds (crossOnMs), MilliSeconds (crossOffMs),
+        Seconds (appStart), Seconds (appStop));
+    while (std::getline (cbr, item, ','))
+      crossTraffic->AddCbr (DataRate (std::stod (item) * 1e6), Seconds (appStart), Seconds (appStop));
+  }
+
+  Ptr<ZhugeAgent> zhugeAgent;
+  if (zhuge) {
+    zhugeAgent = CreateObject<ZhugeAgent> ();
+    zhugeAgent->AddFlowPorts (port, nFlows);
+    zhugeAgent->SetFeedbackInterval (MilliSeconds (zhugeInterval));
+  }
+
+  /* Set network propagation delay, error rate and bandwidth (with CC) */
+  /* according to frame-level traces */
+  NodeContainer nodes = BuildExampleTopo (linkBw * 1e6, ms_delay, msQDelay, dir, isPcapEnabled,
+    network_variation ? TraceStore::Get (trace) : Ptr<TraceStore> (), ccUsed, variation_interval, mmTrace,
+    loss_rate, burstLen, crossTraffic, aqm, zhugeAgent);
   NS_LOG_INFO("Topology successfully built...");
 
   // DEBUG("node0: " << nodes.Get(0)->GetNDevices() <<  ", node1: " << nodes.Get(1)->GetNDevices() <<  ", node2: " << nodes.Get(2)->GetNDevices());
 
   NS_LOG_INFO ("Installing application...");
-  NS_LOG_INFO ("track network dynamics: " << network_variation);
 
-  switch (cc_option)
-  {
-  case NOT_USE_CC:
-    if (network_variation) {
-      /* Set network propagation delay and error rate */
-      /* according to frame-level traces */
-      BandwidthTrace (nodes.Get(0), nodes.Get(1), trace, false, variation_interval, true);
+  Ptr<RtcScenario> scenario = CreateObject<RtcScenario> ();
+  for (uint32_t i = 0; i < nFlows; i++) {
+    RtcFlowConfig config;
+    config.fecPolicy = CreateFecPolicy (fecPolicies[i], delayDdl, qoeCoeff, param1);
+    if (blockOpt && config.fecPolicy->GetFecName () == "HairpinPolicy")
+      DynamicCast<HairpinPolicy> (config.fecPolicy)->SetBlockSizeOpt (true);
+    config.fecPolicy->SetMaxFECRate (max_fec_rate);
+    if (fixed_loss_flag) {
+      config.fecPolicy->SetFixedLoss (loss_rate);
     }
-    NS_LOG_INFO("CC algorithm: NOT_USE_CC");
-    break;
-
-  case GCC:
-  case NADA:
-    if (network_variation) {
-      BandwidthTrace (nodes.Get(0), nodes.Get(1), trace, true, variation_interval, true);
+    config.rtxPolicy = rtxPolicies[i];
+    config.cc = (CC_ALG) std::stoi (ccOptions[i]);
+    config.packetSize = std::stoi (pktSizes[i]);
+    config.fecCodec = fecCodec;
+    config.windowFec = windowFec;
+    config.freshRepairRtx = rtxRepair;
+    config.nack = nack;
+    config.fps = fps;
+    config.interval = variation_interval;
+    config.delayDdl = delayDdl;
+    config.bitrate = bitrate * 1e6;
+    config.defaultRtt = ms_delay * 2;
+    config.defaultBw = bitrate;
+    config.defaultLoss = loss_rate;
+    config.receiverWindow = receiver_wnd;
+    config.setTrace = set_trace;
+    config.trace = flowTraces[i];
+    config.frameTrace = frameTrace;
+    config.rcDelay = rcDelay;
+    /* L4S flows send ECT(1), classic ECN flows ECT(0) */
+    if (aqm != "none")
+      config.ecn = aqm == "l4s" ? 1 : 2;
+    config.start = Seconds (appStart);
+    config.stop = Seconds (appStop);
+    config.logDir = dir;
+    if (nFlows > 1) {
+      config.logDir += "/flow" + std::to_string (i) + "-" + PolicyDirName (rtxPolicies[i], fecPolicies[i], qoeCoeff, param1);
+      boost::filesystem::create_directories (config.logDir);
     }
-    NS_LOG_INFO("CC algorithm: " << cc_option);
-    Config::SetDefault ("ns3::NetworkPacket::MaxPacketSize", UintegerValue (260));
-    break;
-
-  default:
-    NS_ASSERT_MSG(false, "Invalid CC algorithm selected.");
-    break;
+    scenario->AddFlow (config);
   }
-
-  InstallApp (
-    nodes.Get(0), nodes.Get(2),
-    port, appStart, appStop, fecPolicyIns, rtxPolicy,
-    fps, variation_interval, delayDdl, bitrate * 1e6, cc_option,
-    ms_delay * 2, bitrate, loss_rate, receiver_wnd, set_trace, trace, dir);
+  scenario->Install (nodes.Get(0), nodes.Get(2), port, 100 /* first random stream of the flows */);
 
   Simulator::Run ();
   Simulator::Stop (Seconds (appStop + 2));
+
+  std::ofstream summary (dir + "/summary.log");
+  scenario->Report (summary);
+  scenario->Report (std::cout);
+  if (crossTraffic != NULL) {
+    crossTraffic->Report (summary);
+    crossTraffic->Report (std::cout);
+  }
+  if (zhugeAgent != NULL) {
+    zhugeAgent->Report (summary);
+    zhugeAgent->Report (std::cout);
+  }
   Simulator::Destroy ();
 }
-// 
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "ns3/core-module.h"
+#include "ns3/sparkrtc-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TraceConvert");
+
+// Convert network traces between the formats understood by sparkrtc:
+//  - bin:   text trace (e.g. sample.tr) -> binary columnar format that
+//           TraceStore memory-maps, so that long traces are not parsed
+//           again in every run;
+//  - mm2tr: Mahimahi delivery trace -> "<bw>Mbps <rtt>ms <loss>" samples;
+//  - tr2mm: "<bw>Mbps <rtt>ms <loss>" samples -> Mahimahi delivery trace.
+// The Mahimahi conversions are streamed and work on traces of any length.
+//
+//   ./ns3 run "trace-convert --input=src/sparkrtc/examples/sample.tr --output=sample.trb"
+//   ./ns3 run "trace-convert --mode=mm2tr --input=cell.down --output=cell.tr --rtt=40"
+
+int
+main (int argc, char *argv[])
+{
+    std::string mode = "bin";
+    std::string input = "./src/sparkrtc/examples/sample.tr";
+    std::string output = "";
+    uint16_t interval = 16;     /* in ms */
+    double_t rtt = 40;          /* in ms */
+    double_t loss = 0;
+
+    CommandLine cmd;
+    cmd.AddValue("mode",     "Conversion, one of [bin, mm2tr, tr2mm]", mode);
+    cmd.AddValue("input",    "Trace to convert", input);
+    cmd.AddValue("output",   "Trace to write, defaults to <input>.<mode>", output);
+    cmd.AddValue("interval", "Duration of a \"<bw>Mbps <rtt>ms <loss>\" sample, in ms", interval);
+    cmd.AddValue("rtt",      "RTT written to every sample (mm2tr), in ms", rtt);
+    cmd.AddValue("loss",     "Loss rate written to every sample (mm2tr)", loss);
+    cmd.Parse (argc, argv);
+
+    if (output.empty ()) {
+      output = input + "." + mode;
+    }
+
+    if (mode == "bin") {
+      uint32_t n = TraceStore::ConvertToBinary (input, output);
+      std::cout << "Converted " << n << " samples: " << input << " -> " << output << std::endl;
+    } else if (mode == "mm2tr") {
+      uint64_t n = MahimahiTrace::ToSampleTrace (input, output, interval, rtt, loss);
+      std::cout << "Converted " << n << " samples: " << input << " -> " << output << std::endl;
+    } else if (mode == "tr2mm") {
+      uint64_t n = MahimahiTrace::FromSampleTrace (input, output, interval);
+      std::cout << "Converted " << n << " delivery opportunities: " << input << " -> " << output << std::endl;
+    } else {
+      NS_FATAL_ERROR ("Conversion mode must be one of [bin, mm2tr, tr2mm].");
+    }
+    return 0;
+}
@@ -39,4 +39,33 @@ static inline bool Uint64Less (uint64_t id1, uint64_t id2)
     return noWarpSubtract < wrapSubtract;
 }
 
+/* Extend a 16-bit sequence number of the wire to the 64-bit one closest to
+   ref, a sequence number already extended */
+static inline uint64_t UnwrapSeq16 (uint16_t seq, uint64_t ref)
+{
+    int16_t delta = (int16_t) (uint16_t) (seq - (uint16_t) ref);
+    return ref + delta;
+}
+
+/* Turns the 16-bit sequence numbers of the wire into monotonic 64-bit ones at
+   the receiving edge, so that the tables and comparisons behind it never wrap */
+class SeqUnwrapper {
+public:
+    SeqUnwrapper () : m_highest {0}, m_started {false} {};
+    uint64_t Unwrap (uint16_t seq) {
+        if (!m_started) {
+            /* one cycle up, ids reordered before the first one stay positive */
+            m_highest = (1 << 16) + seq;
+            m_started = true;
+            return m_highest;
+        }
+        uint64_t ext = UnwrapSeq16 (seq, m_highest);
+        m_highest = MAX (m_highest, ext);
+        return ext;
+    };
+private:
+    uint64_t m_highest;
+    bool m_started;
+};
+
 #endif /* COMMON_HEADER_H */
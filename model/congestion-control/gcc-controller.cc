@@ -468,6 +468,11 @@ bool GccController::processFeedback(uint64_t nowUs,
 
 	OveruseEstimatorUpdate(t_delta, ts_delta, size_delta, D_hypothesis_, l_arrival_time/1000);
   OveruseDetectorDetect(offset_, ts_delta, num_of_deltas_, l_arrival_time/1000);
+  // A CE mark in the group means the AQM sees a standing queue before the
+  // delay gradient does: react as to an overuse, TimeToReduceFurther
+  // limits the decrease to once per RTT
+  if (ecn == ECN_CE)
+    D_hypothesis_ = 'O';
 
   uint64_t rtt_us;
   getCurrentRTT(rtt_us);
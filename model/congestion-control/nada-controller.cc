@@ -87,6 +87,12 @@ const float NADA_PARAM_LAMBDA = 0.5; /**< Exponent of the non-linear warping (di
  */
 const float NADA_PARAM_DLOSS = 10.;
 const float NADA_PARAM_PLRREF = 0.01; /**> Reference packet loss ratio (dimensionless) */
+/**
+ * Reference delay penalty (in ms) in terms of value
+ * of congestion price when packet marking ratio is at PMRREF
+ */
+const float NADA_PARAM_DMARK = 2.;
+const float NADA_PARAM_PMRREF = 0.01; /**> Reference packet marking ratio (dimensionless) */
 const float NADA_PARAM_XMAX = 500.; /**> Maximum value of aggregate congestion signal (in ms) */
 
 /** Smoothing factor in exponential smoothing of packet loss and marking ratios */
@@ -98,6 +104,7 @@ NadaController::NadaController() :
     SenderBasedController{},
     m_ploss{0},
     m_plr{0.f},
+    m_pmr{0.f},
     m_warpMode{false},
     m_lastTimeCalcUs{0},
     m_lastTimeCalcValid{false},
@@ -124,6 +131,7 @@ void NadaController::setCurrentBw(float newBw) {
 void NadaController::reset() {
     m_ploss = 0;
     m_plr = 0.f;
+    m_pmr = 0.f;
     m_warpMode = false;
     m_lastTimeCalcUs = 0;
     m_lastTimeCalcValid = false;
@@ -141,9 +149,8 @@ void NadaController::reset() {
 
 /**
  * Implementation of the #processFeedback API
- * in the SenderBasedController class
- *
- * TODO (deferred): Add support for ECN marking
+ * in the SenderBasedController class. ECN marks are taken into
+ * account through the marking ratio given by #UpdateMarkRate
  */
 bool NadaController::processFeedback(uint64_t nowUs,
                                      uint16_t sequence,
@@ -162,6 +169,7 @@ bool NadaController::processFeedback(uint64_t nowUs,
                                                 l_inter_departure,
                                                 l_inter_delay_var,
 												l_inter_group_size,
+                                                l_arrival_time,
                                                 ecn)) {
         return false;
     }
@@ -258,6 +266,10 @@ void NadaController::updateMetrics(uint64_t nowUs) {
         m_plr += NADA_PARAM_ALPHA * (plr - m_plr);
     }
 
+    /* Exponential filtering of the ECN marking ratio reported by the receiver */
+    const float pmr = last_fraction_mark_ / 256.f;
+    m_pmr += NADA_PARAM_ALPHA * (pmr - m_pmr);
+
     float avgInt;
     uint16_t currentInt;
     bool avgIntOK = getLossIntervalInfo(avgInt, currentInt);
@@ -290,6 +302,7 @@ void NadaController::logStats(uint64_t nowUs) const {
        << " rtt: "    << (m_RttUs / 1000)
        << " ploss: "  << m_ploss
        << " plr: "    << m_plr
+       << " pmr: "    << m_pmr
        << " xcurr: "  << m_Xcurr
        << " rrate: "  << m_RecvR
        << " srate: "  << m_currBw
@@ -378,6 +391,10 @@ void NadaController::updateXcurr() {
     float plr0 = m_plr / NADA_PARAM_PLRREF;
     m_Xcurr += NADA_PARAM_DLOSS * plr0 * plr0;
 
+    /* Add the ECN marking penalty, Eq.(2) in Sec.4.2 of rfc8698 */
+    float pmr0 = m_pmr / NADA_PARAM_PMRREF;
+    m_Xcurr += NADA_PARAM_DMARK * pmr0 * pmr0;
+
     /* Clip final congestion signal within range */
     if (m_Xcurr > NADA_PARAM_XMAX) {
         m_Xcurr = NADA_PARAM_XMAX;
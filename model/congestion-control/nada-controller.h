@@ -171,6 +171,7 @@ private:
      */
     uint32_t m_ploss; /**< packet loss count within configured window */
     float m_plr;     /**< packet loss ratio within packet history window */
+    float m_pmr;     /**< filtered ECN marking ratio reported by the receiver */
     bool m_warpMode;  /**< whether to perform non-linear warping of queuing delay */
 
     /** timestamp of when r_ref is last calculated (t_last in rmcat-nada), in microseconds  */
@@ -0,0 +1,342 @@
+/**
+ * @file
+ * SCReAM controller implementation for rmcat ns3 module.
+ *
+ * Implementation of the network congestion control of Self-Clocked
+ * Rate Adaptation for Multimedia (SCReAM), as documented in rfc8298.
+ * The media rate control keeps the target bitrate below cwnd / srtt
+ * and ramps it up while the queuing delay is low; there is no RTP
+ * queue in the controller, the sender queues the packets held back
+ * by the window.
+ */
+
+#include "scream-controller.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+
+/*
+ * Default parameter values of the SCReAM algorithm,
+ * corresponding to Sec. 4.1.2.1 of rfc8298
+ */
+
+/**
+ * Target queuing delay (in microseconds). 0.1s in rfc8298,
+ * lowered for the frame deadlines of interactive video
+ */
+const uint64_t SCREAM_QDELAY_TARGET_US = 60 * 1000;
+const float SCREAM_QDELAY_WEIGHT = 0.1;     /**< Averaging factor of the queuing delay fraction */
+const float SCREAM_QDELAY_TREND_LO = 0.2;   /**< Queuing delay trend threshold for fast increase */
+const uint64_t SCREAM_QDELAY_TREND_INTERVAL_US = 50 * 1000; /**< Sampling interval of the queuing delay fraction */
+const size_t SCREAM_QDELAY_HIST_LEN = 20;   /**< Samples used for the queuing delay trend */
+const uint64_t SCREAM_BASE_OWD_INTERVAL_US = 60 * 1000 * 1000; /**< One base delay sample per minute */
+const size_t SCREAM_BASE_OWD_HIST_LEN = 10;
+
+const float SCREAM_GAIN = 1.0;          /**< Gain factor of the cwnd increase */
+const float SCREAM_BETA_LOSS = 0.8;     /**< cwnd scale factor on loss */
+const float SCREAM_BETA_ECN = 0.9;      /**< cwnd scale factor on ECN-CE */
+const float SCREAM_MSS = 1000.;         /**< Maximum segment size (in bytes) */
+const float SCREAM_MIN_CWND = 3000.;    /**< Minimum congestion window (in bytes) */
+const float SCREAM_MAX_BYTES_IN_FLIGHT_HEAD_ROOM = 1.1; /**< Headroom of cwnd over the bytes in flight */
+const uint64_t SCREAM_POST_CONGESTION_DELAY_US = 4 * 1000 * 1000; /**< No fast increase after congestion */
+
+/** Feedback of a packet sent earlier than this (and 4 srtt) is considered lost */
+const uint64_t SCREAM_FEEDBACK_TIMEOUT_US = 500 * 1000;
+
+/* default parameters for the media rate control */
+
+const uint64_t SCREAM_RATE_ADJUST_INTERVAL_US = 200 * 1000; /**< Interval of the target bitrate ramp-up */
+const float SCREAM_RAMP_UP_SPEED = 200000.; /**< Target bitrate increase (in bps per second) */
+const float SCREAM_RAMP_UP_SCALE = 0.5;  /**< Relative target bitrate increase (per second) */
+const float SCREAM_RATE_DECREASE_SCALE = 0.5; /**< Relative target bitrate decrease per second and unit of excess delay */
+
+namespace rmcat {
+
+ScreamController::ScreamController() :
+    SenderBasedController{},
+    m_inFlight{},
+    m_bytesInFlight{0},
+    m_maxBytesInFlight{0},
+    m_maxBytesInFlightPrev{0},
+    m_maxBytesInFlightStartUs{0},
+    m_cwnd{std::max(SCREAM_MIN_CWND, m_initBw / 8 * 0.1f)},
+    m_inFastIncrease{true},
+    m_lastCongestionUs{0},
+    m_congestionSeen{false},
+    m_sRttUs{0},
+    m_lastAckUs{0},
+    m_baseOwdHist{},
+    m_baseOwdMinuteStartUs{0},
+    m_qdelayUs{0},
+    m_qdelayFractionAvg{0.f},
+    m_qdelayFractionHist{},
+    m_lastTrendUpdateUs{0},
+    m_qdelayTrend{0.f},
+    m_qdelayTrendMem{0.f},
+    m_targetBitrate{m_initBw},
+    m_lastRateUpdateUs{0} {}
+
+ScreamController::~ScreamController() {}
+
+void ScreamController::setCurrentBw(float newBw) {
+    m_targetBitrate = newBw;
+    if (m_sRttUs > 0) {
+        m_cwnd = std::max(SCREAM_MIN_CWND, newBw / 8 * m_sRttUs / 1e6f);
+    }
+}
+
+void ScreamController::reset() {
+    SenderBasedController::reset();
+    m_inFlight.clear();
+    m_bytesInFlight = 0;
+    m_maxBytesInFlight = 0;
+    m_maxBytesInFlightPrev = 0;
+    m_maxBytesInFlightStartUs = 0;
+    m_cwnd = std::max(SCREAM_MIN_CWND, m_initBw / 8 * 0.1f);
+    m_inFastIncrease = true;
+    m_lastCongestionUs = 0;
+    m_congestionSeen = false;
+    m_sRttUs = 0;
+    m_lastAckUs = 0;
+    m_baseOwdHist.clear();
+    m_baseOwdMinuteStartUs = 0;
+    m_qdelayUs = 0;
+    m_qdelayFractionAvg = 0.f;
+    m_qdelayFractionHist.clear();
+    m_lastTrendUpdateUs = 0;
+    m_qdelayTrend = 0.f;
+    m_qdelayTrendMem = 0.f;
+    m_targetBitrate = m_initBw;
+    m_lastRateUpdateUs = 0;
+}
+
+bool ScreamController::processSendPacket(uint64_t txTimestampUs,
+                                         uint16_t sequence,
+                                         uint32_t size) {
+    if (!SenderBasedController::processSendPacket(txTimestampUs, sequence, size)) {
+        return false;
+    }
+    m_inFlight.push_back(InFlightPacket{sequence, txTimestampUs, size});
+    m_bytesInFlight += size;
+
+    /* max bytes in flight over the current and the previous srtt */
+    if (txTimestampUs - m_maxBytesInFlightStartUs > std::max(m_sRttUs, SCREAM_QDELAY_TREND_INTERVAL_US)) {
+        m_maxBytesInFlightPrev = m_maxBytesInFlight;
+        m_maxBytesInFlight = 0;
+        m_maxBytesInFlightStartUs = txTimestampUs;
+    }
+    m_maxBytesInFlight = std::max(m_maxBytesInFlight, m_bytesInFlight);
+    return true;
+}
+
+void ScreamController::processAck(uint64_t nowUs,
+                                  uint16_t sequence,
+                                  uint64_t rxTimestampUs,
+                                  uint8_t ecn) {
+    m_lastAckUs = nowUs;
+    if (m_inFlight.empty() || lessThan(sequence, m_inFlight.front().sequence)) {
+        // duplicate, or already considered lost
+        return;
+    }
+
+    // Packets sent before the acknowledged one are lost: the
+    // bottleneck does not reorder
+    bool lossEvent = false;
+    while (!m_inFlight.empty() && lessThan(m_inFlight.front().sequence, sequence)) {
+        m_bytesInFlight -= m_inFlight.front().size;
+        m_inFlight.pop_front();
+        lossEvent = true;
+    }
+    if (m_inFlight.empty() || m_inFlight.front().sequence != sequence) {
+        std::cerr << "ScreamController::processAck,"
+                  << " sequence: " << sequence
+                  << " was not sent" << std::endl;
+        return;
+    }
+
+    const InFlightPacket packet = m_inFlight.front();
+    m_inFlight.pop_front();
+    assert(m_bytesInFlight >= packet.size);
+    m_bytesInFlight -= packet.size;
+
+    const uint64_t rttUs = nowUs - packet.txTimestampUs;
+    m_sRttUs = m_sRttUs == 0 ? rttUs : (7 * m_sRttUs + rttUs) / 8;
+
+    // This subtraction can wrap if clocks aren't synchronized, the
+    // base delay removes the offset
+    updateQdelay(nowUs, rxTimestampUs - packet.txTimestampUs);
+    updateQdelayTrend(nowUs);
+    updateCwnd(nowUs, packet.size, lossEvent, ecn == ECN_CE);
+    updateTargetBitrate(nowUs);
+}
+
+bool ScreamController::canSendPacket(uint64_t nowUs, uint32_t size) {
+    // Without feedback the window would stay closed: packets whose
+    // feedback is overdue are considered lost
+    const uint64_t timeoutUs = std::max(4 * m_sRttUs, SCREAM_FEEDBACK_TIMEOUT_US);
+    bool lossEvent = false;
+    while (!m_inFlight.empty() && lessThan(m_inFlight.front().txTimestampUs + timeoutUs, nowUs)) {
+        m_bytesInFlight -= m_inFlight.front().size;
+        m_inFlight.pop_front();
+        lossEvent = true;
+    }
+    if (lossEvent) {
+        updateCwnd(nowUs, 0, true, false);
+        updateTargetBitrate(nowUs);
+    }
+    return m_bytesInFlight + size <= m_cwnd;
+}
+
+void ScreamController::updateQdelay(uint64_t nowUs, uint64_t owdUs) {
+    if (m_baseOwdHist.empty() ||
+        nowUs - m_baseOwdMinuteStartUs > SCREAM_BASE_OWD_INTERVAL_US) {
+        m_baseOwdHist.push_back(owdUs);
+        m_baseOwdMinuteStartUs = nowUs;
+        if (m_baseOwdHist.size() > SCREAM_BASE_OWD_HIST_LEN) {
+            m_baseOwdHist.pop_front();
+        }
+    } else if (lessThan(owdUs, m_baseOwdHist.back())) {
+        m_baseOwdHist.back() = owdUs;
+    }
+
+    uint64_t baseOwdUs = m_baseOwdHist.front();
+    for (uint64_t owd : m_baseOwdHist) {
+        if (lessThan(owd, baseOwdUs)) {
+            baseOwdUs = owd;
+        }
+    }
+    m_qdelayUs = owdUs - baseOwdUs;
+}
+
+void ScreamController::updateQdelayTrend(uint64_t nowUs) {
+    if (nowUs - m_lastTrendUpdateUs < SCREAM_QDELAY_TREND_INTERVAL_US) {
+        return;
+    }
+    m_lastTrendUpdateUs = nowUs;
+
+    const float qdelayFraction = float(m_qdelayUs) / SCREAM_QDELAY_TARGET_US;
+    m_qdelayFractionAvg += SCREAM_QDELAY_WEIGHT * (qdelayFraction - m_qdelayFractionAvg);
+    m_qdelayFractionHist.push_back(m_qdelayFractionAvg);
+    if (m_qdelayFractionHist.size() > SCREAM_QDELAY_HIST_LEN) {
+        m_qdelayFractionHist.pop_front();
+    }
+    if (m_qdelayFractionHist.size() < SCREAM_QDELAY_HIST_LEN) {
+        return;
+    }
+
+    /* trend from the lag-1 autocorrelation of the history */
+    float r0 = 0.f;
+    float r1 = 0.f;
+    for (size_t i = 0; i < m_qdelayFractionHist.size(); ++i) {
+        r0 += m_qdelayFractionHist[i] * m_qdelayFractionHist[i];
+        if (i + 1 < m_qdelayFractionHist.size()) {
+            r1 += m_qdelayFractionHist[i] * m_qdelayFractionHist[i + 1];
+        }
+    }
+    const float a = r0 > 0.f ? r1 / r0 : 0.f;
+    m_qdelayTrend = std::min(1.f, std::max(0.f, a * m_qdelayFractionAvg));
+    m_qdelayTrendMem = std::max(0.99f * m_qdelayTrendMem, m_qdelayTrend);
+}
+
+void ScreamController::updateCwnd(uint64_t nowUs, uint32_t bytesNewlyAcked,
+                                  bool lossEvent, bool ecnEvent) {
+    /* react to loss and ECN at most once per srtt */
+    if ((lossEvent || ecnEvent) &&
+        (!m_congestionSeen || nowUs - m_lastCongestionUs > m_sRttUs)) {
+        m_cwnd = std::max(SCREAM_MIN_CWND,
+                          m_cwnd * (lossEvent ? SCREAM_BETA_LOSS : SCREAM_BETA_ECN));
+        m_inFastIncrease = false;
+        m_congestionSeen = true;
+        m_lastCongestionUs = nowUs;
+        return;
+    }
+
+    /* only grow a window that is in use */
+    const bool cwndLimited = m_bytesInFlight * 1.5f + bytesNewlyAcked > m_cwnd;
+    if (m_inFastIncrease) {
+        if (m_qdelayTrend >= SCREAM_QDELAY_TREND_LO) {
+            m_inFastIncrease = false;
+        } else if (cwndLimited) {
+            m_cwnd += bytesNewlyAcked;
+        }
+    } else {
+        const float offTarget = (float(SCREAM_QDELAY_TARGET_US) - float(m_qdelayUs)) / SCREAM_QDELAY_TARGET_US;
+        if (offTarget < 0.f || cwndLimited) {
+            m_cwnd += SCREAM_GAIN * offTarget * bytesNewlyAcked * SCREAM_MSS / m_cwnd;
+        }
+        if ((!m_congestionSeen || nowUs - m_lastCongestionUs > SCREAM_POST_CONGESTION_DELAY_US) &&
+            m_qdelayTrend < SCREAM_QDELAY_TREND_LO) {
+            m_inFastIncrease = true;
+        }
+    }
+
+    const uint32_t maxBytesInFlight = std::max(m_maxBytesInFlight, m_maxBytesInFlightPrev);
+    if (maxBytesInFlight > 0) {
+        /* two more segments so that a window full of large packets can still grow */
+        m_cwnd = std::min(m_cwnd, maxBytesInFlight * SCREAM_MAX_BYTES_IN_FLIGHT_HEAD_ROOM + 2 * SCREAM_MSS);
+    }
+    m_cwnd = std::max(m_cwnd, SCREAM_MIN_CWND);
+}
+
+void ScreamController::updateTargetBitrate(uint64_t nowUs) {
+    if (nowUs - m_lastRateUpdateUs >= SCREAM_RATE_ADJUST_INTERVAL_US) {
+        const float dt = m_lastRateUpdateUs == 0 ? 0.f :
+                         (nowUs - m_lastRateUpdateUs) / 1e6f;
+        const float offTarget = (float(SCREAM_QDELAY_TARGET_US) - float(m_qdelayUs)) / SCREAM_QDELAY_TARGET_US;
+        if (offTarget < 0.f) {
+            /* drain the queue above the target delay */
+            m_targetBitrate *= std::max(0.5f, 1.f + offTarget * SCREAM_RATE_DECREASE_SCALE * dt);
+        } else {
+            float increase = std::max(SCREAM_RAMP_UP_SPEED, m_targetBitrate * SCREAM_RAMP_UP_SCALE) * dt;
+            if (!m_inFastIncrease) {
+                /* slow down when approaching the target queuing delay */
+                increase *= offTarget * (1.f - m_qdelayTrendMem);
+            }
+            m_targetBitrate += increase;
+        }
+        m_lastRateUpdateUs = nowUs;
+        logStats(nowUs);
+    }
+
+    /* never above what the window lets through */
+    if (m_sRttUs > 0) {
+        m_targetBitrate = std::min(m_targetBitrate, m_cwnd * 8 * 1e6f / m_sRttUs);
+    }
+    m_targetBitrate = std::min(std::max(m_targetBitrate, m_minBw), m_maxBw);
+}
+
+/**
+ * Implementation of the #getBandwidth API
+ * in the SenderBasedController class: simply
+ * returns the target bitrate of the encoder
+ */
+float ScreamController::getBandwidth(uint64_t nowUs) const {
+    return m_targetBitrate;
+}
+
+uint32_t ScreamController::getSendBps() const {
+    return m_targetBitrate;
+}
+
+void ScreamController::logStats(uint64_t nowUs) const {
+
+    std::ostringstream os;
+    os << std::fixed;
+    os.precision(RMCAT_LOG_PRINT_PRECISION);
+
+    os << " algo:scream " << m_id
+       << " ts: "     << (nowUs / 1000)
+       << " qdel: "   << (m_qdelayUs / 1000)
+       << " srtt: "   << (m_sRttUs / 1000)
+       << " cwnd: "   << m_cwnd
+       << " inflt: "  << m_bytesInFlight
+       << " trend: "  << m_qdelayTrend
+       << " fastinc: " << m_inFastIncrease
+       << " srate: "  << m_targetBitrate;
+    logMessage(os.str());
+}
+
+}
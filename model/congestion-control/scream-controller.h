@@ -0,0 +1,149 @@
+/**
+ * @file
+ * SCReAM controller interface for rmcat ns3 module.
+ */
+
+#ifndef SCREAM_CONTROLLER_H
+#define SCREAM_CONTROLLER_H
+
+#include "sender-based-controller.h"
+#include <deque>
+
+namespace rmcat {
+
+/**
+ * This class corresponds to the congestion control scheme named
+ * Self-Clocked Rate Adaptation for Multimedia (SCReAM), documented in
+ *
+ * Self-Clocked Rate Adaptation for Multimedia
+ * https://tools.ietf.org/html/rfc8298
+ *
+ * Unlike the rate-based GCC and NADA controllers, SCReAM limits the bytes
+ * in flight with a congestion window driven by the one-way queuing delay,
+ * losses and ECN marks of the acknowledged packets. The sender asks
+ * #canSendPacket before each transmission and holds the packet while the
+ * window is full; the target bitrate given to the encoder follows
+ * cwnd / srtt.
+ */
+class ScreamController: public SenderBasedController {
+public:
+    /* class constructor */
+    ScreamController();
+
+    /* class destructor */
+    virtual ~ScreamController();
+
+    /**
+     * Set the current bandwidth estimation. The congestion window is
+     * rescaled to the same rate at the current smoothed RTT
+     *
+     * @param [in] newBw Bandwidth estimation to overwrite the current estimation
+     */
+    virtual void setCurrentBw(float newBw);
+
+    /**
+     * SCReAM's implementation of the #reset virtual function;
+     * resets internal states to initial values
+     */
+    virtual void reset();
+
+    /** SCReAM's implementation of the #processSendPacket API */
+    virtual bool processSendPacket(uint64_t txTimestampUs,
+                                   uint16_t sequence,
+                                   uint32_t size);
+
+    /** SCReAM's implementation of the #processAck API, updates cwnd */
+    virtual void processAck(uint64_t nowUs,
+                            uint16_t sequence,
+                            uint64_t rxTimestampUs,
+                            uint8_t ecn);
+
+    /** SCReAM's implementation of the #canSendPacket API */
+    virtual bool canSendPacket(uint64_t nowUs, uint32_t size);
+
+    /** SCReAM's realization of the #getBandwidth API */
+    virtual float getBandwidth(uint64_t nowUs) const;
+    virtual uint32_t getSendBps() const;
+
+private:
+    struct InFlightPacket {
+        uint16_t sequence;
+        uint64_t txTimestampUs;
+        uint32_t size;
+    };
+
+    /**
+     * Update the base one-way delay, kept as the minimum of each of the
+     * last minutes, and the queuing delay of the acknowledged packet
+     *
+     * @param [in] nowUs current timestamp in microseconds
+     * @param [in] owdUs one-way delay of the acknowledged packet
+     */
+    void updateQdelay(uint64_t nowUs, uint64_t owdUs);
+
+    /**
+     * Sample the queuing delay fraction every 50ms and estimate the
+     * queuing delay trend from the autocorrelation of the last samples.
+     * See Sec. 4.1.2.2 of rfc8298
+     *
+     * @param [in] nowUs current timestamp in microseconds
+     */
+    void updateQdelayTrend(uint64_t nowUs);
+
+    /**
+     * Congestion window update for bytesNewlyAcked acknowledged bytes,
+     * see Sec. 4.1.2.3 of rfc8298
+     *
+     * @param [in] nowUs current timestamp in microseconds
+     * @param [in] bytesNewlyAcked bytes acknowledged by the feedback
+     * @param [in] lossEvent whether packets were lost before the acknowledged one
+     * @param [in] ecnEvent whether the acknowledged packet was CE-marked
+     */
+    void updateCwnd(uint64_t nowUs, uint32_t bytesNewlyAcked, bool lossEvent, bool ecnEvent);
+
+    /**
+     * Target bitrate of the encoder, cwnd / srtt smoothed and bounded by
+     * the minimal and maximal bandwidth
+     *
+     * @param [in] nowUs current timestamp in microseconds
+     */
+    void updateTargetBitrate(uint64_t nowUs);
+
+    /**
+     * Function for printing window, delay, and rate
+     * metrics to log in a pre-formatted manner
+     * @param [in] nowUs current timestamp in microseconds
+     */
+    void logStats(uint64_t nowUs) const;
+
+    std::deque<InFlightPacket> m_inFlight; /**< sent packets not acknowledged yet, by sequence */
+    uint32_t m_bytesInFlight;
+    uint32_t m_maxBytesInFlight;     /**< in the current srtt period */
+    uint32_t m_maxBytesInFlightPrev; /**< in the previous srtt period */
+    uint64_t m_maxBytesInFlightStartUs;
+
+    float m_cwnd;           /**< congestion window in bytes */
+    bool m_inFastIncrease;  /**< cwnd grows by the acknowledged bytes while the delay is not increasing */
+    uint64_t m_lastCongestionUs; /**< last reaction to loss or ECN, at most once per srtt */
+    bool m_congestionSeen;
+
+    uint64_t m_sRttUs;      /**< smoothed RTT in microseconds */
+    uint64_t m_lastAckUs;
+
+    std::deque<uint64_t> m_baseOwdHist; /**< minimum one-way delay of the last minutes */
+    uint64_t m_baseOwdMinuteStartUs;
+    uint64_t m_qdelayUs;    /**< queuing delay of the last acknowledged packet */
+
+    float m_qdelayFractionAvg;
+    std::deque<float> m_qdelayFractionHist;
+    uint64_t m_lastTrendUpdateUs;
+    float m_qdelayTrend;
+    float m_qdelayTrendMem;
+
+    float m_targetBitrate;  /**< in bps */
+    uint64_t m_lastRateUpdateUs;
+};
+
+}
+
+#endif /* SCREAM_CONTROLLER_H */
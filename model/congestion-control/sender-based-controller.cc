@@ -75,6 +75,7 @@ SenderBasedController::SenderBasedController()
   m_ilState{},
   m_lost{0},
   last_fraction_loss_{0},
+  last_fraction_mark_{0},
   loss_counter{0},
   m_historyLengthUs{DEFAULT_HISTORY_LENGTH_US} {
       setDefaultId();
@@ -293,10 +294,23 @@ bool SenderBasedController::processFeedback(uint64_t nowUs,
     return true;
 }
 
+void SenderBasedController::processAck(uint64_t nowUs,
+                                       uint16_t sequence,
+                                       uint64_t rxTimestampUs,
+                                       uint8_t ecn) {}
+
+bool SenderBasedController::canSendPacket(uint64_t nowUs, uint32_t size) {
+    return true;
+}
+
 void SenderBasedController::UpdateLossRate(uint8_t loss_q8) {
   last_fraction_loss_ = loss_q8;
 }
 
+void SenderBasedController::UpdateMarkRate(uint8_t mark_q8) {
+  last_fraction_mark_ = mark_q8;
+}
+
 void SenderBasedController::PrunTransitHistory(uint32_t tar_seq) {
     while(m_PacketTransitHistory.front().sequence < tar_seq) {
         // DEBUG("PrunTransitHistory:: " << m_PacketTransitHistory.front().sequence );DEBUG("PrunTransitHistory:: " << m_PacketTransitHistory.front().sequence );
@@ -39,6 +39,12 @@ namespace rmcat {
 
 const uint32_t RMCAT_LOG_PRINT_PRECISION = 2;  /* default precision for logs */
 
+/* ECN codepoints of the IP header (rfc3168, rfc9331) */
+const uint8_t ECN_NOT_ECT = 0;
+const uint8_t ECN_ECT1 = 1;     /* L4S */
+const uint8_t ECN_ECT0 = 2;
+const uint8_t ECN_CE = 3;
+
 /**
  * This class keeps track of the length of intervals between two packet
  * loss events, in the way TCP-friendly Rate Control (TFRC) calculates it
@@ -232,8 +238,41 @@ public:
 								 int64_t l_arrival_time,
                                  uint8_t ecn=0);
 
+    /**
+     * Called for every media packet reported in a feedback packet, before
+     * the per-group #processFeedback . Window-based controllers use it to
+     * track the bytes in flight; the default implementation does nothing
+     *
+     * @param [in] nowUs The time (in microseconds) at which this function is called
+     * @param [in] sequence The sequence number of the acknowledged media packet
+     * @param [in] rxTimestampUs The time (in microseconds) at which the media
+     *                           packet was received at the receiver endpoint
+     * @param [in] ecn The ECN codepoint of the media packet as received
+     */
+    virtual void processAck(uint64_t nowUs,
+                            uint16_t sequence,
+                            uint64_t rxTimestampUs,
+                            uint8_t ecn);
+
+    /**
+     * Whether the sender may transmit a packet now. Rate-based controllers
+     * always return true (the default); window-based controllers return
+     * false while the congestion window is full, and the sender holds the
+     * packet until the next feedback
+     *
+     * @param [in] nowUs The time (in microseconds) at which this function is called
+     * @param [in] size Size of the packet in bytes
+     */
+    virtual bool canSendPacket(uint64_t nowUs, uint32_t size);
+
     virtual void UpdateLossRate(uint8_t loss_q8);
 
+    /**
+     * Fraction of the media packets received with the CE codepoint, as
+     * reported by the receiver, in 1/256 units
+     */
+    virtual void UpdateMarkRate(uint8_t mark_q8);
+
     virtual void PrunTransitHistory(uint32_t tar_seq);
 
     virtual uint64_t UpdateDepartureTime(uint32_t prev_s, uint32_t now_s);
@@ -390,6 +429,7 @@ protected:
 
     uint32_t m_lost;
     uint8_t last_fraction_loss_;
+    uint8_t last_fraction_mark_;
 	int loss_counter;
 
 private:
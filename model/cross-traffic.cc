@@ -0,0 +1,166 @@
+#include "cross-traffic.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/type-id.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/bulk-send-helper.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/onoff-application.h"
+#include "ns3/inet-socket-address.h"
+#include <sstream>
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("CrossTraffic");
+
+TypeId CrossTraffic::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::CrossTraffic")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<CrossTraffic> ()
+    ;
+    return tid;
+};
+
+CrossTraffic::CrossTraffic ()
+: m_accessRate {DataRate (1e9)}
+, m_accessDelay {MilliSeconds (1)}
+{};
+
+CrossTraffic::~CrossTraffic () {};
+
+void CrossTraffic::AddBulk (std::string tcpType, Time start, Time stop) {
+    m_sources.push_back ({BULK, GetTcpTypeId (tcpType), DataRate (0), Time (0), Time (0), start, stop});
+};
+
+void CrossTraffic::AddOnOff (DataRate rate, Time onMean, Time offMean, Time start, Time stop) {
+    m_sources.push_back ({ONOFF, "", rate, onMean, offMean, start, stop});
+};
+
+void CrossTraffic::AddCbr (DataRate rate, Time start, Time stop) {
+    m_sources.push_back ({CBR, "", rate, Time (0), Time (0), start, stop});
+};
+
+void CrossTraffic::SetAccessLink (DataRate rate, Time delay) {
+    m_accessRate = rate;
+    m_accessDelay = delay;
+};
+
+std::string CrossTraffic::GetTcpTypeId (std::string tcpType) {
+    if (tcpType == "cubic")
+        return "ns3::TcpCubic";
+    if (tcpType == "bbr")
+        return "ns3::TcpBbr";
+    if (tcpType == "newreno")
+        return "ns3::TcpNewReno";
+    TypeId tid;
+    if (!TypeId::LookupByNameFailSafe (tcpType, &tid))
+        NS_FATAL_ERROR ("Unknown TCP congestion control: " + tcpType);
+    return tcpType;
+};
+
+void CrossTraffic::Install (Ptr<Node> router, Ptr<Node> sink, uint16_t basePort) {
+    NS_ASSERT_MSG (m_nodes.GetN () == 0, "CrossTraffic can only be installed once");
+    if (m_sources.empty ())
+        return;
+    m_nodes.Create (m_sources.size ());
+    InternetStackHelper internet;
+    internet.Install (m_nodes);
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute ("DataRate", DataRateValue (m_accessRate));
+    p2p.SetChannelAttribute ("Delay", TimeValue (m_accessDelay));
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase ("10.2.1.0", "255.255.255.0");
+    Ipv4Address sinkIp = sink->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+
+    for (uint32_t i = 0; i < m_sources.size (); i++) {
+        const Source & source = m_sources[i];
+        Ptr<Node> node = m_nodes.Get (i);
+        ipv4.Assign (p2p.Install (node, router));
+        ipv4.NewNetwork ();
+
+        uint16_t port = basePort + i;
+        Address sinkAddress (InetSocketAddress (sinkIp, port));
+        std::string factory = source.kind == BULK ? "ns3::TcpSocketFactory" : "ns3::UdpSocketFactory";
+        ApplicationContainer sender;
+        if (source.kind == BULK) {
+            node->GetObject<TcpL4Protocol> ()->SetAttribute ("SocketType",
+                TypeIdValue (TypeId::LookupByName (source.tcpType)));
+            BulkSendHelper bulk (factory, sinkAddress);
+            bulk.SetAttribute ("MaxBytes", UintegerValue (0));
+            sender = bulk.Install (node);
+        }
+        else {
+            OnOffHelper onOff (factory, sinkAddress);
+            onOff.SetConstantRate (source.rate, 1200);
+            if (source.kind == ONOFF) {
+                /* heavy-tailed bursts, Pareto mean = scale * shape / (shape - 1) */
+                std::ostringstream on, off;
+                on << "ns3::ParetoRandomVariable[Scale=" << source.onMean.GetSeconds () / 3 << "|Shape=1.5]";
+                off << "ns3::ExponentialRandomVariable[Mean=" << source.offMean.GetSeconds () << "]";
+                onOff.SetAttribute ("OnTime", StringValue (on.str ()));
+                onOff.SetAttribute ("OffTime", StringValue (off.str ()));
+            }
+            sender = onOff.Install (node);
+        }
+        sender.Start (source.start);
+        sender.Stop (source.stop);
+        m_senders.Add (sender);
+
+        PacketSinkHelper sinkHelper (factory, InetSocketAddress (Ipv4Address::GetAny (), port));
+        ApplicationContainer sinkApp = sinkHelper.Install (sink);
+        sinkApp.Start (source.start);
+        m_sinks.Add (sinkApp);
+        NS_LOG_INFO ("[CrossTraffic] source " << i << " kind " << source.kind << " " << source.tcpType
+            << " rate " << source.rate << " port " << port);
+    }
+};
+
+int64_t CrossTraffic::AssignStreams (int64_t stream) {
+    int64_t used = 0;
+    for (uint32_t i = 0; i < m_senders.GetN (); i++) {
+        Ptr<OnOffApplication> onOff = DynamicCast<OnOffApplication> (m_senders.Get (i));
+        if (onOff != NULL)
+            used += onOff->AssignStreams (stream + used);
+    }
+    return used;
+};
+
+uint32_t CrossTraffic::GetNSources () const {
+    return m_sources.size ();
+};
+
+double_t CrossTraffic::GetThroughput (uint32_t i) const {
+    NS_ASSERT (i < m_sinks.GetN ());
+    double_t duration = (m_sources[i].stop - m_sources[i].start).GetSeconds ();
+    if (duration <= 0)
+        return 0;
+    return DynamicCast<PacketSink> (m_sinks.Get (i))->GetTotalRx () * 8 / duration / 1e6;
+};
+
+void CrossTraffic::Report (std::ostream & os) const {
+    const char * names[] = {"bulk", "onoff", "cbr"};
+    double_t total = 0;
+    for (uint32_t i = 0; i < m_sinks.GetN (); i++) {
+        double_t throughput = GetThroughput (i);
+        total += throughput;
+        os << "cross " << i << " " << names[m_sources[i].kind];
+        if (m_sources[i].kind == BULK)
+            os << " " << m_sources[i].tcpType;
+        else
+            os << " " << m_sources[i].rate.GetBitRate () / 1e6 << "Mbps";
+        os << " throughput " << throughput << "Mbps" << std::endl;
+    }
+    os << "cross all throughput " << total << "Mbps" << std::endl;
+};
+
+}; // namespace ns3
@@ -0,0 +1,90 @@
+#ifndef CROSS_TRAFFIC_H
+#define CROSS_TRAFFIC_H
+
+#include "common-header.h"
+#include "ns3/object.h"
+#include "ns3/node-container.h"
+#include "ns3/application-container.h"
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Competing traffic through a bottleneck: TCP bulk transfers
+ * (BulkSend), web-like on/off UDP bursts and constant-bitrate UDP.
+ *
+ * Each source runs on its own node attached to the router in front of the
+ * bottleneck, so that every bulk flow can use a different TCP congestion
+ * control. All sinks are on the node behind the bottleneck.
+ */
+class CrossTraffic : public Object {
+public:
+    static TypeId GetTypeId (void);
+    CrossTraffic ();
+    ~CrossTraffic ();
+
+    enum Kind { BULK, ONOFF, CBR };
+
+    /**
+     * \param tcpType "cubic", "bbr", "newreno" or a TcpCongestionOps TypeId name
+     */
+    void AddBulk (std::string tcpType, Time start, Time stop);
+    /**
+     * \brief UDP bursts at rate, with Pareto on times and exponential off times
+     */
+    void AddOnOff (DataRate rate, Time onMean, Time offMean, Time start, Time stop);
+    void AddCbr (DataRate rate, Time start, Time stop);
+
+    /**
+     * \brief Link between a source node and the router, 1Gbps and 1ms by default
+     */
+    void SetAccessLink (DataRate rate, Time delay);
+
+    /**
+     * \brief Create the source nodes and applications. Call before
+     * Ipv4GlobalRoutingHelper::PopulateRoutingTables.
+     *
+     * \param router node in front of the bottleneck
+     * \param sink node behind the bottleneck, its interface 1 is the destination
+     * \param basePort source i sends to basePort + i
+     */
+    void Install (Ptr<Node> router, Ptr<Node> sink, uint16_t basePort);
+
+    int64_t AssignStreams (int64_t stream);
+
+    uint32_t GetNSources () const;
+    /**
+     * \brief Received throughput of source i over its active period, in Mbps
+     */
+    double_t GetThroughput (uint32_t i) const;
+
+    void Report (std::ostream & os) const;
+
+private:
+    struct Source {
+        Kind kind;
+        std::string tcpType;
+        DataRate rate;
+        Time onMean;
+        Time offMean;
+        Time start;
+        Time stop;
+    };
+
+    static std::string GetTcpTypeId (std::string tcpType);
+
+    std::vector<Source> m_sources;
+    DataRate m_accessRate;
+    Time m_accessDelay;
+    NodeContainer m_nodes;
+    ApplicationContainer m_senders;
+    ApplicationContainer m_sinks;
+};  // class CrossTraffic
+
+};  // namespace ns3
+
+#endif  /* CROSS_TRAFFIC_H */
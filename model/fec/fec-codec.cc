@@ -0,0 +1,496 @@
+#include "fec-codec.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include <cstring>
+#include <time.h>
+
+#if (defined (__x86_64__) || defined (__i386__)) && defined (__GNUC__)
+#define FEC_CODEC_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("FecCodec");
+
+NS_OBJECT_ENSURE_REGISTERED (FecCodec);
+
+/* class GaloisField */
+struct GaloisFieldTables {
+    uint8_t exp[512];
+    uint8_t log[256];
+    uint8_t mul[256][256];
+    uint8_t lo[256][16];    /* c * x for the low nibble x */
+    uint8_t hi[256][16];    /* c * (x << 4) for the high nibble x */
+
+    GaloisFieldTables () {
+        uint16_t x = 1;
+        for (uint16_t i = 0; i < 255; i++) {
+            exp[i] = exp[i + 255] = x;
+            log[x] = i;
+            x <<= 1;
+            if (x & 0x100)
+                x ^= 0x11d;
+        }
+        exp[510] = exp[511] = 0;
+        log[0] = 0;
+        for (uint16_t a = 0; a < 256; a++)
+            for (uint16_t b = 0; b < 256; b++)
+                mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+        for (uint16_t c = 0; c < 256; c++) {
+            for (uint8_t n = 0; n < 16; n++) {
+                lo[c][n] = mul[c][n];
+                hi[c][n] = mul[c][n << 4];
+            }
+        }
+    };
+};
+
+static const GaloisFieldTables & GetTables () {
+    static const GaloisFieldTables tables;
+    return tables;
+};
+
+/* Add: dst ^= c * src, otherwise dst = c * src */
+template <bool Add>
+static void RegionScalar (uint8_t * dst, const uint8_t * src, uint8_t c, size_t len) {
+    const uint8_t * row = GetTables ().mul[c];
+    for (size_t i = 0; i < len; i++)
+        dst[i] = Add ? dst[i] ^ row[src[i]] : row[src[i]];
+};
+
+#ifdef FEC_CODEC_X86_SIMD
+template <bool Add>
+__attribute__ ((target ("ssse3")))
+static void RegionSsse3 (uint8_t * dst, const uint8_t * src, uint8_t c, size_t len) {
+    const GaloisFieldTables & t = GetTables ();
+    const __m128i lo = _mm_loadu_si128 ((const __m128i *) t.lo[c]);
+    const __m128i hi = _mm_loadu_si128 ((const __m128i *) t.hi[c]);
+    const __m128i mask = _mm_set1_epi8 (0x0f);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i s = _mm_loadu_si128 ((const __m128i *) (src + i));
+        __m128i p = Add && c == 1 ? s : _mm_xor_si128 (
+            _mm_shuffle_epi8 (lo, _mm_and_si128 (s, mask)),
+            _mm_shuffle_epi8 (hi, _mm_and_si128 (_mm_srli_epi64 (s, 4), mask)));
+        if (Add)
+            p = _mm_xor_si128 (p, _mm_loadu_si128 ((const __m128i *) (dst + i)));
+        _mm_storeu_si128 ((__m128i *) (dst + i), p);
+    }
+    RegionScalar<Add> (dst + i, src + i, c, len - i);
+};
+
+template <bool Add>
+__attribute__ ((target ("avx2")))
+static void RegionAvx2 (uint8_t * dst, const uint8_t * src, uint8_t c, size_t len) {
+    const GaloisFieldTables & t = GetTables ();
+    /* vpshufb looks up within each 128-bit lane, both lanes get the table */
+    const __m256i lo = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) t.lo[c]));
+    const __m256i hi = _mm256_broadcastsi128_si256 (_mm_loadu_si128 ((const __m128i *) t.hi[c]));
+    const __m256i mask = _mm256_set1_epi8 (0x0f);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i s = _mm256_loadu_si256 ((const __m256i *) (src + i));
+        __m256i p = Add && c == 1 ? s : _mm256_xor_si256 (
+            _mm256_shuffle_epi8 (lo, _mm256_and_si256 (s, mask)),
+            _mm256_shuffle_epi8 (hi, _mm256_and_si256 (_mm256_srli_epi64 (s, 4), mask)));
+        if (Add)
+            p = _mm256_xor_si256 (p, _mm256_loadu_si256 ((const __m256i *) (dst + i)));
+        _mm256_storeu_si256 ((__m256i *) (dst + i), p);
+    }
+    RegionSsse3<Add> (dst + i, src + i, c, len - i);
+};
+#endif
+
+static bool IsKernelSupported (GaloisField::Kernel kernel) {
+#ifdef FEC_CODEC_X86_SIMD
+    __builtin_cpu_init ();
+    if (kernel == GaloisField::AVX2)
+        return __builtin_cpu_supports ("avx2");
+    if (kernel == GaloisField::SSSE3)
+        return __builtin_cpu_supports ("ssse3");
+#endif
+    return kernel == GaloisField::SCALAR;
+};
+
+GaloisField::Kernel GaloisField::s_kernel = GaloisField::SCALAR;
+bool GaloisField::s_kernelSet = false;
+
+uint8_t GaloisField::Mul (uint8_t a, uint8_t b) {
+    return GetTables ().mul[a][b];
+};
+
+uint8_t GaloisField::Inv (uint8_t a) {
+    NS_ASSERT_MSG (a != 0, "0 has no inverse in GF(2^8)");
+    const GaloisFieldTables & t = GetTables ();
+    return t.exp[255 - t.log[a]];
+};
+
+void GaloisField::MulAdd (uint8_t * dst, const uint8_t * src, uint8_t c, size_t len) {
+    if (c == 0)
+        return;
+    switch (GetKernel ()) {
+#ifdef FEC_CODEC_X86_SIMD
+    case AVX2:
+        RegionAvx2<true> (dst, src, c, len);
+        break;
+    case SSSE3:
+        RegionSsse3<true> (dst, src, c, len);
+        break;
+#endif
+    default:
+        RegionScalar<true> (dst, src, c, len);
+        break;
+    }
+};
+
+void GaloisField::MulRegion (uint8_t * dst, uint8_t c, size_t len) {
+    if (c == 1)
+        return;
+    if (c == 0) {
+        memset (dst, 0, len);
+        return;
+    }
+    switch (GetKernel ()) {
+#ifdef FEC_CODEC_X86_SIMD
+    case AVX2:
+        RegionAvx2<false> (dst, dst, c, len);
+        break;
+    case SSSE3:
+        RegionSsse3<false> (dst, dst, c, len);
+        break;
+#endif
+    default:
+        RegionScalar<false> (dst, dst, c, len);
+        break;
+    }
+};
+
+GaloisField::Kernel GaloisField::GetKernel () {
+    if (!s_kernelSet)
+        SetKernel (AVX2);
+    return s_kernel;
+};
+
+void GaloisField::SetKernel (Kernel kernel) {
+    while (!IsKernelSupported (kernel))
+        kernel = (Kernel) (kernel - 1);
+    s_kernel = kernel;
+    s_kernelSet = true;
+    NS_LOG_INFO ("[GaloisField] region kernel " << GetKernelName (kernel));
+};
+
+std::string GaloisField::GetKernelName (Kernel kernel) {
+    switch (kernel) {
+    case AVX2:
+        return "avx2";
+    case SSSE3:
+        return "ssse3";
+    default:
+        return "scalar";
+    }
+};
+
+/* class FecCodec */
+FecCodec::Stats::Stats ()
+: batches {0}
+, bytes {0}
+, cpuNs {0}
+, failures {0}
+, mismatches {0}
+{};
+
+TypeId FecCodec::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::FecCodec")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+    ;
+    return tid;
+};
+
+FecCodec::FecCodec (CodeType type)
+: m_type {type}
+, m_logStream {NULL}
+, m_encodeStats {}
+, m_decodeStats {}
+{};
+
+FecCodec::~FecCodec () {};
+
+FecCodec::CodeType FecCodec::GetCodeType () const {
+    return m_type;
+};
+
+void FecCodec::SetLogStream (Ptr<OutputStreamWrapper> stream) {
+    m_logStream = stream;
+};
+
+uint8_t FecCodec::GetCoefficient (uint16_t repairIdx, uint16_t dataIdx, uint16_t dataNum, uint16_t repairNum) const {
+    return GetCoefficient (m_type, repairIdx, dataIdx, dataNum, repairNum);
+};
+
+uint8_t FecCodec::GetCoefficient (CodeType type, uint16_t repairIdx, uint16_t dataIdx, uint16_t dataNum, uint16_t repairNum) {
+    if (type == XOR)
+        return dataIdx % repairNum == repairIdx % repairNum;
+    NS_ASSERT_MSG (dataNum + repairIdx < k_maxRsBatch, "Reed-Solomon batches are limited to 256 packets");
+    return GaloisField::Inv ((uint8_t) ((dataNum + repairIdx) ^ dataIdx));
+};
+
+uint32_t FecCodec::GetSymbolSize (uint32_t maxPayloadSize) {
+    return maxPayloadSize + 2;
+};
+
+void FecCodec::ToSymbol (const Symbol & payload, uint32_t symbolSize, uint8_t * out) {
+    NS_ASSERT (payload.size () + 2 <= symbolSize);
+    out[0] = payload.size () >> 8;
+    out[1] = payload.size () & 0xff;
+    memcpy (out + 2, payload.data (), payload.size ());
+    memset (out + 2 + payload.size (), 0, symbolSize - 2 - payload.size ());
+};
+
+bool FecCodec::FromSymbol (const uint8_t * symbol, uint32_t symbolSize, Symbol & payload) {
+    uint32_t size = ((uint32_t) symbol[0] << 8) | symbol[1];
+    if (size + 2 > symbolSize)
+        return false;
+    payload.assign (symbol + 2, symbol + 2 + size);
+    return true;
+};
+
+std::vector<FecCodec::Symbol> FecCodec::EncodeBatch (uint32_t batchId, const std::vector<Symbol> & payloads, uint16_t repairNum) {
+    uint64_t start = GetCpuTimeNs ();
+    uint16_t dataNum = payloads.size ();
+    uint32_t maxPayloadSize = 0;
+    for (auto & payload : payloads)
+        maxPayloadSize = MAX (maxPayloadSize, (uint32_t) payload.size ());
+    uint32_t symbolSize = GetSymbolSize (maxPayloadSize);
+
+    std::vector<Symbol> repairs (repairNum, Symbol (symbolSize, 0));
+    Symbol symbol (symbolSize);
+    /* one data symbol at a time, so that it stays in cache for all repairs */
+    for (uint16_t i = 0; i < dataNum; i++) {
+        ToSymbol (payloads[i], symbolSize, symbol.data ());
+        for (uint16_t j = 0; j < repairNum; j++)
+            GaloisField::MulAdd (repairs[j].data (), symbol.data (), GetCoefficient (j, i, dataNum, repairNum), symbolSize);
+    }
+
+    RecordEncode (batchId, dataNum, repairNum, (uint64_t) repairNum * symbolSize, GetCpuTimeNs () - start);
+    return repairs;
+};
+
+void FecCodec::FillPayload (uint8_t * buffer, uint32_t size, uint32_t frameId, uint16_t pktIdInFrame) {
+    /* xorshift32, seeded by the packet */
+    uint32_t x = (frameId * 65537u + pktIdInFrame) | 1;
+    for (uint32_t i = 0; i < size; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buffer[i] = x & 0xff;
+    }
+};
+
+bool FecCodec::CheckPayload (const Symbol & payload, uint32_t frameId, uint16_t pktIdInFrame) {
+    Symbol expected (payload.size ());
+    FillPayload (expected.data (), expected.size (), frameId, pktIdInFrame);
+    if (expected == payload)
+        return true;
+    m_decodeStats.mismatches ++;
+    NS_LOG_ERROR ("[FecCodec] recovered payload of frame " << frameId << " packet " << pktIdInFrame << " differs");
+    return false;
+};
+
+void FecCodec::RecordEncode (uint32_t id, uint16_t dataNum, uint16_t repairNum, uint64_t bytes, uint64_t cpuNs) {
+    m_encodeStats.batches ++;
+    m_encodeStats.bytes += bytes;
+    m_encodeStats.cpuNs += cpuNs;
+    Log ("encode", id, dataNum, repairNum, bytes, cpuNs);
+};
+
+void FecCodec::RecordDecode (uint32_t id, uint16_t dataNum, uint16_t repairNum, uint64_t bytes, uint64_t cpuNs, bool success) {
+    m_decodeStats.batches ++;
+    m_decodeStats.cpuNs += cpuNs;
+    if (success)
+        m_decodeStats.bytes += bytes;
+    else
+        m_decodeStats.failures ++;
+    Log (success ? "decode" : "decode-failed", id, dataNum, repairNum, bytes, cpuNs);
+};
+
+const FecCodec::Stats & FecCodec::GetEncodeStats () const {
+    return m_encodeStats;
+};
+
+const FecCodec::Stats & FecCodec::GetDecodeStats () const {
+    return m_decodeStats;
+};
+
+void FecCodec::Report (std::ostream & os) const {
+    auto print = [&os] (std::string op, const Stats & stats) {
+        double_t cpuMs = stats.cpuNs / 1e6;
+        os << op << " batches " << stats.batches
+           << " bytes " << stats.bytes
+           << " cpu " << cpuMs << "ms"
+           << " per batch " << (stats.batches > 0 ? stats.cpuNs / 1e3 / stats.batches : 0) << "us"
+           << " rate " << (cpuMs > 0 ? stats.bytes * 8 / cpuMs / 1e3 : 0) << "Mbps";
+    };
+    os << "[FecCodec] " << (m_type == RS ? "RS" : "XOR")
+       << " kernel " << GaloisField::GetKernelName (GaloisField::GetKernel ()) << ", ";
+    print ("encode", m_encodeStats);
+    os << ", ";
+    print ("decode", m_decodeStats);
+    os << " failures " << m_decodeStats.failures
+       << " mismatches " << m_decodeStats.mismatches << std::endl;
+};
+
+uint64_t FecCodec::GetCpuTimeNs () {
+    struct timespec ts;
+    clock_gettime (CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000ull + ts.tv_nsec;
+};
+
+void FecCodec::Log (std::string op, uint32_t id, uint16_t dataNum, uint16_t repairNum, uint64_t bytes, uint64_t cpuNs) {
+    NS_LOG_FUNCTION ("[FecCodec] " << op << " batch " << id << " " << cpuNs / 1e3 << "us");
+    if (m_logStream == NULL)
+        return;
+    *m_logStream->GetStream () << Simulator::Now ().GetMilliSeconds () <<
+        " FecCodec " << op <<
+        " batchId " << id <<
+        " dataNum " << dataNum <<
+        " repairNum " << repairNum <<
+        " bytes " << bytes <<
+        " cpuUs " << cpuNs / 1e3 <<
+        std::endl;
+};
+
+/* class LinearFecDecoder */
+LinearFecDecoder::LinearFecDecoder ()
+: m_known {}
+, m_rows {}
+{};
+
+void LinearFecDecoder::AddScaled (Symbol & dst, const Symbol & src, uint8_t c) {
+    if (src.size () > dst.size ())
+        dst.resize (src.size (), 0);
+    GaloisField::MulAdd (dst.data (), src.data (), c, src.size ());
+};
+
+void LinearFecDecoder::AddScaled (Row & dst, const Row & src, uint8_t c) {
+    for (auto & term : src.coeffs) {
+        uint8_t value = dst.coeffs[term.first] ^ GaloisField::Mul (c, term.second);
+        if (value == 0)
+            dst.coeffs.erase (term.first);
+        else
+            dst.coeffs[term.first] = value;
+    }
+    AddScaled (dst.symbol, src.symbol, c);
+};
+
+std::vector<LinearFecDecoder::SourceId> LinearFecDecoder::AddSource (SourceId id, const Symbol & symbol) {
+    std::vector<SourceId> decoded;
+    if (IsKnown (id))
+        return decoded;
+    m_known[id] = symbol;
+    /* substitute it; a row losing its pivot is inserted again */
+    std::vector<Row> repivot;
+    for (auto it = m_rows.begin (); it != m_rows.end ();) {
+        auto term = it->second.coeffs.find (id);
+        if (term == it->second.coeffs.end ()) {
+            it ++;
+            continue;
+        }
+        AddScaled (it->second.symbol, symbol, term->second);
+        it->second.coeffs.erase (term);
+        if (it->first == id) {
+            repivot.push_back (std::move (it->second));
+            it = m_rows.erase (it);
+        } else
+            it ++;
+    }
+    for (auto & row : repivot)
+        Insert (std::move (row), decoded);
+    /* rows left with their pivot only are solved */
+    Insert (Row (), decoded);
+    return decoded;
+};
+
+std::vector<LinearFecDecoder::SourceId> LinearFecDecoder::AddRepair (const std::map<SourceId, uint8_t> & coeffs, const Symbol & symbol) {
+    std::vector<SourceId> decoded;
+    Row row;
+    row.symbol = symbol;
+    for (auto & term : coeffs) {
+        if (term.second == 0)
+            continue;
+        auto known = m_known.find (term.first);
+        if (known != m_known.end ())
+            AddScaled (row.symbol, known->second, term.second);
+        else
+            row.coeffs[term.first] = term.second;
+    }
+    Insert (std::move (row), decoded);
+    return decoded;
+};
+
+void LinearFecDecoder::Insert (Row row, std::vector<SourceId> & decoded) {
+    /* eliminate the pivots of the other rows, they do not appear elsewhere */
+    std::vector<SourceId> pivots;
+    for (auto & term : row.coeffs) {
+        if (m_rows.find (term.first) != m_rows.end ())
+            pivots.push_back (term.first);
+    }
+    for (SourceId pivot : pivots)
+        AddScaled (row, m_rows[pivot], row.coeffs[pivot]);
+
+    if (!row.coeffs.empty ()) {
+        /* new pivot: normalize, then eliminate it from the other rows */
+        SourceId pivot = row.coeffs.begin ()->first;
+        uint8_t inv = GaloisField::Inv (row.coeffs.begin ()->second);
+        for (auto & term : row.coeffs)
+            term.second = GaloisField::Mul (term.second, inv);
+        GaloisField::MulRegion (row.symbol.data (), inv, row.symbol.size ());
+        for (auto & other : m_rows) {
+            auto term = other.second.coeffs.find (pivot);
+            if (term != other.second.coeffs.end ())
+                AddScaled (other.second, row, term->second);
+        }
+        m_rows[pivot] = std::move (row);
+    }
+
+    for (auto it = m_rows.begin (); it != m_rows.end ();) {
+        if (it->second.coeffs.size () == 1) {
+            m_known[it->first] = std::move (it->second.symbol);
+            decoded.push_back (it->first);
+            it = m_rows.erase (it);
+        } else
+            it ++;
+    }
+};
+
+bool LinearFecDecoder::IsKnown (SourceId id) const {
+    return m_known.find (id) != m_known.end ();
+};
+
+const LinearFecDecoder::Symbol & LinearFecDecoder::GetSymbol (SourceId id) const {
+    auto it = m_known.find (id);
+    NS_ASSERT_MSG (it != m_known.end (), "Source " << id << " is not known");
+    return it->second;
+};
+
+void LinearFecDecoder::Forget (const std::vector<SourceId> & ids) {
+    for (SourceId id : ids) {
+        m_known.erase (id);
+        for (auto it = m_rows.begin (); it != m_rows.end ();) {
+            if (it->second.coeffs.find (id) != it->second.coeffs.end ())
+                it = m_rows.erase (it);
+            else
+                it ++;
+        }
+    }
+};
+
+std::vector<LinearFecDecoder::SourceId> LinearFecDecoder::GetPivots () const {
+    std::vector<SourceId> pivots;
+    for (auto & row : m_rows)
+        pivots.push_back (row.first);
+    return pivots;
+};
+
+}; // namespace ns3
@@ -0,0 +1,206 @@
+#ifndef FEC_CODEC_H
+#define FEC_CODEC_H
+
+#include "ns3/common-header.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/output-stream-wrapper.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief GF(2^8) arithmetic over the polynomial x^8 + x^4 + x^3 + x^2 + 1
+ * (0x11d), with region kernels for the codec.
+ *
+ * The region kernels multiply 16 or 32 bytes at once by splitting each byte
+ * into nibbles and looking both up with a byte shuffle (SSSE3 pshufb, AVX2
+ * vpshufb). The best kernel the CPU supports is chosen on the first use,
+ * the scalar one uses a 64 KB multiplication table.
+ */
+class GaloisField {
+public:
+    enum Kernel { SCALAR, SSSE3, AVX2 };
+
+    static uint8_t Mul (uint8_t a, uint8_t b);
+    static uint8_t Inv (uint8_t a);
+
+    /* dst ^= c * src over len bytes */
+    static void MulAdd (uint8_t * dst, const uint8_t * src, uint8_t c, size_t len);
+    /* dst = c * dst over len bytes */
+    static void MulRegion (uint8_t * dst, uint8_t c, size_t len);
+
+    static Kernel GetKernel ();
+    /**
+     * \brief Force a kernel, e.g. to compare them. A kernel the CPU does not
+     * support falls back to the best supported one.
+     */
+    static void SetKernel (Kernel kernel);
+    static std::string GetKernelName (Kernel kernel);
+
+private:
+    static Kernel s_kernel;
+    static bool s_kernelSet;
+};  // class GaloisField
+
+/**
+ * \brief Systematic erasure codec over the payloads of a FEC batch, for the
+ * real payload mode of GameServer and GameClient.
+ *
+ * A batch of k data payloads is extended with m repair symbols; repair j is
+ * sum_i c(j, i) * D_i over GF(2^8), where D_i is the payload i prefixed with
+ * its 2-byte length and zero-padded to the longest payload of the batch.
+ *
+ * RS uses the Cauchy matrix c(j, i) = 1 / ((k + j) ^ i), so any k of the
+ * k + m symbols recover the batch (k + m <= 256). XOR uses interleaved
+ * parities, repair j covering the data packets i = j mod m, and recovers at
+ * most one loss per parity.
+ *
+ * The CPU time of every encoded batch and decoded group is measured (thread
+ * CPU clock), accumulated in GetEncodeStats and GetDecodeStats and, if a log
+ * stream is set, logged as one line per batch.
+ */
+class FecCodec : public Object {
+public:
+    enum CodeType { XOR, RS };
+    typedef std::vector<uint8_t> Symbol;
+
+    struct Stats {
+        uint64_t batches;
+        uint64_t bytes;         /* repair bytes encoded, or payload bytes recovered */
+        uint64_t cpuNs;
+        uint64_t failures;      /* decoding only: groups with repairs that missed their deadline */
+        uint64_t mismatches;    /* decoding only: recovered payloads differing from the sent ones */
+        Stats ();
+    };
+
+    /* data and repair packets of a Reed-Solomon batch, see GetCoefficient */
+    static constexpr uint16_t k_maxRsBatch = 256;
+
+    static TypeId GetTypeId (void);
+    FecCodec (CodeType type);
+    ~FecCodec ();
+
+    CodeType GetCodeType () const;
+    void SetLogStream (Ptr<OutputStreamWrapper> stream);
+
+    /**
+     * \brief Coefficient of data packet dataIdx in repair symbol repairIdx of
+     * a batch of dataNum data and repairNum repair packets
+     */
+    uint8_t GetCoefficient (uint16_t repairIdx, uint16_t dataIdx, uint16_t dataNum, uint16_t repairNum) const;
+    static uint8_t GetCoefficient (CodeType type, uint16_t repairIdx, uint16_t dataIdx, uint16_t dataNum, uint16_t repairNum);
+
+    /**
+     * \brief Encode the repair symbols of a batch
+     *
+     * \param payloads data payloads in batch order
+     * \return repairNum symbols, to be sent as the payloads of the FEC packets
+     */
+    std::vector<Symbol> EncodeBatch (uint32_t batchId, const std::vector<Symbol> & payloads, uint16_t repairNum);
+
+    /**
+     * \brief Deterministic content of a data payload, so that the receiver can
+     * check what it recovers
+     */
+    static void FillPayload (uint8_t * buffer, uint32_t size, uint32_t frameId, uint16_t pktIdInFrame);
+    /**
+     * \brief Check a recovered payload against FillPayload, counted in the
+     * mismatches of GetDecodeStats
+     */
+    bool CheckPayload (const Symbol & payload, uint32_t frameId, uint16_t pktIdInFrame);
+
+    /**
+     * \brief Account and log coding work done outside EncodeBatch, i.e. the
+     * decoding of a group and the sliding-window FEC
+     */
+    void RecordEncode (uint32_t id, uint16_t dataNum, uint16_t repairNum, uint64_t bytes, uint64_t cpuNs);
+    void RecordDecode (uint32_t id, uint16_t dataNum, uint16_t repairNum, uint64_t bytes, uint64_t cpuNs, bool success);
+
+    const Stats & GetEncodeStats () const;
+    const Stats & GetDecodeStats () const;
+    void Report (std::ostream & os) const;
+
+    /* payload framing: 2-byte length, payload, zero padding up to symbolSize */
+    static uint32_t GetSymbolSize (uint32_t maxPayloadSize);
+    static void ToSymbol (const Symbol & payload, uint32_t symbolSize, uint8_t * out);
+    static bool FromSymbol (const uint8_t * symbol, uint32_t symbolSize, Symbol & payload);
+
+    /* CPU time of the calling thread */
+    static uint64_t GetCpuTimeNs ();
+
+private:
+    void Log (std::string op, uint32_t id, uint16_t dataNum, uint16_t repairNum, uint64_t bytes, uint64_t cpuNs);
+
+    CodeType m_type;
+    Ptr<OutputStreamWrapper> m_logStream;
+    Stats m_encodeStats;
+    Stats m_decodeStats;
+};  // class FecCodec
+
+/**
+ * \brief Incremental decoder of linear repair symbols over source packets
+ * named by arbitrary ids, for codes whose repairs do not follow the batches
+ * of FecCodec (e.g. the sliding-window FEC).
+ *
+ * Every repair is an equation sum_id c_id * S_id = R over GF(2^8), with S_id
+ * the framed symbol of a source (see FecCodec::ToSymbol). The unknown sources
+ * are kept in reduced row echelon form, so that a source is decoded as soon
+ * as the received sources and repairs determine it. Symbols of different
+ * lengths are zero-extended. Without payloads (empty symbols) only the
+ * coefficients are eliminated, which tells exactly what real decoding would
+ * recover.
+ */
+class LinearFecDecoder {
+public:
+    typedef uint64_t SourceId;
+    typedef FecCodec::Symbol Symbol;
+
+    LinearFecDecoder ();
+
+    /**
+     * \brief A source packet arrived
+     *
+     * \return the sources decoded thanks to it
+     */
+    std::vector<SourceId> AddSource (SourceId id, const Symbol & symbol);
+    /**
+     * \brief A repair symbol arrived
+     *
+     * \return the sources decoded thanks to it
+     */
+    std::vector<SourceId> AddRepair (const std::map<SourceId, uint8_t> & coeffs, const Symbol & symbol);
+
+    bool IsKnown (SourceId id) const;
+    /* framed symbol of a received or decoded source */
+    const Symbol & GetSymbol (SourceId id) const;
+    /**
+     * \brief Forget sources and the equations involving them, e.g. after
+     * their deadline
+     */
+    void Forget (const std::vector<SourceId> & ids);
+    /* one source of each equation that does not determine a source yet, the
+       others of the equation determine it once known */
+    std::vector<SourceId> GetPivots () const;
+
+private:
+    struct Row {
+        std::map<SourceId, uint8_t> coeffs;
+        Symbol symbol;
+    };
+
+    /* dst += c * src, zero-extending dst */
+    static void AddScaled (Symbol & dst, const Symbol & src, uint8_t c);
+    static void AddScaled (Row & dst, const Row & src, uint8_t c);
+    /* reduce a new equation and insert it, then collect the solved rows */
+    void Insert (Row row, std::vector<SourceId> & decoded);
+
+    std::map<SourceId, Symbol> m_known;
+    std::map<SourceId, Row> m_rows;     /* by pivot, the pivots appear in their row only */
+};  // class LinearFecDecoder
+
+};  // namespace ns3
+
+#endif  /* FEC_CODEC_H */
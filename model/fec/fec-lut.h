@@ -0,0 +1,85 @@
+#ifndef FEC_LUT_H
+#define FEC_LUT_H
+
+#include "ns3/common-header.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <tuple>
+
+namespace ns3 {
+
+/* How a value between two grid points is mapped to an index */
+enum class FecLutRound { NEAREST, CEIL, FLOOR };
+
+/**
+ * \brief Compile-time axis of a FecLut: count grid points at
+ * (start + i * step) / scale, e.g. FecLutAxis<0, 1, 51, NEAREST, 100> for the
+ * loss rates 0.00, 0.01, ..., 0.50.
+ *
+ * Values out of the grid are clamped to its first or last point.
+ */
+template <int Start, int Step, size_t Count, FecLutRound Round = FecLutRound::NEAREST, int Scale = 1>
+struct FecLutAxis {
+    static constexpr size_t k_count = Count;
+    static constexpr double_t k_start = (double_t) Start / Scale;
+    static constexpr double_t k_step = (double_t) Step / Scale;
+    static constexpr double_t k_last = k_start + (Count - 1) * k_step;
+
+    static size_t Index (double_t value) {
+        /* min/max compile to branch-free instructions, the mode is resolved at compile time */
+        double_t pos = (std::min (std::max (value, k_start), k_last) - k_start) / k_step;
+        if constexpr (Round == FecLutRound::CEIL)
+            return (size_t) std::ceil (pos);
+        if constexpr (Round == FecLutRound::FLOOR)
+            return (size_t) std::floor (pos);
+        return (size_t) (pos + 0.5);    /* pos >= 0, same as round () */
+    };
+
+    static double_t At (size_t index) {
+        return k_start + index * k_step;
+    };
+};
+
+/**
+ * \brief N-dimensional lookup table over FecLutAxis descriptors, row-major
+ * with the last axis varying fastest.
+ *
+ * The table does not own its entries: they are either a static array defined
+ * in one translation unit, or a mapped file (see HairpinTable).
+ */
+template <typename T, typename... Axes>
+class FecLut {
+public:
+    static constexpr size_t k_dims = sizeof... (Axes);
+    static constexpr size_t k_size = (Axes::k_count * ...);
+
+    template <size_t I>
+    using Axis = std::tuple_element_t<I, std::tuple<Axes...>>;
+
+    FecLut () : m_data {nullptr} {};
+    explicit FecLut (const T * data) : m_data {data} {};
+
+    template <typename... Values>
+    static size_t Index (Values... values) {
+        static_assert (sizeof... (Values) == k_dims, "One value per axis");
+        size_t index = 0;
+        /* left fold: index = (index * count + axis index) for each axis in order */
+        ((index = index * Axes::k_count + Axes::Index ((double_t) values)), ...);
+        return index;
+    };
+
+    template <typename... Values>
+    T Lookup (Values... values) const {
+        return m_data[Index (values...)];
+    };
+
+    const T * GetData () const { return m_data; };
+
+private:
+    const T * m_data;
+};
+
+}; // namespace ns3
+
+#endif /* FEC_LUT_H */
@@ -57,11 +57,15 @@ bool FECPolicy::GetPacingFlag() {
     return this->pacing_flag;
 };
 
+int64_t FECPolicy::AssignStreams(int64_t stream) {
+    return 0;
+};
+
 
 FECPolicy::FECParam FECPolicy::GetFECParam(
     Ptr<NetStat> statistic, uint32_t bitrate,
     uint16_t ddl, uint16_t ddl_left,
-    bool is_rtx, uint8_t frame_size,
+    bool is_rtx, uint16_t frame_size,
     uint16_t max_group_size, bool fix_group_size
 ) {
     if(this->loss_fixed_flag) {
@@ -59,14 +59,20 @@ private:
      * @param bitrate Video encoding bitrate, in kbps
      * @param ddl Total ddl in ms
      * @param ddl_left DDL left in ms
+     * @param frame_size Number of data packets in the frame
      * @param max_group_size Max group size
      * @param fix_group_size flag for whether the group size can be smaller than max_group_size
      * @return FECParam FEC group size and FEC rate
+     *
+     * Policies whose tables cover a limited frame or group size return a group
+     * size within that range for larger frames (HairpinPolicy tiles the frame,
+     * the WebRTC policies cap the group at 48 packets); GameServer then splits
+     * the frame into groups of about that size.
      */
     virtual FECParam GetPolicyFECParam(
         Ptr<NetStat> statistic, uint32_t bitrate,
         uint16_t ddl, uint16_t ddl_left,
-        bool is_rtx, uint8_t frame_size,
+        bool is_rtx, uint16_t frame_size,
         uint16_t max_group_size, bool fix_group_size
     )=0;
 public:
@@ -74,6 +80,13 @@ public:
     void SetMaxFECRate(double_t max_fec_rate);
     void SetFixedLoss(double_t loss_rate);
     bool GetPacingFlag();
+    /**
+     * @brief Use fixed random streams for the randomized policies
+     *
+     * @param stream first stream index
+     * @return number of streams used
+     */
+    virtual int64_t AssignStreams(int64_t stream);
 
     /**
      * @brief Unified interface to call GetPolicyFECParam
@@ -91,7 +104,7 @@ public:
     FECParam GetFECParam(
         Ptr<NetStat> statistic, uint32_t bitrate,
         uint16_t ddl, uint16_t ddl_left,
-        bool is_rtx, uint8_t frame_size,
+        bool is_rtx, uint16_t frame_size,
         uint16_t max_group_size, bool fix_group_size
     );
     virtual std::string GetFecName (void) = 0;
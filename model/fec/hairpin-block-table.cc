@@ -0,0 +1,123 @@
+#include "hairpin-block-table.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include <cstring>
+#include <map>
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("HairpinBlockTable");
+
+const char HairpinBlockTable::k_magic[8] = {'S', 'R', 'T', 'C', 'H', 'B', 'T', '1'};
+
+TypeId HairpinBlockTable::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::HairpinBlockTable")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<HairpinBlockTable> ()
+    ;
+    return tid;
+};
+
+HairpinBlockTable::HairpinBlockTable ()
+: m_table {NULL}
+, m_header {}
+, m_planeIds {nullptr}
+, m_rowIds {nullptr}
+, m_rows {nullptr}
+{};
+
+HairpinBlockTable::HairpinBlockTable (Ptr<HairpinTable> table)
+: m_table {table}
+, m_header {}
+, m_planeIds {nullptr}
+, m_rowIds {nullptr}
+, m_rows {nullptr}
+{
+    const uint8_t * data = table->GetData ();
+    if (table->GetSize () < sizeof (Header) || memcmp (data, k_magic, sizeof (k_magic)) != 0)
+        NS_FATAL_ERROR ("Not a compressed Hairpin block table");
+    memcpy (&m_header, data, sizeof (Header));
+    size_t len = sizeof (Header)
+        + sizeof (uint16_t) * ((size_t) m_header.outerCnt + (size_t) m_header.planeCnt * m_header.rttCnt)
+        + (size_t) m_header.rowCnt * m_header.rdispCnt;
+    if (table->GetSize () != len)
+        NS_FATAL_ERROR ("Compressed Hairpin block table has " << table->GetSize () << " bytes instead of " << len);
+    m_planeIds = (const uint16_t *) (data + sizeof (Header));
+    m_rowIds = m_planeIds + m_header.outerCnt;
+    m_rows = (const uint8_t *) (m_rowIds + (size_t) m_header.planeCnt * m_header.rttCnt);
+    NS_LOG_INFO ("[HairpinBlockTable] " << m_header.planeCnt << " planes, " << m_header.rowCnt << " rows, "
+        << len << " bytes for " << (size_t) m_header.outerCnt * m_header.rttCnt * m_header.rdispCnt << " entries");
+};
+
+HairpinBlockTable::~HairpinBlockTable () {};
+
+uint8_t HairpinBlockTable::Lookup (uint32_t outer, uint32_t rtt, uint32_t rdisp) const {
+    NS_ASSERT (outer < m_header.outerCnt && rtt < m_header.rttCnt && rdisp < m_header.rdispCnt);
+    uint16_t plane = m_planeIds[outer];
+    uint16_t row = m_rowIds[(size_t) plane * m_header.rttCnt + rtt];
+    return m_rows[(size_t) row * m_header.rdispCnt + rdisp];
+};
+
+uint32_t HairpinBlockTable::GetOuterCnt () const {
+    return m_header.outerCnt;
+};
+
+uint32_t HairpinBlockTable::GetRttCnt () const {
+    return m_header.rttCnt;
+};
+
+uint32_t HairpinBlockTable::GetRdispCnt () const {
+    return m_header.rdispCnt;
+};
+
+std::vector<uint8_t> HairpinBlockTable::Compress (const std::vector<uint8_t> & raw,
+        uint32_t outerCnt, uint32_t rttCnt, uint32_t rdispCnt) {
+    NS_ASSERT_MSG (raw.size () == (size_t) outerCnt * rttCnt * rdispCnt, "Table does not match its dimensions");
+    std::map<std::vector<uint8_t>, uint16_t> rowDict;
+    std::map<std::vector<uint16_t>, uint16_t> planeDict;
+    std::vector<uint16_t> planeIds, rowIds;
+    std::vector<uint8_t> rows;
+
+    for (uint32_t outer = 0; outer < outerCnt; outer++) {
+        std::vector<uint16_t> plane;
+        for (uint32_t rtt = 0; rtt < rttCnt; rtt++) {
+            auto begin = raw.begin () + ((size_t) outer * rttCnt + rtt) * rdispCnt;
+            std::vector<uint8_t> row (begin, begin + rdispCnt);
+            auto it = rowDict.find (row);
+            if (it == rowDict.end ()) {
+                if (rowDict.size () > UINT16_MAX)
+                    NS_FATAL_ERROR ("Block table has too many distinct rows to compress");
+                it = rowDict.emplace (row, rowDict.size ()).first;
+                rows.insert (rows.end (), row.begin (), row.end ());
+            }
+            plane.push_back (it->second);
+        }
+        auto it = planeDict.find (plane);
+        if (it == planeDict.end ()) {
+            if (planeDict.size () > UINT16_MAX)
+                NS_FATAL_ERROR ("Block table has too many distinct planes to compress");
+            it = planeDict.emplace (plane, planeDict.size ()).first;
+            rowIds.insert (rowIds.end (), plane.begin (), plane.end ());
+        }
+        planeIds.push_back (it->second);
+    }
+
+    Header header;
+    memcpy (header.magic, k_magic, sizeof (k_magic));
+    header.outerCnt = outerCnt;
+    header.rttCnt = rttCnt;
+    header.rdispCnt = rdispCnt;
+    header.planeCnt = planeDict.size ();
+    header.rowCnt = rowDict.size ();
+    header.reserved = 0;
+
+    std::vector<uint8_t> out (sizeof (Header));
+    memcpy (out.data (), &header, sizeof (Header));
+    out.insert (out.end (), (const uint8_t *) planeIds.data (), (const uint8_t *) (planeIds.data () + planeIds.size ()));
+    out.insert (out.end (), (const uint8_t *) rowIds.data (), (const uint8_t *) (rowIds.data () + rowIds.size ()));
+    out.insert (out.end (), rows.begin (), rows.end ());
+    return out;
+};
+
+}; // namespace ns3
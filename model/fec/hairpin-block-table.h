@@ -0,0 +1,65 @@
+#ifndef HAIRPIN_BLOCK_TABLE_H
+#define HAIRPIN_BLOCK_TABLE_H
+
+#include "ns3/common-header.h"
+#include "hairpin-table.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Compressed Hairpin block-size table, decoded in place from its
+ * HairpinTable mapping.
+ *
+ * The block table is indexed [outer][rtt][rdisp], with outer the
+ * (loss, frame, ddl) cell. Block sizes change little along rdisp and rtt, so
+ * the table is stored as two dictionaries: the distinct rdisp rows, and the
+ * distinct (rtt x rdisp) planes as lists of row ids. A lookup reads the plane
+ * of the cell, the row of the rtt and the entry of the rdisp: three loads,
+ * touching only the mapped pages it needs.
+ */
+class HairpinBlockTable : public Object {
+public:
+    static TypeId GetTypeId (void);
+    HairpinBlockTable ();
+    HairpinBlockTable (Ptr<HairpinTable> table);
+    ~HairpinBlockTable ();
+
+    uint8_t Lookup (uint32_t outer, uint32_t rtt, uint32_t rdisp) const;
+
+    uint32_t GetOuterCnt () const;
+    uint32_t GetRttCnt () const;
+    uint32_t GetRdispCnt () const;
+
+    /**
+     * \brief Compress a raw [outer][rtt][rdisp] table into the mapped layout
+     */
+    static std::vector<uint8_t> Compress (const std::vector<uint8_t> & raw,
+        uint32_t outerCnt, uint32_t rttCnt, uint32_t rdispCnt);
+
+    /* Layout: header, then uint16 plane ids [outerCnt], uint16 row ids
+       [planeCnt][rttCnt] and uint8 block sizes [rowCnt][rdispCnt] */
+    static const char k_magic[8];
+    struct Header {
+        char magic[8];
+        uint32_t outerCnt;
+        uint32_t rttCnt;
+        uint32_t rdispCnt;
+        uint32_t planeCnt;
+        uint32_t rowCnt;
+        uint32_t reserved;
+    };
+
+private:
+    Ptr<HairpinTable> m_table;
+    Header m_header;
+    const uint16_t * m_planeIds;
+    const uint16_t * m_rowIds;
+    const uint8_t * m_rows;
+};  // class HairpinBlockTable
+
+};  // namespace ns3
+
+#endif  /* HAIRPIN_BLOCK_TABLE_H */
@@ -1,45 +1,50 @@
 #include "hairpin-policy.h"
-#include <fstream>
+#include <utility>
 
 namespace ns3 {
 NS_LOG_COMPONENT_DEFINE("Hairpin");
 
+/* whether an axis read from a .dims file is the compile-time axis LutAxis */
+template <typename LutAxis>
+static bool MatchesAxis (const HairpinTable::Axis & axis) {
+    return axis.count == LutAxis::k_count
+        && std::fabs (axis.start - LutAxis::k_start) < 1e-9
+        && std::fabs (axis.step - LutAxis::k_step) < 1e-9;
+}
+
+template <typename Lut, size_t... I>
+static bool MatchesAxes (const std::vector<HairpinTable::Axis> & axes, std::index_sequence<I...>) {
+    return axes.size () == Lut::k_dims && (MatchesAxis<typename Lut::template Axis<I>> (axes[I]) && ...);
+}
+
 /* class HairpinPolicy */
 const std::vector<uint8_t> HairpinPolicy::group_size_list = {5, 15, 20, 25, 30, 35, 40, 45, 50, 55};
 
 HairpinPolicy::HairpinPolicy (uint16_t delayDdl, double_t qoeCoeff, bool isRtx, bool isCap)
 : FECPolicy(MilliSeconds(1)) 
-, k_betaArraySize {462825}
-, k_blockArraySize {7209972}
-, k_paramDir {"./src/sparkrtc/model/fec/"} 
+, m_betaTable {NULL}
+, m_blockTable {NULL}
+, m_betaLut {}
+, m_isRtx {isRtx}
+, m_isCap {isCap}
 , m_isBlockSizeOpt {false} {
     k_qoeCoeff = qoeCoeff;
     k_delayDdl = delayDdl;
     this->pacing_flag = false;
 
-    char buf[100];
-    snprintf (buf, sizeof (buf), "array-rtx%d-cap%d-coeff%.0e", isRtx, isCap, k_qoeCoeff);
-    std::string dataConf = buf;
-    m_betaArray = new uint8_t[k_betaArraySize];
-    std::ifstream betaIo (k_paramDir + "beta-" + dataConf + ".bin", std::ifstream::binary);
-    if (betaIo.fail ())
-        NS_FATAL_ERROR ("Cannot open " + k_paramDir + "beta-" + dataConf + ".bin");
-    betaIo.seekg (0, std::ios::beg);
-    betaIo.read ((char *) m_betaArray, sizeof (uint8_t) * k_betaArraySize);
-    betaIo.close ();
-    NS_LOG_INFO ("Read beta array from " + k_paramDir + "beta-" + dataConf + ".bin");
-    if (m_isBlockSizeOpt) {
-        m_blockArray = new uint8_t[k_blockArraySize];
-        std::ifstream blockIo (k_paramDir + "block-" + dataConf + ".bin", std::ifstream::binary);
-        NS_ASSERT (!blockIo.fail ());
-        blockIo.seekg (0, std::ios::beg);
-        blockIo.read ((char *) m_blockArray, sizeof (uint8_t) * k_blockArraySize);
-        blockIo.close ();
-        NS_LOG_INFO ("Read block array from " + k_paramDir + "block-" + dataConf + ".bin");
-    }
+    m_betaTable = HairpinTable::Get ("beta", isRtx, isCap, k_qoeCoeff, BetaLut::k_size);
+    CheckAxes<BetaLut> (m_betaTable, "beta");
+    m_betaLut = BetaLut (m_betaTable->GetData ());
 };
 
-HairpinPolicy::HairpinPolicy() : FECPolicy(MilliSeconds(1)) {};
+HairpinPolicy::HairpinPolicy()
+: FECPolicy(MilliSeconds(1))
+, m_betaTable {NULL}
+, m_blockTable {NULL}
+, m_betaLut {}
+, m_isRtx {false}
+, m_isCap {false}
+, m_isBlockSizeOpt {false} {};
 HairpinPolicy::~HairpinPolicy() {};
 
 TypeId HairpinPolicy::GetTypeId() {
@@ -51,87 +56,72 @@ TypeId HairpinPolicy::GetTypeId() {
     return tid;
 };
 
-uint8_t HairpinPolicy::GetFecCnt (double_t loss, uint8_t frameSize, uint16_t remainingTime, uint16_t rtt, uint8_t packet) {
-        // loss_index = round((loss - start) / interval)
-    loss = (loss < 0.00) ? 0.00 : ((loss > 0.50) ? 0.50 : loss);
-    uint8_t loss_index = (uint8_t) round((loss - 0.00) / 0.01);
-
-    // frame_size_index = ceil((frame_size - start) / interval)
-    frameSize = (frameSize < 5) ? 5 : ((frameSize > 55) ? 55 : frameSize);
-    uint8_t frame_size_index = (uint8_t) ceil(((double_t) frameSize - 5) / 5);
-
-    // compute the remaining layer
-    uint8_t layer = (uint8_t) (remainingTime / rtt);
-    layer = (layer < 1) ? 1 : ((layer > 15) ? 15 : layer);
-    uint8_t layer_index = (uint8_t) round(((double_t) layer - 1) / 1);
-
-    // For hairpinone baseline
-    if (k_delayDdl == 0)
-        layer_index = 0;
-
-    // packet_index = round((packet - start) / interval)
-    packet = (packet < 1) ? 1 : ((packet > 55) ? 55 : packet);
-    uint8_t packet_index = (uint8_t) round(((double_t) packet - 1) / 1);
-
-    /* array index */
-    uint64_t index =
-        loss_index * 9075
-        + frame_size_index * 825
-        + layer_index * 55
-        + packet_index;
-
-    /* assignment */
-    return m_betaArray[index];
+template <typename Lut>
+void HairpinPolicy::CheckAxes (Ptr<HairpinTable> table, std::string name) {
+    /* tables without a .dims file are only checked by their size */
+    if (!table->GetAxes ().empty ()
+        && !MatchesAxes<Lut> (table->GetAxes (), std::make_index_sequence<Lut::k_dims> ()))
+        NS_FATAL_ERROR ("The " + name + " table was solved on another grid than HairpinPolicy indexes, see its .dims file");
 }
 
-uint8_t HairpinPolicy::GetBlockSize (double_t loss, uint8_t frame_size, uint16_t ddl, uint16_t rtt, double_t rdisp) {
-    // loss_index = round((loss - start) / interval)
-    loss = (loss < 0.00) ? 0.00 : ((loss > 0.50) ? 0.50 : loss);
-    uint8_t loss_index = (uint8_t) round((loss - 0.00) / 0.01);
-
-    // frame_size_index = ceil((frame_size - start) / interval)
-    frame_size = (frame_size < 5) ? 5 : ((frame_size > 55) ? 55 : frame_size);
-    uint8_t frame_size_index = (uint8_t) ceil(((double_t) frame_size - 5) / 5);
-
-    // ddl_index = round((ddl - start) / interval)
-    ddl = (ddl < 20) ? 20 : ((ddl > 140) ? 140 : ddl);
-    uint8_t ddl_index = (uint8_t) round(((double_t) ddl - 20) / 20);
-
-    // rtt_index = round((rtt - start) / interval)
-    rtt = (rtt < 10) ? 10 : ((rtt > 80) ? 80 : rtt);
-    uint8_t rtt_index = (uint8_t) round(((double_t) rtt - 10) / 2);
-
-    // rdisp_index = round((rdisp - start) / interval)
-    rdisp = (rdisp < 0.00) ? 0.00 : ((rdisp > 1.00) ? 1.00 : rdisp);
-    uint8_t rdisp_index = (uint8_t) round((rdisp - 0.00) / 0.02);
-
-    /* array index */
-    uint64_t index =
-        loss_index * 141372
-        + frame_size_index * 12852
-        + ddl_index * 1836
-        + rtt_index * 51
-        + rdisp_index;
-    /* assignment */
-    return m_blockArray[index];
+uint8_t HairpinPolicy::GetFecCnt (double_t loss, uint16_t frameSize, uint16_t remainingTime, uint16_t rtt, uint16_t packet) {
+    // compute the remaining layer, the hairpinone baseline always has one
+    uint16_t layer = k_delayDdl == 0 ? 1 : remainingTime / rtt;
+    return m_betaLut.Lookup (loss, frameSize, layer, packet);
+}
+
+bool HairpinPolicy::LoadBlockTable () {
+    if (m_blockTable != NULL)
+        return true;
+    Ptr<HairpinTable> table = HairpinTable::Find ("blockz", m_isRtx, m_isCap, k_qoeCoeff, 0);
+    if (table == NULL) {
+        NS_LOG_WARN ("[Hairpin] no block table " << HairpinTable::GetFileName ("blockz", m_isRtx, m_isCap, k_qoeCoeff)
+            << ", block size optimization is off");
+        m_isBlockSizeOpt = false;
+        return false;
+    }
+    CheckAxes<BlockLut> (table, "block");
+    m_blockTable = CreateObject<HairpinBlockTable> (table);
+    NS_ASSERT_MSG (m_blockTable->GetOuterCnt () == BlockOuterLut::k_size
+        && m_blockTable->GetRttCnt () == BlockRttAxis::k_count
+        && m_blockTable->GetRdispCnt () == BlockRdispAxis::k_count,
+        "Block table does not match the GetBlockSize grid");
+    return true;
+}
+
+uint8_t HairpinPolicy::GetBlockSize (double_t loss, uint16_t frame_size, uint16_t ddl, uint16_t rtt, double_t rdisp) {
+    /* [loss][frame_size][ddl] cell, then rtt and rdisp */
+    return m_blockTable->Lookup (BlockOuterLut::Index (loss, frame_size, ddl),
+        BlockRttAxis::Index (rtt), BlockRdispAxis::Index (rdisp));
 }
 
 FECPolicy::FECParam HairpinPolicy::GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize
 ) {
     uint8_t fecCount = 0;
-    uint8_t blockSize = maxGroupSize;
+    uint16_t blockSize = maxGroupSize;
+
+    if (frameSize > MAX_TABLE_FRAME_SIZE) {
+        // tile the frame into groups within the table range
+        uint16_t tileCnt = (frameSize + MAX_TABLE_FRAME_SIZE - 1) / MAX_TABLE_FRAME_SIZE;
+        uint16_t tileSize = (frameSize + tileCnt - 1) / tileCnt;
+        if (maxGroupSize == frameSize)
+            maxGroupSize = tileSize;
+        frameSize = tileSize;
+        blockSize = MIN (blockSize, tileSize);
+    }
 
     if (m_isRtx || !isRtx) {
         // Block size optimization
         // rtt = srtt + 1 * std
         uint16_t rtt = (uint16_t) ceil ((statistic->srtt + 1 * statistic->rttSd).GetMilliSeconds ());
         ddlLeft = std::max (0, int (ddlLeft) - int (rtt));
-        if (m_isBlockSizeOpt && (!fixGroupSize && frameSize == maxGroupSize)) {
+        if (m_isBlockSizeOpt && (!fixGroupSize && frameSize == maxGroupSize) && LoadBlockTable ()) {
             // group size is not fixed
-            blockSize = GetBlockSize (statistic->curLossRate, frameSize,
-                ddl, rtt, statistic->oneWayDispersion.GetMicroSeconds () / 1e3);
+            // the table rounds the frame size up to its grid, the block may not be larger than the frame
+            blockSize = MIN ((uint16_t) GetBlockSize (statistic->curLossRate, frameSize,
+                ddl, rtt, statistic->oneWayDispersion.GetMicroSeconds () / 1e3), frameSize);
         }
         fecCount = GetFecCnt (statistic->curLossRate, frameSize, ddlLeft, rtt, blockSize);
         NS_ASSERT (fecCount < 255);
@@ -144,4 +134,8 @@ std::string HairpinPolicy::GetFecName (void) {
     return "HairpinPolicy";
 }
 
+void HairpinPolicy::SetBlockSizeOpt (bool enable) {
+    m_isBlockSizeOpt = enable;
+}
+
 }; // namespace ns3
\ No newline at end of file
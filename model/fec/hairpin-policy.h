@@ -3,6 +3,9 @@
 
 #include "ns3/common-header.h"
 #include "fec-policy.h"
+#include "hairpin-table.h"
+#include "hairpin-block-table.h"
+#include "fec-lut.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include <vector>
@@ -21,28 +24,59 @@ private:
     uint8_t k_qoeCoeffPow;
     double_t k_qoeCoeff;
     static const int GROUP_SIZE_ITVL = 5;
-    int k_betaArraySize;
-    int k_blockArraySize;
-    std::string k_paramDir;
+    static const uint16_t MAX_TABLE_FRAME_SIZE = 55;   /* largest frame and block size in the tables */
 
-    
-    uint8_t *m_betaArray;
-    uint8_t *m_blockArray;
+    typedef FecLutAxis<0, 1, 51, FecLutRound::NEAREST, 100> LossAxis;
+    typedef FecLutAxis<5, 5, 11, FecLutRound::CEIL> FrameSizeAxis;
+    /* FEC packets, [loss][frame_size][layer][packet] */
+    typedef FecLut<uint8_t, LossAxis, FrameSizeAxis, FecLutAxis<1, 1, 15>, FecLutAxis<1, 1, 55>> BetaLut;
+    /* block sizes, [loss][frame_size][ddl] cells of [rtt][rdisp] in HairpinBlockTable */
+    typedef FecLut<uint8_t, LossAxis, FrameSizeAxis, FecLutAxis<20, 20, 7>> BlockOuterLut;
+    typedef FecLutAxis<10, 2, 36> BlockRttAxis;
+    typedef FecLutAxis<0, 2, 51, FecLutRound::NEAREST, 100> BlockRdispAxis;
+    /* the full grid of the block table, checked against its .dims file */
+    typedef FecLut<uint8_t, LossAxis, FrameSizeAxis, FecLutAxis<20, 20, 7>, BlockRttAxis, BlockRdispAxis> BlockLut;
+
+    /* tables shared with the other policies of the process, see HairpinTable */
+    Ptr<HairpinTable> m_betaTable;
+    Ptr<HairpinBlockTable> m_blockTable;    /* loaded on the first block size lookup */
+    BetaLut m_betaLut;
 
     bool m_isRtx;
     bool m_isCap;
     bool m_isBlockSizeOpt;
 private:
-    uint8_t GetFecCnt (double_t loss, uint8_t frameSize, uint16_t remainingTime, uint16_t rtt, uint8_t packet);
-    uint8_t GetBlockSize (double_t loss, uint8_t frame_size, uint16_t ddl, uint16_t rtt, double_t rdisp);
+    /**
+     * \brief Reject a table whose .dims file lists other axes than the grid of Lut
+     */
+    template <typename Lut>
+    static void CheckAxes (Ptr<HairpinTable> table, std::string name);
+    uint8_t GetFecCnt (double_t loss, uint16_t frameSize, uint16_t remainingTime, uint16_t rtt, uint16_t packet);
+    /**
+     * \brief Map the block table, or turn the block size optimization off if
+     * there is none for the rtx and cap setting of the policy
+     */
+    bool LoadBlockTable ();
+    uint8_t GetBlockSize (double_t loss, uint16_t frame_size, uint16_t ddl, uint16_t rtt, double_t rdisp);
 public:
+    /**
+     * Frames larger than MAX_TABLE_FRAME_SIZE packets are tiled: they are split
+     * into the fewest equal tiles within the table range, each protected as a
+     * frame of its own, and the returned group size is the tile size.
+     */
     FECParam GetPolicyFECParam(
         Ptr<NetStat> statistic, uint32_t bitrate,
         uint16_t ddl, uint16_t ddl_left,
-        bool is_rtx, uint8_t frame_size,
+        bool is_rtx, uint16_t frame_size,
         uint16_t max_group_size, bool fix_group_size
     );
     std::string GetFecName (void);
+
+    /**
+     * \brief Choose the FEC block size from the compressed block table
+     * ("blockz") instead of using the largest allowed group
+     */
+    void SetBlockSizeOpt (bool enable);
 };  // class HairpinPolicy
 
 }; // namespace ns3
@@ -0,0 +1,254 @@
+#include "hairpin-solver.h"
+#include "hairpin-table.h"
+#include "hairpin-block-table.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include <atomic>
+#include <fstream>
+#include <limits>
+#include <thread>
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("HairpinSolver");
+
+HairpinSolver::Config::Config ()
+: coeff {1e-7}
+, isRtx {true}
+, isCap {false}
+, maxFecRatio {5}
+, maxFecCnt {165}
+, loss {"loss", 0, 0.01, 51}
+, frame {"frame", 5, 5, 11}
+, layer {"layer", 1, 1, 15}
+, packet {"packet", 1, 1, 55}
+, ddl {"ddl", 20, 20, 7}
+, rtt {"rtt", 10, 2, 36}
+, rdisp {"rdisp", 0, 0.02, 51}
+, blockSizes {5, 15, 20, 25, 30, 35, 40, 45, 50, 55}
+, threads {0}
+{};
+
+HairpinSolver::HairpinSolver (const Config & config)
+: m_config {config}
+, m_maxPacket {0}
+, m_maxLayer {0}
+, m_candidates {}
+, m_beta {}
+, m_block {}
+{
+    const Config & c = m_config;
+    NS_ASSERT_MSG (c.loss.Last () <= 1 && c.loss.start >= 0, "Loss rates must be in [0, 1]");
+    NS_ASSERT_MSG (c.frame.start >= 1 && c.packet.start >= 1 && c.layer.start >= 1,
+        "Frame sizes, block sizes and layers start at 1");
+    NS_ASSERT_MSG (c.maxFecCnt < 255, "FEC counts are stored in 8 bits");
+    m_maxPacket = (uint16_t) round (c.packet.Last ());
+    for (uint16_t size : c.blockSizes)
+        m_maxPacket = MAX (m_maxPacket, size);
+    NS_ASSERT_MSG (m_maxPacket <= 255, "Block sizes are stored in 8 bits");
+    m_maxLayer = (uint16_t) round (c.layer.Last ());
+    m_maxLayer = MAX (m_maxLayer, (uint16_t) ceil ((c.ddl.Last () - c.rtt.start) / c.rtt.start));
+    m_candidates.resize (m_maxPacket + 1);
+    for (uint16_t n = 1; n <= m_maxPacket; n++)
+        m_candidates[n] = GetFecCandidates (n);
+};
+
+std::vector<uint16_t> HairpinSolver::GetFecCandidates (uint16_t n) const {
+    std::vector<uint16_t> candidates;
+    auto add = [this, &candidates] (double_t fec) {
+        /* nearbyint rounds half to even */
+        uint16_t beta = (uint16_t) std::nearbyint (fec);
+        if (beta <= m_config.maxFecCnt && (candidates.empty () || beta > candidates.back ()))
+            candidates.push_back (beta);
+    };
+    for (uint16_t i = 0; i * 0.05 < 1; i++)
+        add (n * (i * 0.05));
+    uint16_t maxRatio = m_config.isCap ? 1 : (uint16_t) floor (m_config.maxFecRatio);
+    for (uint16_t ratio = 1; ratio <= maxRatio; ratio++)
+        add (n * ratio);
+    return candidates;
+};
+
+void HairpinSolver::FillBinomial (double_t loss, uint32_t maxN, std::vector<double_t> & pmf) const {
+    uint32_t stride = maxN + 1;
+    pmf.assign (stride * stride, 0);
+    double_t logLoss = log (loss), logRecv = log (1 - loss);
+    for (uint32_t N = 0; N <= maxN; N++) {
+        double_t * row = &pmf[N * stride];
+        if (loss <= 0) {
+            row[N] = 1;
+            continue;
+        }
+        if (loss >= 1) {
+            row[0] = 1;
+            continue;
+        }
+        double_t logFactN = lgamma (N + 1.);
+        for (uint32_t r = 0; r <= N; r++)
+            row[r] = exp (logFactN - lgamma (r + 1.) - lgamma (N - r + 1.)
+                + r * logRecv + (N - r) * logLoss);
+    }
+};
+
+void HairpinSolver::SolveCell (uint32_t lossIdx, uint32_t frameIdx, Workspace & ws) {
+    const Config & c = m_config;
+    double_t loss = c.loss.At (lossIdx);
+    double_t frameSize = c.frame.At (frameIdx);
+    double_t price = c.coeff / frameSize;
+    uint32_t maxN = MAX ((uint32_t) m_maxPacket, (uint32_t) m_candidates[m_maxPacket].back ());
+    uint32_t stride = m_maxPacket + 1;
+
+    FillBinomial (loss, maxN, ws.pmf);
+    /* P(< d of N received), for the FEC packets of a block */
+    ws.cdf.assign ((maxN + 1) * stride, 0);
+    for (uint32_t N = 0; N <= maxN; N++) {
+        double_t sum = 0;
+        for (uint32_t d = 1; d <= m_maxPacket; d++) {
+            if (d - 1 <= N)
+                sum += ws.pmf[N * (maxN + 1) + d - 1];
+            ws.cdf[N * stride + d] = sum;
+        }
+    }
+    ws.cost.assign ((m_maxLayer + 1) * stride, 0);
+    ws.beta.assign ((m_maxLayer + 1) * stride, 0);
+    ws.next.resize (stride);
+    for (uint16_t n = 1; n <= m_maxPacket; n++)
+        ws.cost[n] = 1;     /* no round left: the frame misses its deadline */
+
+    for (uint16_t m = 1; m <= m_maxLayer; m++) {
+        /* without retransmissions the packets missing after this round are lost */
+        const double_t * after = &ws.cost[(c.isRtx ? m - 1 : 0) * stride];
+        for (uint16_t n = 1; n <= m_maxPacket; n++) {
+            /* d of the n data packets lost, i.e. n - d received */
+            double_t * __restrict next = ws.next.data ();
+            const double_t * lost = &ws.pmf[n * (maxN + 1)];
+            for (uint16_t d = 0; d <= n; d++)
+                next[d] = lost[n - d] * after[d];
+            double_t best = std::numeric_limits<double_t>::max ();
+            uint16_t bestBeta = 0;
+            for (uint16_t beta : m_candidates[n]) {
+                const double_t * __restrict fewer = &ws.cdf[beta * stride];
+                /* expected cost of the undecodable outcomes, the loop the compiler vectorizes */
+                double_t miss = 0;
+                for (uint16_t d = 1; d <= n; d++)
+                    miss += next[d] * fewer[d];
+                double_t cost = price * beta + miss;
+                if (cost < best) {
+                    best = cost;
+                    bestBeta = beta;
+                }
+            }
+            ws.cost[m * stride + n] = best;
+            ws.beta[m * stride + n] = bestBeta;
+        }
+    }
+
+    /* beta table: [loss][frame][layer][packet] */
+    for (uint32_t li = 0; li < c.layer.count; li++) {
+        uint16_t m = MIN ((uint16_t) round (c.layer.At (li)), m_maxLayer);
+        uint64_t base = ((uint64_t) (lossIdx * c.frame.count + frameIdx) * c.layer.count + li) * c.packet.count;
+        for (uint32_t pi = 0; pi < c.packet.count; pi++) {
+            uint16_t n = (uint16_t) round (c.packet.At (pi));
+            m_beta[base + pi] = ws.beta[m * stride + n];
+        }
+    }
+
+    /* block table: [loss][frame][ddl][rtt][rdisp] */
+    uint16_t frame = (uint16_t) round (frameSize);
+    for (uint32_t di = 0; di < c.ddl.count; di++) {
+        for (uint32_t ri = 0; ri < c.rtt.count; ri++) {
+            double_t ddl = c.ddl.At (di), rtt = c.rtt.At (ri);
+            uint64_t base = (((uint64_t) (lossIdx * c.frame.count + frameIdx) * c.ddl.count + di)
+                * c.rtt.count + ri) * c.rdisp.count;
+            for (uint32_t si = 0; si < c.rdisp.count; si++) {
+                double_t rdisp = c.rdisp.At (si);
+                double_t best = std::numeric_limits<double_t>::max ();
+                uint16_t bestSize = MIN (frame, m_maxPacket);
+                for (uint16_t candidate : c.blockSizes) {
+                    uint16_t size = MIN (candidate, frame);
+                    uint16_t blockCnt = (frame + size - 1) / size;
+                    uint16_t lastSize = frame - (blockCnt - 1) * size;
+                    /* the first packets of the block wait for the last one */
+                    double_t layers = floor ((ddl - rtt - size * rdisp) / rtt);
+                    uint16_t m = (uint16_t) MAX (1., MIN (layers, (double_t) m_maxLayer));
+                    double_t cost = (blockCnt - 1) * ws.cost[m * stride + size] + ws.cost[m * stride + lastSize];
+                    if (cost < best) {
+                        best = cost;
+                        bestSize = size;
+                    }
+                }
+                m_block[base + si] = bestSize;
+            }
+        }
+    }
+};
+
+void HairpinSolver::Solve () {
+    const Config & c = m_config;
+    m_beta.assign ((uint64_t) c.loss.count * c.frame.count * c.layer.count * c.packet.count, 0);
+    m_block.assign ((uint64_t) c.loss.count * c.frame.count * c.ddl.count * c.rtt.count * c.rdisp.count, 0);
+
+    uint32_t cellCnt = c.loss.count * c.frame.count;
+    uint32_t threadCnt = c.threads > 0 ? c.threads : MAX (1u, std::thread::hardware_concurrency ());
+    threadCnt = MIN (threadCnt, cellCnt);
+    std::atomic<uint32_t> nextCell {0};
+    auto worker = [this, &nextCell, cellCnt, &c] () {
+        Workspace ws;
+        for (uint32_t cell = nextCell++; cell < cellCnt; cell = nextCell++)
+            SolveCell (cell / c.frame.count, cell % c.frame.count, ws);
+    };
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < threadCnt; i++)
+        threads.emplace_back (worker);
+    for (auto & thread : threads)
+        thread.join ();
+    NS_LOG_INFO ("[HairpinSolver] " << cellCnt << " cells solved by " << threadCnt << " threads");
+};
+
+const std::vector<uint8_t> & HairpinSolver::GetBetaTable () const {
+    return m_beta;
+};
+
+const std::vector<uint8_t> & HairpinSolver::GetBlockTable () const {
+    return m_block;
+};
+
+void HairpinSolver::WriteDims (std::ostream & os, std::string table, const std::vector<Axis> & axes) const {
+    if (table == "blockz")
+        os << "# Hairpin block table, compressed by HairpinBlockTable along rtt and rdisp" << std::endl;
+    else
+        os << "# Hairpin " << table << " table, uint8 row-major, the last axis varying fastest" << std::endl;
+    os << "table " << table << std::endl;
+    os << "coeff " << m_config.coeff << std::endl;
+    os << "rtx " << m_config.isRtx << std::endl;
+    os << "cap " << m_config.isCap << std::endl;
+    for (auto & axis : axes)
+        os << "axis " << axis.name << " " << axis.start << " " << axis.step << " " << axis.count << std::endl;
+};
+
+bool HairpinSolver::Write (std::string dir, bool withBlock) const {
+    const Config & c = m_config;
+    if (!dir.empty () && dir.back () != '/')
+        dir += '/';
+    std::vector<std::string> tables = {"beta"};
+    if (withBlock)
+        tables.push_back ("blockz");
+    for (auto table : tables) {
+        const std::vector<uint8_t> & data = table == "beta" ? m_beta :
+            HairpinBlockTable::Compress (m_block, c.loss.count * c.frame.count * c.ddl.count, c.rtt.count, c.rdisp.count);
+        std::vector<Axis> axes = table == "beta" ?
+            std::vector<Axis> {c.loss, c.frame, c.layer, c.packet} :
+            std::vector<Axis> {c.loss, c.frame, c.ddl, c.rtt, c.rdisp};
+        std::string path = dir + HairpinTable::GetFileName (table, c.isRtx, c.isCap, c.coeff);
+        std::ofstream bin (path, std::ofstream::binary);
+        bin.write ((const char *) data.data (), data.size ());
+        std::ofstream dims (path.substr (0, path.size () - 4) + ".dims");
+        WriteDims (dims, table, axes);
+        if (bin.fail () || dims.fail ())
+            return false;
+        NS_LOG_INFO ("[HairpinSolver] wrote " << path << ", " << data.size () << " bytes");
+    }
+    return true;
+};
+
+}; // namespace ns3
@@ -0,0 +1,112 @@
+#ifndef HAIRPIN_SOLVER_H
+#define HAIRPIN_SOLVER_H
+
+#include "ns3/common-header.h"
+#include "hairpin-table.h"
+#include <cmath>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Offline solver of the Hairpin decision tables read by HairpinPolicy
+ * through HairpinTable.
+ *
+ * For a block of n data packets with m transmission rounds (layers) left
+ * before the deadline, the beta table gives the number of FEC packets that
+ * minimizes
+ *
+ *   J_m(n) = min_beta  coeff / F * beta
+ *                      + sum_{d <= n} P(d of n lost) * P(< d of beta received) * J_{m-1}(d)
+ *
+ * with J_0(n) = 1 for n > 0 (the block, hence the frame, misses the
+ * deadline), J_m(0) = 0 and F the frame size, so that coeff weighs the FEC
+ * bandwidth of a frame against its deadline miss. A block that cannot be
+ * decoded retransmits its d lost data packets in the next round, with new
+ * FEC packets; without retransmissions (isRtx false) it is lost.
+ *
+ * beta is searched among round(n * r) for the FEC ratios r = 0, 0.05, ...,
+ * 0.95 and the whole ratios up to maxFecRatio (1 with isCap), rounded half
+ * to even and at most maxFecCnt. This is the model of the shipped
+ * coeff=1e-7 table, which the solver reproduces entry for entry.
+ *
+ * The block table gives the block size of the candidate list that minimizes
+ * the sum of J over the blocks of a frame, where the last rounds are lost to
+ * the dispersion of the block: m = (ddl - rtt - size * rdisp) / rtt.
+ *
+ * The tables are row-major over their axes, the last axis varying fastest,
+ * the default axes are those hard-coded in HairpinPolicy::GetFecCnt and
+ * HairpinPolicy::GetBlockSize. Every (loss, frame) cell is solved by one
+ * dynamic program, the cells are spread over the threads.
+ */
+class HairpinSolver {
+public:
+    typedef HairpinTable::Axis Axis;
+
+    struct Config {
+        double_t coeff;
+        bool isRtx;
+        bool isCap;                 /* FEC packets at most the data packets of the block */
+        double_t maxFecRatio;       /* otherwise at most maxFecRatio x the data packets */
+        uint16_t maxFecCnt;         /* and at most maxFecCnt, < 255 */
+        Axis loss;
+        Axis frame;                 /* frame size, in packets */
+        Axis layer;
+        Axis packet;                /* block size, in packets */
+        Axis ddl;                   /* in ms */
+        Axis rtt;                   /* in ms */
+        Axis rdisp;                 /* dispersion per packet, in ms */
+        std::vector<uint16_t> blockSizes;   /* candidates of the block table */
+        uint32_t threads;           /* 0 for the hardware concurrency */
+        Config ();
+    };
+
+    HairpinSolver (const Config & config);
+
+    /**
+     * \brief Solve both tables
+     */
+    void Solve ();
+
+    const std::vector<uint8_t> & GetBetaTable () const;
+    const std::vector<uint8_t> & GetBlockTable () const;
+
+    /**
+     * \brief Write the beta table and the block table, compressed by
+     * HairpinBlockTable ("blockz"), as named by HairpinTable, each with a
+     * ".dims" text file describing its axes
+     *
+     * \return false if a file cannot be written
+     */
+    bool Write (std::string dir, bool withBlock) const;
+
+private:
+    /* buffers of a thread, reused across cells */
+    struct Workspace {
+        std::vector<double_t> pmf;      /* P(r of N received), row N at N * (maxN + 1) */
+        std::vector<double_t> cdf;      /* P(< d of N received), row N at N * (m_maxPacket + 1) */
+        std::vector<double_t> cost;     /* J_m(n) at m * (m_maxPacket + 1) + n */
+        std::vector<uint8_t> beta;      /* argmin of J_m(n), same layout */
+        std::vector<double_t> next;     /* P(d of n lost) * J_{m-1}(d) */
+    };
+
+    /* one (loss, frame) cell of both tables */
+    void SolveCell (uint32_t lossIdx, uint32_t frameIdx, Workspace & ws);
+    void FillBinomial (double_t loss, uint32_t maxN, std::vector<double_t> & pmf) const;
+    /* FEC counts searched for a block of n data packets, increasing */
+    std::vector<uint16_t> GetFecCandidates (uint16_t n) const;
+    void WriteDims (std::ostream & os, std::string table, const std::vector<Axis> & axes) const;
+
+    Config m_config;
+    uint16_t m_maxPacket;
+    uint16_t m_maxLayer;
+    std::vector<std::vector<uint16_t>> m_candidates;    /* GetFecCandidates (n) at n */
+    std::vector<uint8_t> m_beta;
+    std::vector<uint8_t> m_block;
+};  // class HairpinSolver
+
+};  // namespace ns3
+
+#endif  /* HAIRPIN_SOLVER_H */
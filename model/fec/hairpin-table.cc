@@ -0,0 +1,147 @@
+#include "hairpin-table.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("HairpinTable");
+
+std::map<std::string, Ptr<HairpinTable>> HairpinTable::s_tables;
+std::vector<std::string> HairpinTable::s_searchPath = {
+    "./src/sparkrtc/model/fec/",
+    "./contrib/sparkrtc/model/fec/",
+};
+
+TypeId HairpinTable::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::HairpinTable")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<HairpinTable> ()
+    ;
+    return tid;
+};
+
+HairpinTable::HairpinTable ()
+: m_data {nullptr}
+, m_size {0}
+, m_map {nullptr}
+, m_mapLen {0}
+, m_axes {}
+{};
+
+HairpinTable::~HairpinTable () {
+    if (m_map != nullptr)
+        munmap (m_map, m_mapLen);
+};
+
+std::string HairpinTable::GetFileName (std::string kind, bool isRtx, bool isCap, double_t coeff) {
+    char buf[100];
+    snprintf (buf, sizeof (buf), "-array-rtx%d-cap%d-coeff%g.bin", isRtx, isCap, coeff);
+    return kind + buf;
+};
+
+Ptr<HairpinTable> HairpinTable::Get (std::string kind, bool isRtx, bool isCap, double_t coeff, size_t size) {
+    Ptr<HairpinTable> table = Find (kind, isRtx, isCap, coeff, size);
+    if (table == NULL) {
+        std::string dirs;
+        for (auto dir : s_searchPath)
+            dirs += " " + dir;
+        NS_FATAL_ERROR ("Cannot find " + GetFileName (kind, isRtx, isCap, coeff) + " in the search path:" + dirs);
+    }
+    return table;
+};
+
+Ptr<HairpinTable> HairpinTable::Find (std::string kind, bool isRtx, bool isCap, double_t coeff, size_t size) {
+    std::string name = GetFileName (kind, isRtx, isCap, coeff);
+    auto it = s_tables.find (name);
+    if (it != s_tables.end ()) {
+        NS_ASSERT_MSG (size == 0 || it->second->GetSize () == size, "Table " + name + " does not have the requested size");
+        return it->second;
+    }
+    Ptr<HairpinTable> table = CreateObject<HairpinTable> ();
+    if (!table->Load (name, size))
+        return NULL;
+    s_tables[name] = table;
+    return table;
+};
+
+void HairpinTable::SetSearchPath (const std::vector<std::string> & dirs) {
+    s_searchPath = dirs;
+};
+
+void HairpinTable::AddSearchPath (std::string dir) {
+    if (!dir.empty () && dir.back () != '/')
+        dir += '/';
+    s_searchPath.insert (s_searchPath.begin (), dir);
+};
+
+const std::vector<std::string> & HairpinTable::GetSearchPath () {
+    return s_searchPath;
+};
+
+bool HairpinTable::Load (std::string name, size_t size) {
+    for (auto dir : s_searchPath) {
+        std::string path = dir + name;
+        int fd = open (path.c_str (), O_RDONLY);
+        if (fd < 0)
+            continue;
+        struct stat st;
+        if (fstat (fd, &st) < 0 || st.st_size == 0 || (size > 0 && (size_t) st.st_size != size)) {
+            close (fd);
+            NS_FATAL_ERROR ("Hairpin table " + path + " has " + std::to_string (st.st_size)
+                + " entries instead of " + std::to_string (size));
+        }
+        void * addr = mmap (nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close (fd);
+        if (addr == MAP_FAILED)
+            NS_FATAL_ERROR ("Hairpin table fail to mmap! " + path);
+        m_map = addr;
+        m_mapLen = st.st_size;
+        m_data = (const uint8_t *) addr;
+        m_size = st.st_size;
+        NS_LOG_INFO ("[HairpinTable] mapped " << path << ", " << m_size << " entries");
+        LoadDims (path.substr (0, path.size () - 4) + ".dims");
+        return true;
+    }
+    return false;
+};
+
+void HairpinTable::LoadDims (std::string path) {
+    std::ifstream dims (path);
+    if (!dims.is_open ())
+        return;
+    std::string line;
+    while (std::getline (dims, line)) {
+        std::istringstream ss (line);
+        std::string field;
+        ss >> field;
+        if (field != "axis")
+            continue;
+        Axis axis;
+        ss >> axis.name >> axis.start >> axis.step >> axis.count;
+        if (ss.fail ())
+            NS_FATAL_ERROR ("Malformed axis in " + path + ": " + line);
+        m_axes.push_back (axis);
+    }
+};
+
+const uint8_t * HairpinTable::GetData () const {
+    return m_data;
+};
+
+size_t HairpinTable::GetSize () const {
+    return m_size;
+};
+
+const std::vector<HairpinTable::Axis> & HairpinTable::GetAxes () const {
+    return m_axes;
+};
+
+}; // namespace ns3
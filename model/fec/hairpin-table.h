@@ -0,0 +1,88 @@
+#ifndef HAIRPIN_TABLE_H
+#define HAIRPIN_TABLE_H
+
+#include "ns3/common-header.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Pre-solved Hairpin parameter table (beta or block size), memory-mapped
+ * read-only once and shared by all policies and flows in the process.
+ *
+ * Tables are keyed by (kind, rtx, cap, coeff) and looked up as
+ * "<kind>-array-rtx<rtx>-cap<cap>-coeff<coeff>.bin" in the directories of the
+ * search path, in order. The axes of a table are read from the ".dims" file
+ * next to it, if any. The mapping lives until the end of the process.
+ */
+class HairpinTable : public Object {
+public:
+    /* values start + i * step, i < count */
+    struct Axis {
+        std::string name;
+        double_t start;
+        double_t step;
+        uint32_t count;
+        double_t At (uint32_t i) const { return start + i * step; };
+        double_t Last () const { return At (count - 1); };
+    };
+
+    static TypeId GetTypeId (void);
+    HairpinTable ();
+    ~HairpinTable ();
+
+    /**
+     * \brief Get a table, mapping it on the first call
+     *
+     * \param kind "beta" or "blockz"
+     * \param size expected number of entries, the file must hold exactly as many;
+     * 0 for a table that describes its own size, checked by its reader
+     */
+    static Ptr<HairpinTable> Get (std::string kind, bool isRtx, bool isCap, double_t coeff, size_t size);
+
+    /**
+     * \brief Same as Get, but NULL if the table is not in the search path
+     */
+    static Ptr<HairpinTable> Find (std::string kind, bool isRtx, bool isCap, double_t coeff, size_t size);
+
+    /**
+     * \brief Directories searched for the tables, in order. The defaults are
+     * the module directory under src/ and contrib/ of the ns-3 tree.
+     */
+    static void SetSearchPath (const std::vector<std::string> & dirs);
+    static void AddSearchPath (std::string dir);
+    static const std::vector<std::string> & GetSearchPath ();
+
+    static std::string GetFileName (std::string kind, bool isRtx, bool isCap, double_t coeff);
+
+    const uint8_t * GetData () const;
+    size_t GetSize () const;
+
+    /**
+     * \brief Axes listed in the ".dims" file of the table, outermost first;
+     * empty if the table has none
+     */
+    const std::vector<Axis> & GetAxes () const;
+
+private:
+    bool Load (std::string name, size_t size);
+    void LoadDims (std::string path);
+
+    const uint8_t * m_data;
+    size_t m_size;
+    void * m_map;
+    size_t m_mapLen;
+    std::vector<Axis> m_axes;
+
+    /* keyed by file name: coefficients printed alike share the file */
+    static std::map<std::string, Ptr<HairpinTable>> s_tables;
+    static std::vector<std::string> s_searchPath;
+};  // class HairpinTable
+
+};  // namespace ns3
+
+#endif  /* HAIRPIN_TABLE_H */
@@ -25,7 +25,7 @@ TypeId FixedPolicy::GetTypeId() {
 
 FECPolicy::FECParam FixedPolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     if (!isRtx)
         return FECParam (maxGroupSize, k_rate);
     else
@@ -54,7 +54,7 @@ TypeId FixedRtxPolicy::GetTypeId() {
 
 FECPolicy::FECParam FixedRtxPolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     if (isRtx)
         return FECParam (maxGroupSize, k_rate);
     else
@@ -68,7 +68,9 @@ std::string FixedRtxPolicy::GetFecName (void) {
 /* class TokenRtxPolicy */
 TokenRtxPolicy::TokenRtxPolicy () : FixedPolicy (0)
 , k_token {0}
-, k_addRtx {false} {};
+, k_addRtx {false} {
+    m_addRtxRv = CreateObject<UniformRandomVariable> ();
+};
 
 TokenRtxPolicy::~TokenRtxPolicy () {};
 
@@ -83,10 +85,10 @@ TypeId TokenRtxPolicy::GetTypeId() {
 
 FECPolicy::FECParam TokenRtxPolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     if (!isRtx) {
         k_token = frameSize * statistic->curLossRate;
-        k_addRtx = bool (std::rand() % 2);
+        k_addRtx = m_addRtxRv->GetInteger (0, 1) == 1;
     }
     
     if (!isRtx)
@@ -110,6 +112,11 @@ FECPolicy::FECParam TokenRtxPolicy::GetPolicyFECParam (
     }
 };
 
+int64_t TokenRtxPolicy::AssignStreams (int64_t stream) {
+    m_addRtxRv->SetStream (stream);
+    return 1;
+};
+
 std::string TokenRtxPolicy::GetFecName (void) {
     return "TokenRtxPolicy";
 }
@@ -190,7 +197,7 @@ TypeId BolotPolicy::GetTypeId() {
 
 FECPolicy::FECParam BolotPolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     if (!isRtx) {
         double_t lossPb = statistic->curLossRate;
         double_t lossPa = lossPb / k_rewardList[m_lastComb];
@@ -252,7 +259,7 @@ TypeId UsfPolicy::GetTypeId() {
 
 FECPolicy::FECParam UsfPolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     if (!isRtx) {
         double_t lossPb = statistic->curLossRate;
         double_t lossPa = lossPb / k_rewardList[m_lastComb];
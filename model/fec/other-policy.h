@@ -5,6 +5,7 @@
 #include "fec-policy.h"
 #include "ns3/object.h"
 #include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
 #include <vector>
 #include "math.h"
 
@@ -21,7 +22,7 @@ protected:
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
     std::string GetFecName (void);
 };  // class FixedPolicy
 
@@ -34,7 +35,7 @@ public:
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
     std::string GetFecName (void);
 };  // class FixedRtxPolicy
 // This is a weird baseline required by the reviewers in NSDI'23 Fall.
@@ -49,10 +50,12 @@ public:
 private:
     uint16_t k_token;   // Total tokens for fec in the current round.
     bool k_addRtx;      // Tokens are going to added over init or rtx in the current round.
+    Ptr<UniformRandomVariable> m_addRtxRv;
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+    int64_t AssignStreams (int64_t stream);
     std::string GetFecName (void);
 };  // class TokenRtxPolicy
 
@@ -87,7 +90,7 @@ private:
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
     std::string GetFecName (void);
 };  // class BolotPolicy
 
@@ -107,7 +110,7 @@ private:
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
     std::string GetFecName (void);
 };  // class UsfPolicy
 
@@ -6,6 +6,109 @@
 #include "webrtc-fec-array.h"
 #include "webrtc-adjust-array.h"
 
+const uint8_t adjust_rtt_array_webrtc[WebRTCAdjustLut::k_size] = {
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+0,
+1,
+1,
+1,
+1,
+1,
+2,
+2,
+2,
+3,
+3,
+4,
+5,
+6,
+7,
+9,
+10,
+12,
+15,
+18,
+21,
+24,
+28,
+32,
+37,
+41,
+46,
+51,
+56,
+61,
+66,
+70,
+74,
+78,
+81,
+84,
+86,
+89,
+90,
+92,
+93,
+95,
+95,
+96,
+97,
+97,
+98,
+98,
+99,
+99,
+99,
+99,
+99,
+99,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+100,
+};
+
 
 // interface
 /**
@@ -19,5 +122,6 @@
  */
 void get_fec_rate_webrtc_rtt(double_t loss, uint8_t group_size, uint16_t rtt, uint16_t bitrate, double_t * fec_rate){
     get_fec_rate_webrtc(loss, group_size, bitrate, fec_rate);
-    *fec_rate = (*fec_rate) * (adjust_rtt_array_webrtc[rtt] / 100.0);
+    static const WebRTCAdjustLut lut (adjust_rtt_array_webrtc);
+    *fec_rate = (*fec_rate) * (lut.Lookup (rtt) / 100.0);
 };
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "stdlib.h"
 #include "stdint.h"
 #include "math.h"
+#include "fec-lut.h"
 
 
 // interface
@@ -27,107 +28,11 @@ void get_fec_rate_webrtc_rtt(double_t loss, uint8_t group_size, uint16_t rtt, ui
 // kHighRttNackMs (100), based on the HybridNackTH values defined in
 // media_opt_util.h.
 /* Copied from nack_fec_tables.h */
-static const uint8_t adjust_rtt_array_webrtc[100] = {
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-0,
-1,
-1,
-1,
-1,
-1,
-2,
-2,
-2,
-3,
-3,
-4,
-5,
-6,
-7,
-9,
-10,
-12,
-15,
-18,
-21,
-24,
-28,
-32,
-37,
-41,
-46,
-51,
-56,
-61,
-66,
-70,
-74,
-78,
-81,
-84,
-86,
-89,
-90,
-92,
-93,
-95,
-95,
-96,
-97,
-97,
-98,
-98,
-99,
-99,
-99,
-99,
-99,
-99,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-100,
-};
+typedef ns3::FecLut<uint8_t,
+    ns3::FecLutAxis<0, 1, 100>                                     /* rtt, larger RTTs use the last entry */
+> WebRTCAdjustLut;
+
+// defined once in webrtc-adjust-array.cc
+extern const uint8_t adjust_rtt_array_webrtc[WebRTCAdjustLut::k_size];
 
 #endif  // WEBRTC_ADJUST_ARRAY_H
@@ -1,4 +1,3 @@
-
 #ifndef WEBRTC_FEC_ARRAY_H
 #define WEBRTC_FEC_ARRAY_H
 
@@ -6,6 +5,7 @@
 #include "stdlib.h"
 #include "stdint.h"
 #include "math.h"
+#include "fec-lut.h"
 
 // interface
 /**
@@ -18,414 +18,14 @@
  */
 void get_fec_rate_webrtc(double_t loss, uint8_t group_size, uint16_t bitrate, double_t * fec_rate);
 
-// FEC array
-static const uint8_t fec_array_webrtc[16269] = {
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,3,3,3,3,3,3,3,3,3,3,3,3,
-3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
-4,4,4,4,4,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,6,6,6,6,6,
-6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,6,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,
-8,8,8,8,8,8,8,8,8,8,8,8,8,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
-9,9,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,11,11,11,11,11,11,11,11,11,
-11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,
-13,13,13,13,13,13,13,13,13,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,14,1,1,
-1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,2,2,1,1,1,1,1,1,1,1,1,1,3,3,3,3,3,3,3,3,3,3,3,3,3,
-3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,5,5,4,4,4,4,4,
-4,4,4,4,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,6,5,6,6,5,5,6,5,5,5,5,5,5,5,6,6,6,6,6,6,
-6,6,6,6,6,6,6,6,7,7,7,8,8,6,6,7,7,7,7,7,7,7,7,8,8,8,8,8,8,8,8,8,8,8,8,8,8,8,9,8,
-9,9,8,8,8,8,8,8,8,8,8,8,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,10,10,11,11,9,9,10,10,9,9,9,9,9,
-9,10,10,10,10,10,10,10,10,10,10,10,10,10,10,11,12,11,12,12,10,10,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,11,
-11,11,11,11,12,13,12,14,14,11,11,13,12,12,12,12,12,12,12,13,13,13,13,13,13,13,13,13,13,13,13,13,13,13,15,14,15,15,13,13,
-14,14,13,13,13,13,13,13,14,14,14,14,14,14,14,14,14,14,14,14,14,14,15,16,15,17,17,14,14,15,15,15,15,15,15,15,15,1,1,1,
-1,1,1,1,1,1,1,1,1,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,3,3,3,3,3,3,3,3,3,3,3,3,3,3,
-3,3,4,4,4,4,4,3,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,5,5,5,5,5,6,6,6,6,5,6,6,6,
-6,6,6,6,5,5,5,5,5,5,5,5,5,6,5,6,7,7,6,6,7,8,8,9,8,6,8,8,8,8,8,8,8,6,6,6,7,6,6,6,
-6,6,7,7,7,9,8,8,8,9,9,10,11,9,8,10,11,11,11,11,11,11,8,8,8,8,8,8,8,8,8,9,8,9,10,10,10,9,11,11,
-12,13,11,9,12,13,13,13,13,13,13,9,9,9,10,9,9,9,9,9,10,9,10,12,12,11,11,12,13,14,15,13,11,14,15,15,15,15,15,15,
-10,10,10,11,10,10,10,10,10,11,10,12,14,14,13,12,14,15,16,17,15,13,16,17,17,17,17,17,17,11,11,11,12,11,11,11,11,11,13,12,
-13,16,15,14,14,16,17,18,19,17,14,18,19,19,19,19,19,19,13,13,13,14,13,13,13,13,13,14,13,15,17,17,16,15,18,19,20,21,19,16,
-20,21,21,21,21,21,21,14,14,14,15,14,14,14,14,14,16,14,16,19,19,18,17,20,21,21,24,21,17,21,23,23,23,23,23,23,1,1,1,1,
-1,1,1,1,2,2,2,2,2,3,2,2,2,2,2,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,4,5,4,4,5,5,
-4,4,4,5,5,5,5,5,5,5,5,5,5,5,4,4,4,4,4,4,4,4,5,6,7,6,6,8,7,6,6,6,7,8,8,8,8,8,8,8,
-8,8,8,5,5,5,5,5,5,5,6,7,8,9,8,9,10,9,9,8,8,9,10,11,10,11,10,10,10,10,10,10,6,6,6,7,6,6,6,7,
-8,11,11,10,11,13,12,11,10,11,12,13,13,13,14,13,13,13,13,13,13,8,8,8,8,8,8,8,9,10,13,14,12,13,15,14,13,12,13,14,
-15,16,16,16,15,15,15,15,15,15,9,9,9,10,9,9,9,10,12,15,16,14,15,18,17,15,14,15,17,18,19,18,19,18,18,18,18,18,18,10,
-10,10,11,10,10,10,11,14,17,18,16,17,20,19,17,16,17,19,20,21,21,22,20,20,20,20,20,20,11,11,11,12,11,11,11,13,15,19,21,18,
-19,23,21,19,18,19,21,23,24,24,24,23,23,23,23,23,23,13,13,13,14,13,13,13,14,17,21,23,20,21,25,24,21,20,21,24,25,27,26,27,
-25,25,25,25,25,25,14,14,14,15,14,14,14,16,19,23,25,22,24,28,26,24,22,23,26,28,29,29,30,28,28,28,28,28,28,1,1,1,1,1,
-1,2,2,2,3,3,3,3,3,2,2,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,4,4,5,5,5,6,6,5,5,5,
-6,6,6,6,5,5,5,5,5,5,5,5,5,4,4,4,4,4,4,6,6,7,8,8,9,8,8,7,7,9,9,8,9,8,8,8,8,8,8,8,
-8,8,5,5,5,5,5,6,8,8,10,10,11,12,11,10,9,9,12,13,11,11,11,10,11,10,10,10,10,10,10,6,6,6,7,6,7,10,10,12,
-13,14,15,14,13,12,12,15,16,14,14,14,13,14,13,13,13,13,13,13,8,8,8,8,8,8,12,12,14,15,16,18,17,15,14,14,18,19,17,17,
-16,16,16,15,15,15,15,15,15,9,9,9,10,9,10,14,14,17,18,19,21,20,18,17,16,21,22,19,20,19,18,19,18,18,18,18,18,18,10,10,
-10,11,10,11,16,16,19,20,22,25,23,21,19,19,25,25,22,23,22,21,22,20,20,20,20,20,20,11,11,11,12,11,13,18,18,22,23,24,28,25,
-23,21,21,28,28,25,26,24,24,24,23,23,23,23,23,23,13,13,13,14,13,14,20,20,24,25,27,31,28,26,24,23,31,32,28,29,27,26,27,25,
-25,25,25,25,25,14,14,14,15,14,15,21,22,26,28,30,34,31,28,26,26,34,35,30,31,30,29,30,28,28,28,28,28,28,1,1,1,1,2,2,
-2,3,3,3,3,4,3,3,3,4,4,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,3,5,5,6,6,5,5,7,7,6,6,7,8,
-7,6,6,6,6,6,5,5,5,5,5,5,4,4,4,4,5,7,7,8,9,8,8,11,10,8,9,11,11,10,10,9,9,10,8,8,8,8,8,8,
-8,5,5,6,6,7,9,9,11,12,10,11,14,14,11,12,15,15,14,13,12,12,13,11,10,10,10,10,10,10,6,6,7,7,9,11,11,14,15,13,
-14,18,17,14,16,19,19,17,16,15,15,16,14,13,13,13,13,13,13,8,8,9,9,10,14,14,17,17,15,16,21,21,17,19,22,23,21,19,18,18,
-19,17,15,15,15,15,15,15,9,9,10,10,12,16,16,20,20,18,19,25,24,19,22,26,26,24,23,21,21,23,19,18,18,18,18,18,18,10,10,12,
-12,14,18,18,23,23,20,22,28,28,22,25,30,30,28,26,24,24,26,22,20,20,20,20,20,20,11,11,13,13,16,21,21,25,26,23,24,32,31,25,
-28,33,34,31,29,27,27,29,25,23,23,23,23,23,23,13,13,15,15,17,23,23,28,29,25,27,35,35,28,31,37,38,35,32,29,29,32,28,25,25,
-25,25,25,25,14,14,16,16,19,25,25,31,32,28,30,39,38,30,34,41,41,38,35,32,32,35,30,28,28,28,28,28,28,1,1,2,1,2,2,2,
-3,3,3,3,4,4,4,3,4,4,3,3,3,3,3,3,4,4,4,4,4,4,3,3,3,3,3,5,5,6,6,5,6,7,8,7,7,7,8,7,
-6,6,7,7,7,8,8,8,8,8,8,4,4,5,4,5,7,7,8,9,8,9,11,12,11,10,11,11,10,10,10,10,10,10,12,12,12,12,12,12,
-5,5,7,6,7,9,9,11,12,11,12,15,16,15,14,15,15,14,13,13,14,13,14,16,16,16,16,16,16,6,6,9,7,9,11,11,14,15,13,16,
-18,20,19,17,19,19,17,16,16,17,17,17,20,20,20,20,20,20,8,8,10,9,10,14,14,17,17,16,19,22,24,22,21,22,23,21,19,19,21,20,
-21,23,23,23,23,23,23,9,9,12,10,12,16,16,20,20,19,22,26,28,26,24,26,26,24,23,23,24,23,24,27,27,27,27,27,27,10,10,14,12,
-14,18,18,23,23,21,25,29,32,30,28,30,30,28,26,26,28,27,28,31,31,31,31,31,31,11,11,16,13,16,21,21,25,26,24,28,33,36,33,31,
-33,34,31,29,29,31,30,31,35,35,35,35,35,35,13,13,17,15,17,23,23,28,29,27,31,37,40,37,35,37,38,35,32,32,34,33,35,39,39,39,
-39,39,39,14,14,19,16,19,25,25,31,32,29,34,40,44,41,38,41,41,38,35,35,38,37,38,43,43,43,43,43,43,1,2,2,2,3,2,2,3,
-4,4,4,4,4,4,4,4,4,4,4,3,3,3,3,4,4,4,4,4,4,3,4,4,4,6,5,5,6,8,8,7,7,8,8,8,8,8,8,7,
-7,7,7,7,8,8,8,8,8,8,4,6,6,7,9,7,7,9,12,12,11,11,12,12,13,12,11,12,11,10,10,10,10,12,12,12,12,12,12,5,
-7,8,9,11,10,9,12,16,16,14,15,16,15,17,17,15,15,15,13,14,13,14,16,16,16,16,16,16,6,9,9,11,14,12,11,15,20,20,18,18,
-20,19,21,21,19,19,19,17,17,17,17,20,20,20,20,20,20,8,11,11,13,17,15,14,18,24,24,22,22,24,23,25,25,23,23,22,20,21,20,21,
-23,23,23,23,23,23,9,13,13,15,20,17,16,21,28,28,25,26,28,27,30,29,26,27,26,23,24,23,24,27,27,27,27,27,27,10,15,15,18,23,
-20,18,24,32,32,29,29,32,31,34,33,30,31,30,27,28,27,28,31,31,31,31,31,31,11,17,17,20,26,22,21,27,36,36,32,33,36,35,38,37,
-34,35,33,30,31,30,31,35,35,35,35,35,35,13,19,19,22,29,24,23,30,40,40,36,37,40,38,42,42,38,38,37,33,34,33,35,39,39,39,39,
-39,39,14,20,21,24,31,27,25,33,44,44,40,40,44,42,46,46,41,42,41,37,38,37,38,43,43,43,43,43,43,1,2,2,2,3,2,3,3,4,
-4,4,4,4,4,4,4,4,4,4,3,4,4,5,4,4,4,4,4,4,3,4,4,4,6,5,5,7,8,8,7,7,8,8,8,8,8,8,7,7,
-7,8,9,9,9,9,9,9,9,4,6,6,7,9,7,8,10,12,12,11,11,12,12,13,12,11,12,11,10,11,12,14,13,13,13,13,13,13,5,7,
-8,9,11,10,11,14,16,16,14,15,16,15,17,17,15,15,15,13,15,17,18,18,18,18,18,18,18,6,9,9,11,14,12,13,17,20,20,18,18,20,
-19,21,21,19,19,19,17,19,21,23,22,22,22,22,22,22,8,11,11,13,17,15,16,21,24,24,22,22,24,23,25,25,23,23,22,20,22,25,27,27,
-27,27,27,27,27,9,13,13,15,20,17,19,24,28,28,25,26,28,27,30,29,26,27,26,23,26,29,32,31,31,31,31,31,31,10,15,15,18,23,20,
-21,28,32,32,29,29,32,31,34,33,30,31,30,27,30,33,37,36,36,36,36,36,36,11,17,17,20,26,22,24,31,36,36,32,33,36,35,38,37,34,
-35,33,30,33,37,41,40,40,40,40,40,40,13,19,19,22,29,24,27,34,40,40,36,37,40,38,42,42,38,38,37,33,37,42,46,45,45,45,45,45,
-45,14,20,21,24,31,27,29,38,44,44,40,40,44,42,46,46,41,42,41,37,41,46,50,49,49,49,49,49,49,1,2,2,3,3,3,4,5,5,5,
-5,5,5,5,5,4,4,4,5,5,5,5,5,4,4,4,4,4,4,3,4,4,5,6,6,8,10,10,10,10,9,9,10,9,8,8,9,10,10,10,
-10,9,9,9,9,9,9,9,4,6,6,8,9,9,12,15,15,15,15,14,14,15,14,12,12,13,15,15,15,15,14,13,13,13,13,13,13,5,7,8,
-10,12,13,16,20,20,20,20,19,19,20,19,17,17,18,20,20,20,20,19,18,18,18,18,18,18,6,9,10,13,15,16,20,25,25,25,25,24,23,25,
-24,21,21,22,25,25,25,25,23,22,22,22,22,22,22,8,11,12,15,18,19,24,30,30,30,30,28,28,30,28,25,25,27,30,30,30,30,28,27,27,
-27,27,27,27,9,13,14,18,21,22,28,35,35,35,35,33,33,35,33,29,29,31,35,35,35,35,33,31,31,31,31,31,31,10,15,16,21,24,25,32,
-40,40,40,40,38,37,40,38,33,33,36,40,40,40,40,37,36,36,36,36,36,36,11,17,18,23,27,28,36,44,44,44,44,42,42,44,42,37,37,40,
-44,44,44,44,42,40,40,40,40,40,40,13,19,20,26,29,32,40,49,49,49,49,47,46,49,47,42,42,45,49,49,49,49,46,45,45,45,45,45,45,
-14,20,22,28,32,35,44,54,54,54,54,52,51,54,52,46,46,49,54,54,54,54,51,49,49,49,49,49,49,1,2,2,3,3,4,4,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,3,4,5,6,6,8,9,10,10,10,10,9,9,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,4,6,7,9,10,12,13,15,15,15,15,14,14,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,5,7,9,12,
-13,15,17,20,20,20,20,19,19,20,19,20,20,20,20,20,20,20,20,20,20,20,20,20,20,6,9,12,15,16,19,21,25,25,25,25,24,23,25,24,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,8,11,14,17,19,23,26,30,30,30,30,28,28,30,29,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,9,13,17,20,23,27,30,35,35,35,35,33,33,35,34,35,35,35,35,35,35,35,35,35,35,35,35,35,35,10,15,19,23,26,31,34,40,
-40,40,40,38,37,40,39,40,40,40,40,40,40,40,40,40,40,40,40,40,40,11,17,21,26,29,35,39,44,44,44,44,42,42,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,13,19,24,29,32,38,43,49,49,49,49,47,46,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,14,
-20,26,32,35,42,47,54,54,54,54,52,51,54,53,54,54,54,54,54,54,54,54,54,54,54,54,54,54,1,2,3,4,4,5,4,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,3,4,6,8,8,9,9,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,4,6,9,11,12,14,13,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,5,7,12,15,16,
-18,17,20,20,20,20,20,20,20,19,20,20,20,20,20,20,20,20,20,20,20,20,20,20,6,9,15,19,20,23,21,25,25,25,25,25,25,25,24,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,8,11,17,23,24,27,26,30,30,30,30,30,30,30,29,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,9,13,20,26,29,32,30,35,35,35,35,35,35,35,34,35,35,35,35,35,35,35,35,35,35,35,35,35,35,10,15,23,30,33,37,34,40,40,
-40,40,40,40,40,39,40,40,40,40,40,40,40,40,40,40,40,40,40,40,11,17,26,34,37,41,39,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,13,19,29,38,41,46,43,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,14,20,
-32,41,45,50,47,54,54,54,54,54,54,54,53,54,54,54,54,54,54,54,54,54,54,54,54,54,54,1,2,3,4,4,5,4,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,3,4,6,8,8,9,9,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,4,6,9,11,12,14,13,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,5,7,12,15,16,18,
-17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,7,9,15,19,20,23,21,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,8,11,17,23,24,27,26,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,10,13,20,26,29,32,30,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,11,15,23,30,33,37,34,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,12,17,26,34,37,41,39,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,14,19,29,38,41,46,43,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,15,20,32,
-41,45,50,47,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,1,2,3,4,4,5,4,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,3,4,6,8,8,9,9,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,4,6,9,11,12,14,13,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,5,7,12,15,16,18,17,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,7,9,15,19,20,23,21,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,8,11,17,23,24,27,26,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-10,13,20,26,29,32,30,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,11,15,23,30,33,37,34,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,12,17,26,34,37,41,39,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,14,19,29,38,41,46,43,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,15,20,32,41,
-45,50,47,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,1,2,3,4,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,3,4,6,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,4,6,9,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,5,7,12,17,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,7,9,15,21,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,8,11,17,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,10,
-13,20,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,11,15,23,33,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,12,17,26,37,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,14,19,29,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,15,20,32,46,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,2,2,3,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,4,4,6,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,6,7,9,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,7,9,12,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,9,11,15,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,11,13,17,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,13,16,
-20,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,15,18,23,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,17,20,26,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,19,22,29,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,20,24,32,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,2,2,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,4,5,7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,6,7,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,7,10,14,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,9,12,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,11,14,21,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,13,17,24,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,15,19,28,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,17,22,31,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,19,24,35,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,20,26,38,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,2,2,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,4,5,7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-6,7,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,7,10,14,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,9,12,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,11,14,21,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,13,17,24,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,15,19,28,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,17,22,31,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,19,24,35,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,20,26,38,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,2,3,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,4,6,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,6,
-9,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,8,12,16,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,10,15,20,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,12,17,24,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,14,20,28,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,17,23,32,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,19,26,36,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,21,29,40,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,23,32,44,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,2,4,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,7,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,7,11,
-13,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,9,14,17,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,11,18,21,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,14,21,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,16,25,30,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,18,28,34,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,21,32,38,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,23,35,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,25,39,46,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,2,4,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,7,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,7,11,13,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,9,14,17,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,11,18,21,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,14,21,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,16,25,30,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,18,28,34,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,21,32,38,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-23,35,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,25,39,46,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,6,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,9,12,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,12,16,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,15,20,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,18,24,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,21,29,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,25,33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,28,37,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,31,
-41,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,34,45,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,6,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,9,12,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,12,16,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,15,20,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,18,24,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,21,29,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,25,33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,28,37,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,31,41,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,34,45,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,6,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,9,14,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,12,19,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,15,24,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,18,29,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,21,33,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,25,38,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,28,43,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,31,48,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,34,53,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,5,6,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,9,14,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,12,19,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,20,15,24,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,
-18,29,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,21,33,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,25,38,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,40,28,43,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,31,48,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,34,53,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,5,7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,40,30,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,5,7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,40,30,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-5,7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,40,30,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
-7,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,40,30,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,40,30,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-40,30,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,
-30,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,30,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,30,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-20,17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,30,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,
-17,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,30,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,54,3,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,7,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,15,13,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,17,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,20,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,35,27,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,30,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,33,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,49,37,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,54,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,35,33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-54,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,35,33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,
-4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,35,33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,4,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,35,33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,4,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-35,33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,4,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,
-33,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,4,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,33,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,4,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,33,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,4,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-15,17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,33,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,4,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,8,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,12,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,
-17,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,21,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,30,29,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,33,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,37,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,44,42,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,49,46,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,6,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,16,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,19,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,26,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,29,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,44,32,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,49,35,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,6,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,16,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,19,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,26,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,29,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,44,32,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-49,35,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,3,5,5,5,5,5,5,5,5,5,
-5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,6,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,10,
-10,10,10,10,10,10,10,10,10,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,15,13,20,20,
-20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,16,25,25,25,25,25,25,25,25,25,25,25,25,25,
-25,25,25,25,25,25,25,25,25,25,25,25,25,25,25,19,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,30,
-30,30,30,30,23,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,35,26,40,40,40,40,40,40,
-40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,40,29,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,
-44,44,44,44,44,44,44,44,44,44,44,32,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,49,
-35,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54,54};
+// FEC packets of a group, [loss][group_size][bitrate]
+typedef ns3::FecLut<uint8_t,
+    ns3::FecLutAxis<0, 1, 51, ns3::FecLutRound::NEAREST, 100>,    /* loss */
+    ns3::FecLutAxis<5, 5, 11>,                                     /* group_size */
+    ns3::FecLutAxis<2, 1, 29>                                      /* bitrate */
+> WebRTCFecLut;
+
+// FEC array, defined once in webrtc-fec-array.cc
+extern const uint8_t fec_array_webrtc[WebRTCFecLut::k_size];
 
 #endif  // WEBRTC_FEC_ARRAY_H
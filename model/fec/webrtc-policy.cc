@@ -79,7 +79,7 @@ TypeId WebRTCPolicy::GetTypeId () {
 
 FECPolicy::FECParam WebRTCPolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     double_t fecRate = 0;
     if (!isRtx) {
         double_t loss = statistic->curLossRate;
@@ -114,7 +114,7 @@ TypeId WebRTCAdaptivePolicy::GetTypeId () {
 
 FECPolicy::FECParam WebRTCAdaptivePolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     double_t fecRate = 0;
     if (!isRtx) {
         double_t loss = statistic->curLossRate;
@@ -177,7 +177,7 @@ double_t WebRTCStarPolicy::SqrtFECRate (double_t beta, uint16_t ddl_left, uint16
 
 FECPolicy::FECParam WebRTCStarPolicy::GetPolicyFECParam (
     Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-    bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
+    bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize) {
     double_t fecRate;
     double_t loss = statistic->curLossRate;
     uint16_t rtt = statistic->curRtt.GetMilliSeconds ();
@@ -32,7 +32,7 @@ private:
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
     std::string GetFecName (void);
 };  // class WebRTCPolicy
 
@@ -46,7 +46,7 @@ private:
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
     std::string GetFecName (void);
 };  // class WebRTCAdaptivePolicy
 
@@ -66,7 +66,7 @@ private:
 public:
     FECParam GetPolicyFECParam (
         Ptr<NetStat> statistic, uint32_t bitrate, uint16_t ddl, uint16_t ddlLeft,
-        bool isRtx, uint8_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
+        bool isRtx, uint16_t frameSize, uint16_t maxGroupSize, bool fixGroupSize);
     std::string GetFecName (void);
     void SetOrder (int order);
 }; // class WebRTCStarPolicy
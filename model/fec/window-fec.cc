@@ -0,0 +1,231 @@
+#include "window-fec.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("WindowFec");
+
+NS_OBJECT_ENSURE_REGISTERED (WindowFecEncoder);
+NS_OBJECT_ENSURE_REGISTERED (WindowFecDecoder);
+
+/* class WindowFecEncoder */
+TypeId WindowFecEncoder::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::WindowFecEncoder")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+    ;
+    return tid;
+};
+
+WindowFecEncoder::WindowFecEncoder (uint16_t maxWindow, Time ddl, uint32_t maxHeader)
+: m_maxWindow {maxWindow}
+, m_ddl {ddl}
+, m_maxHeader {maxHeader}
+, m_window {}
+, m_credit {0}
+, m_nextRepairId {0}
+{
+    NS_ASSERT_MSG (maxWindow > 0, "The window must cover at least one packet");
+};
+
+WindowFecEncoder::~WindowFecEncoder () {};
+
+LinearFecDecoder::SourceId WindowFecEncoder::GetSourceId (uint32_t groupId, uint16_t pktIdInGroup) {
+    return ((LinearFecDecoder::SourceId) groupId << 16) | pktIdInGroup;
+};
+
+uint8_t WindowFecEncoder::GetCoefficient (uint32_t repairId, LinearFecDecoder::SourceId id) {
+    /* splitmix64 finalizer over both ids */
+    uint64_t x = id * 0x9e3779b97f4a7c15ULL ^ ((uint64_t) repairId << 1 | 1) * 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 31;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 29;
+    uint8_t c = x & 0xff;
+    return c == 0 ? 1 : c;
+};
+
+std::vector<Ptr<VideoPacket>> WindowFecEncoder::Protect (const std::vector<Ptr<DataPacket>> & pkts,
+    double_t rate, uint16_t maxRepair, Ptr<FecCodec> codec) {
+    std::vector<Ptr<VideoPacket>> out;
+    Time now = Simulator::Now ();
+    /* the receiver has no use for packets past their deadline */
+    while (!m_window.empty () && now - m_window.front ()->GetEncodeTime () > m_ddl)
+        m_window.pop_front ();
+
+    uint16_t repairCnt = 0;
+    for (auto pkt : pkts) {
+        out.push_back (pkt);
+        m_window.push_back (pkt);
+        if (m_window.size () > m_maxWindow)
+            m_window.pop_front ();
+        m_credit += rate;
+        bool frameEnd = pkt->GetPktIdFrame () + 1 == pkt->GetFramePktNum ();
+        while (m_credit >= 1 || (frameEnd && m_credit >= 0.5)) {
+            if (repairCnt == maxRepair) {
+                m_credit = 0;
+                break;
+            }
+            out.push_back (CreateRepair (codec));
+            repairCnt ++;
+            m_credit -= 1;
+        }
+    }
+    return out;
+};
+
+Ptr<WindowFECPacket> WindowFecEncoder::CreateRepair (Ptr<FecCodec> codec) {
+    uint32_t repairId = m_nextRepairId ++;
+    std::vector<Ptr<DataPacket>> covered (m_window.begin (), m_window.end ());
+    Ptr<WindowFECPacket> repair = Create<WindowFECPacket> (repairId, covered);
+    while (repair->GetHeaderLength () > m_maxHeader && m_window.size () > 1) {
+        m_window.pop_front ();
+        covered.assign (m_window.begin (), m_window.end ());
+        repair = Create<WindowFECPacket> (repairId, covered);
+    }
+    repair->SetEncodeTime (Simulator::Now ());
+
+    if (codec != NULL) {
+        uint64_t start = FecCodec::GetCpuTimeNs ();
+        std::vector<FecCodec::Symbol> payloads;
+        uint32_t symbolSize = 0;
+        for (auto pkt : covered) {
+            payloads.push_back (pkt->CopyPayloadData ());
+            symbolSize = MAX (symbolSize, FecCodec::GetSymbolSize (payloads.back ().size ()));
+        }
+        FecCodec::Symbol symbol (symbolSize, 0), framed (symbolSize);
+        for (size_t i = 0; i < covered.size (); i++) {
+            FecCodec::ToSymbol (payloads[i], symbolSize, framed.data ());
+            uint8_t c = GetCoefficient (repairId, GetSourceId (covered[i]->GetGroupId (), covered[i]->GetPktIdGroup ()));
+            GaloisField::MulAdd (symbol.data (), framed.data (), c, symbolSize);
+        }
+        repair->SetPayloadData (Create<Packet> (symbol.data (), symbol.size ()));
+        codec->RecordEncode (repairId, covered.size (), 1, symbolSize, FecCodec::GetCpuTimeNs () - start);
+    }
+    return repair;
+};
+
+uint64_t WindowFecEncoder::GetRepairCount () const {
+    return m_nextRepairId;
+};
+
+/* class WindowFecDecoder */
+TypeId WindowFecDecoder::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::WindowFecDecoder")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+    ;
+    return tid;
+};
+
+WindowFecDecoder::WindowFecDecoder (Time ddl)
+: m_ddl {ddl}
+, m_codec {NULL}
+, m_solver {}
+, m_encodeTimes {}
+, m_digests {}
+, m_recovered {0}
+{};
+
+WindowFecDecoder::~WindowFecDecoder () {};
+
+void WindowFecDecoder::SetFecCodec (Ptr<FecCodec> codec) {
+    m_codec = codec;
+};
+
+std::vector<Ptr<DataPacket>> WindowFecDecoder::AddDataPacket (Ptr<DataPacket> pkt) {
+    Expire (Simulator::Now ());
+    LinearFecDecoder::SourceId id = WindowFecEncoder::GetSourceId (pkt->GetGroupId (), pkt->GetPktIdGroup ());
+    m_encodeTimes[id] = pkt->GetEncodeTime ();
+    m_digests.erase (id);
+
+    uint64_t start = FecCodec::GetCpuTimeNs ();
+    LinearFecDecoder::Symbol symbol;
+    if (m_codec != NULL) {
+        FecCodec::Symbol payload = pkt->CopyPayloadData ();
+        symbol.resize (FecCodec::GetSymbolSize (payload.size ()));
+        FecCodec::ToSymbol (payload, symbol.size (), symbol.data ());
+    }
+    auto decoded = m_solver.AddSource (id, symbol);
+    auto recovered = Deliver (decoded, pkt->GetGlobalId ());
+    if (m_codec != NULL && !recovered.empty ()) {
+        uint64_t bytes = 0;
+        for (auto data_pkt : recovered)
+            bytes += data_pkt->GetPayloadSize ();
+        m_codec->RecordDecode (pkt->GetGroupId (), recovered.size (), 0, bytes, FecCodec::GetCpuTimeNs () - start, true);
+    }
+    return recovered;
+};
+
+std::vector<Ptr<DataPacket>> WindowFecDecoder::AddRepairPacket (Ptr<WindowFECPacket> pkt) {
+    Expire (Simulator::Now ());
+    uint64_t start = FecCodec::GetCpuTimeNs ();
+    std::map<LinearFecDecoder::SourceId, uint8_t> coeffs;
+    for (auto digest : pkt->GetDataPacketDigests ()) {
+        LinearFecDecoder::SourceId id = WindowFecEncoder::GetSourceId (digest->group_id, digest->pkt_id_in_group);
+        coeffs[id] = WindowFecEncoder::GetCoefficient (pkt->GetRepairId (), id);
+        m_encodeTimes.emplace (id, digest->encode_time);
+        if (!m_solver.IsKnown (id))
+            m_digests[id] = digest;
+    }
+    auto decoded = m_solver.AddRepair (coeffs, m_codec != NULL ? pkt->CopyPayloadData () : LinearFecDecoder::Symbol ());
+    auto recovered = Deliver (decoded, pkt->GetGlobalId ());
+    if (m_codec != NULL) {
+        uint64_t bytes = 0;
+        for (auto data_pkt : recovered)
+            bytes += data_pkt->GetPayloadSize ();
+        m_codec->RecordDecode (pkt->GetRepairId (), coeffs.size (), 1, bytes, FecCodec::GetCpuTimeNs () - start, true);
+    }
+    return recovered;
+};
+
+std::vector<Ptr<DataPacket>> WindowFecDecoder::Deliver (const std::vector<LinearFecDecoder::SourceId> & ids, uint16_t globalId) {
+    std::vector<Ptr<DataPacket>> recovered;
+    for (auto id : ids) {
+        auto it = m_digests.find (id);
+        NS_ASSERT_MSG (it != m_digests.end (), "A decoded source must be covered by a repair");
+        Ptr<WindowPktDigest> digest = it->second;
+        Ptr<DataPacket> data_pkt = Create<DataPacket> (
+            digest,
+            digest->group_id, digest->group_data_num, digest->group_fec_num,
+            digest->batch_id, digest->batch_data_num, digest->batch_fec_num
+        );
+        data_pkt->SetEncodeTime (digest->encode_time);
+        data_pkt->SetRcvTime (Simulator::Now ());
+        /* acknowledged as received with the packet that let it decode */
+        data_pkt->SetGlobalId (globalId);
+        if (m_codec != NULL) {
+            const LinearFecDecoder::Symbol & symbol = m_solver.GetSymbol (id);
+            FecCodec::Symbol payload;
+            FecCodec::FromSymbol (symbol.data (), symbol.size (), payload);
+            m_codec->CheckPayload (payload, digest->frame_id, digest->pkt_id_in_frame);
+            data_pkt->SetPayload (nullptr, payload.size ());
+            data_pkt->SetPayloadData (Create<Packet> (payload.data (), payload.size ()));
+        }
+        NS_LOG_FUNCTION ("[WindowFec] recovered group " << digest->group_id << " pkt " << digest->pkt_id_in_group);
+        recovered.push_back (data_pkt);
+        m_digests.erase (it);
+        m_recovered ++;
+    }
+    return recovered;
+};
+
+void WindowFecDecoder::Expire (Time now) {
+    std::vector<LinearFecDecoder::SourceId> expired;
+    for (auto it = m_encodeTimes.begin (); it != m_encodeTimes.end ();) {
+        if (now - it->second > 2 * m_ddl) {
+            expired.push_back (it->first);
+            m_digests.erase (it->first);
+            it = m_encodeTimes.erase (it);
+        } else
+            it ++;
+    }
+    if (!expired.empty ())
+        m_solver.Forget (expired);
+};
+
+uint64_t WindowFecDecoder::GetRecoveredCount () const {
+    return m_recovered;
+};
+
+}; // namespace ns3
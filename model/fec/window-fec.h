@@ -0,0 +1,121 @@
+#ifndef WINDOW_FEC_H
+#define WINDOW_FEC_H
+
+#include "ns3/common-header.h"
+#include "ns3/network-packet.h"
+#include "ns3/fec-codec.h"
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include <deque>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Sender side of the sliding-window (convolutional) FEC, in the style
+ * of RLC / Tetrys.
+ *
+ * Instead of the repairs of a batch, the first transmissions are followed by
+ * repairs over the last data packets sent, whatever their batch, group or
+ * frame: a repair is a random linear combination over GF(2^8) of the packets
+ * of the window, so that a loss is repaired by the next repair that arrives,
+ * and a burst by the next ones. The window keeps at most maxWindow packets,
+ * none older than the delay deadline. The repair header lists the window in
+ * runs of consecutive packets of a batch, and the oldest packets leave the
+ * window while the header exceeds maxHeader bytes.
+ *
+ * Repairs are interleaved at the rate of the FEC policy: each data packet
+ * earns rate repairs, a repair is sent once a whole one is earned, and the
+ * last packet of a frame sends one if half of it is, so that the tail of a
+ * frame does not wait for the next frame to be protected.
+ *
+ * A source is named by its group id and its index in the group, the
+ * coefficients derive from the repair id and the source, so that the repair
+ * header only lists the covered packets (see WindowFECPacket).
+ */
+class WindowFecEncoder : public Object {
+public:
+    static TypeId GetTypeId (void);
+    WindowFecEncoder (uint16_t maxWindow, Time ddl, uint32_t maxHeader);
+    ~WindowFecEncoder ();
+
+    /**
+     * \brief Add the data packets of a first transmission batch to the window
+     * and interleave the repairs they earn
+     *
+     * \param pkts data packets in sending order, with their group set
+     * \param rate repair packets per data packet
+     * \param maxRepair at most this many repairs, e.g. the CC quota
+     * \param codec real payload mode, NULL otherwise
+     * \return the data packets, each followed by the repairs sent after it
+     */
+    std::vector<Ptr<VideoPacket>> Protect (const std::vector<Ptr<DataPacket>> & pkts,
+        double_t rate, uint16_t maxRepair, Ptr<FecCodec> codec);
+
+    uint64_t GetRepairCount () const;
+
+    static LinearFecDecoder::SourceId GetSourceId (uint32_t groupId, uint16_t pktIdInGroup);
+    /* nonzero coefficient of a source in a repair */
+    static uint8_t GetCoefficient (uint32_t repairId, LinearFecDecoder::SourceId id);
+
+private:
+    Ptr<WindowFECPacket> CreateRepair (Ptr<FecCodec> codec);
+
+    uint16_t m_maxWindow;
+    Time m_ddl;
+    uint32_t m_maxHeader;
+    std::deque<Ptr<DataPacket>> m_window;   /* in sending order */
+    double_t m_credit;                      /* repairs earned and not sent */
+    uint32_t m_nextRepairId;
+};  // class WindowFecEncoder
+
+/**
+ * \brief Receiver side of the sliding-window FEC: every data packet and
+ * repair received is fed to a LinearFecDecoder, which decodes a lost packet
+ * as soon as the received ones determine it.
+ *
+ * The recovered data packets are rebuilt from the digests of the repairs, to
+ * be handed to their groups as if they were received. Sources are forgotten
+ * twice the deadline after their encoding, repairs sent late may still cover
+ * them until then.
+ */
+class WindowFecDecoder : public Object {
+public:
+    static TypeId GetTypeId (void);
+    WindowFecDecoder (Time ddl);
+    ~WindowFecDecoder ();
+
+    /* real payload mode: decode the payloads, not only which packets are recovered */
+    void SetFecCodec (Ptr<FecCodec> codec);
+
+    /**
+     * \brief A data packet arrived, first transmission or not
+     *
+     * \return the data packets recovered thanks to it
+     */
+    std::vector<Ptr<DataPacket>> AddDataPacket (Ptr<DataPacket> pkt);
+    /**
+     * \brief A repair arrived
+     *
+     * \return the data packets recovered thanks to it
+     */
+    std::vector<Ptr<DataPacket>> AddRepairPacket (Ptr<WindowFECPacket> pkt);
+
+    uint64_t GetRecoveredCount () const;
+
+private:
+    void Expire (Time now);
+    std::vector<Ptr<DataPacket>> Deliver (const std::vector<LinearFecDecoder::SourceId> & ids, uint16_t globalId);
+
+    Time m_ddl;
+    Ptr<FecCodec> m_codec;
+    LinearFecDecoder m_solver;
+    std::map<LinearFecDecoder::SourceId, Time> m_encodeTimes;   /* of the sources received or covered by a repair */
+    std::map<LinearFecDecoder::SourceId, Ptr<WindowPktDigest>> m_digests;   /* of the sources not received yet */
+    uint64_t m_recovered;
+};  // class WindowFecDecoder
+
+};  // namespace ns3
+
+#endif  /* WINDOW_FEC_H */
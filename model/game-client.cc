@@ -27,6 +27,11 @@ GameClient::GameClient()
 , incomplete_groups {}
 , complete_groups {}
 , timeout_groups {}
+, m_codec {NULL}
+, m_windowDecoder {NULL}
+, m_nack {false}
+, m_nackNextGroupId {0}
+, m_nackPktCnt {0}
 {};
 
 /*
@@ -52,12 +57,34 @@ void GameClient::Setup (Ipv4Address srcIP, uint16_t srcPort, uint16_t destPort,
     this->delay_ddl = delay_ddl;
     this->m_receiver_window = wndsize;
     this->default_rtt = MilliSeconds(rtt/2);
+    this->rtt = MilliSeconds(rtt);
     this->rcvd_pkt_cnt = 0;
     this->rcvd_data_pkt_cnt = 0;
     this->rcvd_fec_pkt_cnt = 0; 
     m_debugStream = debugStream;   
 };
 
+void GameClient::SetFecCodec(Ptr<FecCodec> codec) {
+    this->m_codec = codec;
+    if(codec != NULL)
+        codec->SetLogStream(m_debugStream);
+    if(this->m_windowDecoder != NULL)
+        this->m_windowDecoder->SetFecCodec(codec);
+};
+
+void GameClient::SetWindowFec(bool enable) {
+    if(!enable) {
+        this->m_windowDecoder = NULL;
+        return;
+    }
+    this->m_windowDecoder = Create<WindowFecDecoder> (this->delay_ddl);
+    this->m_windowDecoder->SetFecCodec(this->m_codec);
+};
+
+void GameClient::SetNack(bool enable) {
+    this->m_nack = enable;
+};
+
 void GameClient::DoDispose() {
 
 };
@@ -65,11 +92,14 @@ void GameClient::DoDispose() {
 void GameClient::StartApplication(void) {
     this->InitSocket();
     this->receiver = Create<PacketReceiver> (this, &GameClient::ReceivePacket, this->m_socket, this->m_receiver_window);
+    if(this->m_nack)
+        this->m_nackEvent = Simulator::Schedule(MilliSeconds(1), &GameClient::CheckNack, this);
 };
 
 void GameClient::StopApplication(void) {
     NS_LOG_ERROR("\n[Client] Stopping GameClient...");
     this->OutputStatistics();
+    Simulator::Cancel(this->m_nackEvent);
     this->m_socket->Close();
     this->receiver->StopRunning();
 };
@@ -85,6 +115,8 @@ void GameClient::InitSocket() {
 
 Ptr<Socket> GameClient::GetSocket() { return this->m_socket; };
 
+Ptr<VideoDecoder> GameClient::GetDecoder() { return this->decoder; };
+
 void GameClient::ReplyACK(std::vector<Ptr<DataPacket>> data_pkts, uint16_t last_pkt_id) {
     DEBUG("[Client] At " << Simulator::Now().GetMilliSeconds() << " ms send ACK for packet " << last_pkt_id);
     std::vector<Ptr<GroupPacketInfo>> pkt_infos;
@@ -103,7 +135,6 @@ void GameClient::ReplyFrameACK(uint32_t frame_id, Time frame_encode_time) {
 };
 
 void GameClient::ReceivePacket(Ptr<VideoPacket> pkt) {
-    auto group_id = pkt->GetGroupId();
     Time rcv_time = pkt->GetRcvTime();
 
     /* DEBUG */
@@ -152,7 +183,8 @@ void GameClient::ReceivePacket(Ptr<VideoPacket> pkt) {
         this->rcvd_datapkt_rtx_count[pkt->GetTXCount()] ++;
     }
 
-    if(pkt->GetPacketType() == PacketType::FEC_PKT || pkt->GetPacketType() == PacketType::DUP_FEC_PKT){
+    if(pkt->GetPacketType() == PacketType::FEC_PKT || pkt->GetPacketType() == PacketType::DUP_FEC_PKT
+        || pkt->GetPacketType() == PacketType::WIN_FEC_PKT){
         this->rcvd_fec_pkt_cnt ++;
         if(this->rcvd_fecpkt_rtx_count.find(pkt->GetTXCount()) == this->rcvd_fecpkt_rtx_count.end())
             this->rcvd_fecpkt_rtx_count[pkt->GetTXCount()] = 0;
@@ -160,12 +192,80 @@ void GameClient::ReceivePacket(Ptr<VideoPacket> pkt) {
     }
     /* STATISTICS end */
 
+    /* NACK mode: groups skipped by the group ids, RTT of the requests */
+    if(this->m_nack) {
+        for(uint32_t id = this->m_nackNextGroupId; id < pkt->GetGroupId(); id++) {
+            if(this->incomplete_groups.find(id) == this->incomplete_groups.end()
+                && this->complete_groups.find(id) == this->complete_groups.end()
+                && this->timeout_groups.find(id) == this->timeout_groups.end())
+                this->m_lostGroups[id] = rcv_time;
+        }
+        this->m_nackNextGroupId = MAX(this->m_nackNextGroupId, pkt->GetGroupId() + 1);
+        this->m_lostGroups.erase(pkt->GetGroupId());
+        auto probe = this->m_nackRttProbe.find(pkt->GetGroupId());
+        if(pkt->GetTXCount() > 0 && probe != this->m_nackRttProbe.end()) {
+            this->rtt = 0.875 * this->rtt + 0.125 * (rcv_time - probe->second);
+            this->m_nackRttProbe.erase(probe);
+        }
+    }
+
+    /* 1) - 5) the packet, and the packets the sliding-window FEC recovers with it */
+    std::vector<Ptr<DataPacket>> recovered;
+    bool useful = true;
+    if(pkt->GetPacketType() == PacketType::WIN_FEC_PKT) {
+        if(this->m_windowDecoder != NULL)
+            recovered = this->m_windowDecoder->AddRepairPacket(DynamicCast<WindowFECPacket, VideoPacket> (pkt));
+    } else {
+        if(this->m_windowDecoder != NULL && pkt->GetPacketType() != PacketType::FEC_PKT)
+            recovered = this->m_windowDecoder->AddDataPacket(DynamicCast<DataPacket, VideoPacket> (pkt));
+        useful = this->AddToGroup(pkt, pkt->GetGlobalId());
+    }
+    for(auto data_pkt : recovered)
+        useful = this->AddToGroup(data_pkt, pkt->GetGlobalId()) || useful;
+    if(!useful)
+        return;
+
+    /* 6) Check all incomplete groups for timeouts */
+    for(auto it = this->incomplete_groups.begin();it != this->incomplete_groups.end();) {
+        auto i_group_id = it->second->GetGroupId();
+        // Assume all packets comes from the same frame
+        // DEBUG("Group ID: " << it->second->GetGroupId() <<
+        //     "group rcv size: " << it->second->decoded_pkts.size());
+        if (rcv_time > it->second->GetEncodeTime() + this->delay_ddl) {
+            // debug
+            DEBUG("[Client Timeout] " <<
+                "At " << Simulator::Now().GetMilliSeconds() <<
+                "ms, Group ID: " << it->second->GetGroupId() <<
+                ", Total DATA: " << it->second->GetDataNum() <<
+                ", Max TX: " << unsigned(it->second->GetMaxTxCount()) <<
+                ", First TX data: " << it->second->GetFirstTxDataCount() <<
+                ", First TX FEC: " << it->second->GetFirstTxFECCount() <<
+                ", RTX data: " << it->second->GetRtxDataCount() <<
+                ", RTX FEC: " << it->second->GetRtxFECCount() <<
+                ", Last Rcv Time: " << it->second->GetLastRcvTimeTx0().GetMilliSeconds() <<
+                ", Rcv time: " << rcv_time.GetMilliSeconds() <<
+                ", Encode Time: " << it->second->GetEncodeTime().GetMilliSeconds() <<
+                ", Delay ddl: " << this->delay_ddl.GetMilliSeconds());
+            // the whole group is timed out
+            it->second->RecordTimeout();
+            this->timeout_groups[i_group_id] = it->second;
+            it = this->incomplete_groups.erase(it);
+            continue;
+        }
+        it ++;
+    }
+    /* End of 6) check all incomplete groups for timeouts */
+};
+
+bool GameClient::AddToGroup(Ptr<VideoPacket> pkt, uint16_t ack_pkt_id) {
+    auto group_id = pkt->GetGroupId();
+
     /* 1) necessity check */
     // do not proceed if the group is timed out or complete
     if(this->complete_groups.find(group_id) != this->complete_groups.end())
-        return;
+        return false;
     if(this->timeout_groups.find(group_id) != this->timeout_groups.end())
-        return;
+        return false;
     /* End of 1) necessity check */
 
     /* 2) Insert/Create packet group */
@@ -174,6 +274,7 @@ void GameClient::ReceivePacket(Ptr<VideoPacket> pkt) {
         this->incomplete_groups[group_id] = Create<PacketGroup> (
             group_id, pkt->GetGroupDataNum(), pkt->GetEncodeTime()
         );
+        this->incomplete_groups[group_id]->SetFecCodec(this->m_codec);
     }
     // DEBUG(group_id);
     NS_ASSERT(this->incomplete_groups.find(group_id) != this->incomplete_groups.end());
@@ -189,7 +290,7 @@ void GameClient::ReceivePacket(Ptr<VideoPacket> pkt) {
     /* End of 3) Get decoded packets */
 
     /* 4) replay ACK packet */
-    this->ReplyACK(decode_pkts, pkt->GetGlobalId());
+    this->ReplyACK(decode_pkts, ack_pkt_id);
     /* End of 4) replay ACK packet */
 
     /* 5) Check whether a group a complete */
@@ -220,36 +321,65 @@ void GameClient::ReceivePacket(Ptr<VideoPacket> pkt) {
         this->incomplete_groups.erase(group_id);
     }
     /* End of 5) Check whether a group a complete */
+    return true;
+};
 
-    /* 6) Check all incomplete groups for timeouts */
-    for(auto it = this->incomplete_groups.begin();it != this->incomplete_groups.end();) {
-        auto i_group_id = it->second->GetGroupId();
-        // Assume all packets comes from the same frame
-        // DEBUG("Group ID: " << it->second->GetGroupId() <<
-        //     "group rcv size: " << it->second->decoded_pkts.size());
-        if (rcv_time > it->second->GetEncodeTime() + this->delay_ddl) {
-            // debug
-            DEBUG("[Client Timeout] " <<
-                "At " << Simulator::Now().GetMilliSeconds() <<
-                "ms, Group ID: " << it->second->GetGroupId() <<
-                ", Total DATA: " << it->second->GetDataNum() <<
-                ", Max TX: " << unsigned(it->second->GetMaxTxCount()) <<
-                ", First TX data: " << it->second->GetFirstTxDataCount() <<
-                ", First TX FEC: " << it->second->GetFirstTxFECCount() <<
-                ", RTX data: " << it->second->GetRtxDataCount() <<
-                ", RTX FEC: " << it->second->GetRtxFECCount() <<
-                ", Last Rcv Time: " << it->second->GetLastRcvTimeTx0().GetMilliSeconds() <<
-                ", Rcv time: " << rcv_time.GetMilliSeconds() <<
-                ", Encode Time: " << it->second->GetEncodeTime().GetMilliSeconds() <<
-                ", Delay ddl: " << this->delay_ddl.GetMilliSeconds());
-            // the whole group is timed out
-            this->timeout_groups[i_group_id] = it->second;
-            it = this->incomplete_groups.erase(it);
+void GameClient::CheckNack() {
+    this->m_nackEvent = Simulator::Schedule(MilliSeconds(1), &GameClient::CheckNack, this);
+    Time now = Simulator::Now();
+    /* tolerance on the expected completion times */
+    Time margin = this->receiver->Get_FECgroup_delay() + MilliSeconds(1);
+    std::vector<Ptr<GroupPacketInfo>> pkt_infos;
+
+    for(auto it = this->m_lostGroups.begin();it != this->m_lostGroups.end();) {
+        if(now - it->second > this->delay_ddl) {
+            this->m_nackTime.erase(it->first);
+            it = this->m_lostGroups.erase(it);
             continue;
         }
+        auto last = this->m_nackTime.find(it->first);
+        if(last == this->m_nackTime.end() || now - last->second > this->rtt) {
+            pkt_infos.push_back(Create<GroupPacketInfo> (it->first, RtxRequestPacket::WHOLE_GROUP, 0, 0));
+            this->m_nackTime[it->first] = now;
+            this->m_nackRttProbe[it->first] = now;
+        }
         it ++;
     }
-    /* End of 6) check all incomplete groups for timeouts */
+
+    for(auto it = this->incomplete_groups.begin();it != this->incomplete_groups.end();it++) {
+        uint32_t group_id = it->first;
+        Ptr<PacketGroup> group = it->second;
+        if(now > group->GetEncodeTime() + this->delay_ddl)
+            continue;
+        bool overdue = now > group->GetExpectedCompletionTime() + margin;
+        auto last = this->m_nackTime.find(group_id);
+        if(last == this->m_nackTime.end()) {
+            // packets are sent group after group: once a later one arrived, the rest of this one is lost
+            if(!overdue && group_id + 1 >= this->m_nackNextGroupId)
+                continue;
+        } else if(!overdue || now - last->second <= this->rtt)
+            continue;
+        for(uint16_t pkt_id : group->GetMissingDataIds())
+            pkt_infos.push_back(Create<GroupPacketInfo> (group_id, pkt_id, 0, 0));
+        this->m_nackTime[group_id] = now;
+        this->m_nackRttProbe[group_id] = now;
+    }
+
+    // forget the groups completed or timed out
+    for(auto it = this->m_nackTime.begin();it != this->m_nackTime.end();) {
+        if(this->incomplete_groups.find(it->first) == this->incomplete_groups.end()
+            && this->m_lostGroups.find(it->first) == this->m_lostGroups.end()) {
+            this->m_nackRttProbe.erase(it->first);
+            it = this->m_nackTime.erase(it);
+        } else
+            it ++;
+    }
+
+    if(pkt_infos.empty())
+        return;
+    DEBUG("[Client] At " << now.GetMilliSeconds() << " ms send NACK for " << pkt_infos.size() << " packets");
+    this->receiver->SendPacket(Create<RtxRequestPacket> (pkt_infos));
+    this->m_nackPktCnt ++;
 };
 
 void GameClient::OutputStatistics() {
@@ -270,6 +400,15 @@ void GameClient::OutputStatistics() {
     for(auto it = rcvd_group_rtx_count.begin();it != rcvd_group_rtx_count.end();it++) {
         NS_LOG_ERROR("\tTX: " << unsigned(it->first) << ", group count: " << it->second << ", ratio: " << ((double_t) it->second) / group_count * 100 << "%");
     }
+    if(this->m_windowDecoder != NULL)
+        NS_LOG_ERROR("[Client] Window FEC recovered: " << this->m_windowDecoder->GetRecoveredCount());
+    if(this->m_nack)
+        NS_LOG_ERROR("[Client] NACK packets sent: " << this->m_nackPktCnt);
+    if(this->m_codec != NULL) {
+        std::ostringstream report;
+        this->m_codec->Report(report);
+        NS_LOG_ERROR("[Client] " << report.str());
+    }
 };
 
 }; // namespace ns3
\ No newline at end of file
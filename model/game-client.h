@@ -3,6 +3,8 @@
 
 #include "common-header.h"
 #include "ns3/fec-policy.h"
+#include "ns3/fec-codec.h"
+#include "ns3/window-fec.h"
 #include "packet-receiver.h"
 #include "video-decoder.h"
 #include "ns3/application.h"
@@ -24,6 +26,30 @@ public:
     ~GameClient();
     void Setup(Ipv4Address srcIP, uint16_t srcPort,uint16_t destPort, uint8_t fps, Time delay_ddl, 
         uint32_t wndsize, uint16_t rtt, Ptr<OutputStreamWrapper> appStream, Ptr<OutputStreamWrapper> debugStream);
+    /**
+     * \brief Real payload mode: recover lost data packets by decoding the
+     * repair symbols of the FEC packets, see GameServer::SetFecCodec. Call
+     * after Setup.
+     *
+     * \param codec same code type as the sender, NULL to count the
+     * received packets only (default)
+     */
+    void SetFecCodec(Ptr<FecCodec> codec);
+    /**
+     * \brief Decode the repairs of the sliding-window FEC, see
+     * GameServer::SetWindowFec. Call after Setup.
+     */
+    void SetWindowFec(bool enable);
+    /**
+     * \brief Receiver-driven retransmission, see GameServer::SetNackRtx: the
+     * client checks its groups every millisecond and requests in one NACK
+     * the packets of the groups it finds lost. A group is lost once a later
+     * group arrived or its expected completion time passed (first request),
+     * or once its expected completion time passed at least an RTT after the
+     * last request. Groups none of which arrived are found by the holes in
+     * the group ids. Call after Setup.
+     */
+    void SetNack(bool enable);
 
 protected:
     void DoDispose(void);
@@ -37,6 +63,17 @@ private:
     Ptr<VideoDecoder> decoder;
     Ptr<Socket> m_socket;
     Ptr<FECPolicy> policy;
+    Ptr<FecCodec> m_codec;      /* real payload mode, NULL otherwise */
+    Ptr<WindowFecDecoder> m_windowDecoder;  /* sliding-window FEC mode, NULL otherwise */
+
+    // NACK mode
+    bool m_nack;
+    EventId m_nackEvent;
+    uint32_t m_nackNextGroupId;     /* one past the highest group id received */
+    std::unordered_map<uint32_t, Time> m_lostGroups;    /* groups none of which arrived, by detection time */
+    std::unordered_map<uint32_t, Time> m_nackTime;      /* last request of a group */
+    std::unordered_map<uint32_t, Time> m_nackRttProbe;  /* requests waiting for their first retransmission, for RTT samples */
+    uint64_t m_nackPktCnt;
 
     uint8_t fps;        /* video fps */
     Time delay_ddl;     /* delay ddl */
@@ -74,6 +111,17 @@ private:
 
     void InitSocket();
     void OutputStatistics();
+    /**
+     * @brief Request the packets of the lost groups, see SetNack
+     */
+    void CheckNack();
+    /**
+     * @brief Insert a received or recovered packet into its group, hand the
+     * decoded packets to the decoder and ACK them
+     *
+     * @return false if the group is already complete or timed out
+     */
+    bool AddToGroup(Ptr<VideoPacket> pkt, uint16_t ack_pkt_id);
     /**
      * @brief Reply ACK to server for recently received packets
      */
@@ -86,6 +134,7 @@ private:
 
 public:
     Ptr<Socket> GetSocket();
+    Ptr<VideoDecoder> GetDecoder();
     void ReceivePacket(Ptr<VideoPacket> pkt);
 
 };  // class GameClient
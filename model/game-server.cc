@@ -82,8 +82,16 @@ GameServer::GameServer()
 , m_destPort{0}
 , m_cc_enable{false}
 , m_cc_algorithm{NOT_USE_CC}
+, m_ect{0}
 , m_cc_timer{Timer::CANCEL_ON_DESTROY}
 , m_cc_interval{Seconds(1)}
+, m_ccaQuotaPkt{0}
+, m_mediaFecRate{0}
+, m_goodput_ratio{1}
+, m_codec{NULL}
+, m_windowEncoder{NULL}
+, m_freshRepairRtx{false}
+, m_nackRtx{false}
 {};
 
 GameServer::~GameServer () {};
@@ -118,7 +126,7 @@ void GameServer::Setup (
   m_frameInterval = interval;
   m_encoder = Create<DumbVideoEncoder> (fps, bitrate, this, &GameServer::SendFrame);
   m_sender = Create<PacketSender> (this, m_frameInterval, delay_ddl, debugStream, 
-    &GameServer::RcvACKPacket, &GameServer::RcvFrameAckPacket);
+    &GameServer::RcvACKPacket, &GameServer::RcvFrameAckPacket, &GameServer::RcvRtxRequestPacket);
   m_delayDdl = delay_ddl;
   m_sender->SetNetworkStatistics (MilliSeconds (default_rtt), default_bw, default_loss, default_group_delay);
   this->send_group_cnt = 0;
@@ -126,7 +134,7 @@ void GameServer::Setup (
 
   m_lossEstimator = Create<LossEstimator> (measure_window);
 
-  m_maxPayloadSize = DataPacket (0, 0, 0).GetMaxPayloadSize ();
+  m_maxPayloadSize = DataPacket::GetMaxPayloadSize ();
 
   m_fecStream = fecStream;
   m_debugStream = debugStream;
@@ -152,6 +160,48 @@ void GameServer::SetController(CC_ALG cc_algorithm) {
   }
 }
 
+void GameServer::SetEcn(uint8_t ect) {
+  NS_ASSERT_MSG (ect <= 2, "ECN-capable codepoint must be ECT(0) or ECT(1)");
+  m_ect = ect;
+}
+
+void GameServer::SetPacketSize(uint16_t size) {
+  m_maxPayloadSize = DataPacket::GetMaxPayloadSize (size);
+}
+
+void GameServer::SetFrameTrace(std::string traceFile, Time rcDelay) {
+  m_encoder = Create<FrameTraceEncoder> (this->fps, this->bitrate, traceFile, rcDelay, this, &GameServer::SendFrame);
+}
+
+void GameServer::SetFecCodec(Ptr<FecCodec> codec) {
+  m_codec = codec;
+  if (m_codec != NULL)
+    m_codec->SetLogStream (m_debugStream);
+}
+
+void GameServer::SetWindowFec(uint16_t maxWindow) {
+  /* the repair header may take a tenth of a data packet */
+  if (maxWindow > 0)
+    m_windowEncoder = Create<WindowFecEncoder> (maxWindow, m_delayDdl, (m_maxPayloadSize + 8 /* data header */) / 10);
+  else
+    m_windowEncoder = NULL;
+}
+
+void GameServer::SetFreshRepairRtx(bool enable) {
+  m_freshRepairRtx = enable;
+}
+
+void GameServer::SetNackRtx(bool enable) {
+  m_nackRtx = enable;
+}
+
+int64_t GameServer::AssignStreams(int64_t stream) {
+  NS_ASSERT_MSG (m_sender != NULL, "GameServer::AssignStreams must be called after Setup");
+  int64_t used = m_sender->AssignStreams (stream);
+  used += m_fecPolicy->AssignStreams (stream + used);
+  return used;
+}
+
 void GameServer::DoDispose() {};
 
 void GameServer::StartApplication() {
@@ -166,6 +216,10 @@ void GameServer::StartApplication() {
       break;
     case NADA:
       m_sender->SetController (std::make_shared<rmcat::NadaController> ());
+      break;
+    case SCREAM:
+      m_sender->SetController (std::make_shared<rmcat::ScreamController> ());
+      break;
     default:
       break;
     }
@@ -191,6 +245,8 @@ void GameServer::InitSocket() {
     auto res = m_socket->Bind (InetSocketAddress {m_srcIP, m_srcPort});
     NS_ASSERT (res == 0);
     m_socket->Connect (InetSocketAddress {m_destIP, m_destPort});
+    if (m_ect != 0)
+      m_socket->SetIpTos (m_ect);
   }
 };
 
@@ -256,8 +312,17 @@ void GameServer::CreatePacketBatch(
   if (this->m_cc_enable) {
     max_fec_num = MAX (1, m_ccaQuotaPkt);
   }
-  uint16_t batch_fec_num = MIN ((uint16_t) round(batch_data_num * fec_rate), max_fec_num);
+  /* in sliding-window mode, first transmissions are protected by window repairs instead */
+  bool window_fec = m_windowEncoder != NULL && !is_rtx;
+  uint16_t batch_fec_num = window_fec ? 0 : MIN ((uint16_t) round(batch_data_num * fec_rate), max_fec_num);
+  /* SendPackets keeps the groups below the batch limit of the code */
+  NS_ASSERT (batch_data_num < GetMaxBatchSize ());
+  batch_fec_num = MIN (batch_fec_num, (uint16_t) (GetMaxBatchSize () - batch_data_num));
   m_ccaQuotaPkt -= batch_fec_num;
+  /* fresh-repair rtx: as many more repairs replace the data packets, whose quota SendPackets took */
+  bool fresh_repair = m_freshRepairRtx && is_rtx;
+  if (fresh_repair)
+    batch_fec_num = MIN (batch_fec_num + batch_data_num, (int) (GetMaxBatchSize () - batch_data_num));
 
   uint16_t group_data_num, group_fec_num;
   uint8_t tx_count = data_pkts.front()->GetTXCount();
@@ -315,6 +380,35 @@ void GameServer::CreatePacketBatch(
     fec_pkt->SetEncodeTime(Simulator::Now());
     pkt_batch.push_back(fec_pkt);
   }
+
+  // Encode the repair symbols over the data payloads
+  if (m_codec != NULL && batch_fec_num > 0) {
+    std::vector<FecCodec::Symbol> payloads;
+    for (auto data_pkt : data_pkts)
+      payloads.push_back (data_pkt->CopyPayloadData ());
+    auto repairs = m_codec->EncodeBatch (batch_id, payloads, batch_fec_num);
+    for (uint16_t i = 0; i < batch_fec_num; i++)
+      pkt_batch[batch_data_num + i]->SetPayloadData (Create<Packet> (repairs[i].data (), repairs[i].size ()));
+  }
+
+  // Only the repairs of a fresh-repair rtx are sent, on the deadline of the frame
+  if (fresh_repair) {
+    pkt_batch.erase (pkt_batch.begin (), pkt_batch.begin () + batch_data_num);
+    for (auto pkt : pkt_batch)
+      pkt->SetEncodeTime (data_pkts.front ()->GetEncodeTime ());
+  }
+
+  // Interleave the sliding-window repairs, outside of the group
+  if (window_fec) {
+    pkt_batch = m_windowEncoder->Protect (data_pkts, fec_rate, max_fec_num, m_codec);
+    for (auto pkt : pkt_batch) {
+      if (pkt->GetPacketType () != PacketType::WIN_FEC_PKT)
+        continue;
+      pkt->SetFECBatch (batch_id, batch_data_num, batch_fec_num, pkt_id_in_batch ++);
+      pkt->SetFECGroup (group_id, group_data_num, group_fec_num, VideoPacket::RTX_FEC_GROUP_ID);
+      m_ccaQuotaPkt --;
+    }
+  }
   // DEBUG(pkt_batch.size() << ", "<< fec_param.fec_group_size << ", "<< batch_id << pkt_id_in_batch << group_id << pkt_id_in_group);
   return ;
 };
@@ -353,6 +447,13 @@ Time GameServer::GetDispersion (Ptr<DataPacket> pkt) {
   return std::min (batchSize * statistic->oneWayDispersion + MicroSeconds (500), MilliSeconds (m_frameInterval));
 }
 
+uint16_t GameServer::GetMaxBatchSize () {
+  /* without payloads the receiver still solves the Reed-Solomon equations */
+  if (m_codec != NULL && m_codec->GetCodeType () == FecCodec::XOR)
+    return UINT16_MAX;
+  return FecCodec::k_maxRsBatch;
+}
+
 bool GameServer::IsRtxTimeout (Ptr<DataPacket> pkt, Time rto) {
   Time now = Simulator::Now ();
   Time enqueueTime = pkt->GetEnqueueTime ();
@@ -394,7 +495,7 @@ void GameServer::StorePackets (std::vector<Ptr<VideoPacket>> pkts) {
       continue;
     Ptr<DataPacket> dataPkt = DynamicCast<DataPacket, VideoPacket> (pkt);
     Ptr<GroupPacketInfo> info = Create<GroupPacketInfo> (pkt->GetGroupId (), pkt->GetPktIdGroup (), 
-      dataPkt->GetDataGlobalId (), dataPkt->GetGlobalId ());
+      dataPkt->GetDataGlobalId (), m_sender->UnwrapGlobalId (dataPkt->GetGlobalId ()));
     m_dataPktHistoryKey.push_back (info);
     m_dataPktHistory[info->m_groupId][info->m_pktIdInGroup] = dataPkt;
   }
@@ -411,7 +512,7 @@ void GameServer::SendPackets (std::deque<Ptr<DataPacket>> pkts, Time ddlLeft, ui
   if (m_frameDataPktCnt.find (frameId) == m_frameDataPktCnt.end()) {
     NS_ASSERT_MSG(false, "No frame size info");
   }
-  uint8_t frameSize = m_frameDataPktCnt[frameId];
+  uint16_t frameSize = m_frameDataPktCnt[frameId];
   // Not retransmission packets:
   // Group the packets as fec_param's optimal
   if (!isRtx) {
@@ -419,6 +520,8 @@ void GameServer::SendPackets (std::deque<Ptr<DataPacket>> pkts, Time ddlLeft, ui
     // Default
     m_frameIdToGroupId[frameId].clear ();
     fecParam = GetFECParam (pkts.size(), m_encoder->GetBitrate (), ddlLeft, false, isRtx, frameSize);
+    /* leave room for at least one FEC packet in a batch of the code */
+    fecParam.fec_group_size = MIN (fecParam.fec_group_size, (uint16_t) (GetMaxBatchSize () - 1));
     NS_LOG_FUNCTION ("fecParam " << Simulator::Now ().GetMilliSeconds () << 
       " loss " << m_sender->GetNetworkStatistics ()->curLossRate <<
       " frameSize " << (int) frameSize <<
@@ -429,6 +532,24 @@ void GameServer::SendPackets (std::deque<Ptr<DataPacket>> pkts, Time ddlLeft, ui
       " bitRate " << m_encoder->GetBitrate () <<
       " fecRate " << fecParam.fec_rate);
 
+    if (pkts.size () > fecParam.fec_group_size) {
+      /* large frame: the fewest groups within the group size of the policy,
+         of equal sizes so that no small tail group is left */
+      uint16_t groupCnt = (pkts.size () + fecParam.fec_group_size - 1) / fecParam.fec_group_size;
+      uint16_t baseSize = pkts.size () / groupCnt;
+      uint16_t longGroupCnt = pkts.size () % groupCnt;  /* groups with one more packet */
+      for (uint16_t i = 0; i < groupCnt; i++) {
+        /* the FEC rate of a group depends on its size, as for the tail group */
+        uint16_t groupSize = baseSize + (i < longGroupCnt ? 1 : 0);
+        FECPolicy::FECParam groupParam = GetFECParam (groupSize, m_encoder->GetBitrate (), ddlLeft, true, isRtx, frameSize);
+        groupParam.fec_group_size = groupSize;
+        tmpList.assign (pkts.begin (), pkts.begin () + groupParam.fec_group_size);
+        pkts.erase (pkts.begin (), pkts.begin () + groupParam.fec_group_size);
+        CreateFirstPacketBatch (tmpList, groupParam);
+        pktToSendList.insert (pktToSendList.end (), tmpList.begin(), tmpList.end());
+      }
+    }
+
     // divide packets into groups
     while (pkts.size() >= fecParam.fec_group_size) {
       tmpList.clear();
@@ -498,9 +619,8 @@ void GameServer::SendPackets (std::deque<Ptr<DataPacket>> pkts, Time ddlLeft, ui
 
 void GameServer::SendFrame(uint8_t * buffer, uint32_t data_size) {
 
+  /* The encoder decides the frame size; the new CC rate applies from the next frame on */
   UpdateBitrate ();
-  double_t bitrate = m_encoder->GetBitrate ();
-  data_size = (uint32_t) (bitrate * 1000.0 / 8 / this->fps);
   data_size = MAX(data_size, 200);
   if (!data_size)
     return;
@@ -511,7 +631,7 @@ void GameServer::SendFrame(uint8_t * buffer, uint32_t data_size) {
   // calculate the num of data packets needed
   uint32_t frame_id = this->GetNextFrameId();
   uint16_t pkt_id = 0;
-  uint16_t data_pkt_max_payload = DataPacket::GetMaxPayloadSize();
+  uint16_t data_pkt_max_payload = m_maxPayloadSize;
   uint16_t data_pkt_num = data_size / data_pkt_max_payload
      + (data_size % data_pkt_max_payload != 0);    /* ceiling division */
 
@@ -522,6 +642,11 @@ void GameServer::SendFrame(uint8_t * buffer, uint32_t data_size) {
     Ptr<DataPacket> data_pkt = Create<DataPacket>(frame_id, data_pkt_num, pkt_id);
     data_pkt->SetEncodeTime(Simulator::Now());
     data_pkt->SetPayload(nullptr, MIN(data_pkt_max_payload, data_size - data_ptr));
+    if (m_codec != NULL) {
+      std::vector<uint8_t> payload (data_pkt->GetPayloadSize ());
+      FecCodec::FillPayload (payload.data (), payload.size (), frame_id, pkt_id);
+      data_pkt->SetPayloadData (Create<Packet> (payload.data (), payload.size ()));
+    }
     data_pkt_queue.push_back(data_pkt);
     pkt_id = pkt_id + 1;
   }
@@ -541,7 +666,7 @@ void GameServer::SendFrame(uint8_t * buffer, uint32_t data_size) {
   );
 }
 
-void GameServer::RetransmitGroup (uint32_t groupId) {
+void GameServer::RetransmitGroup (uint32_t groupId, const std::unordered_set<uint16_t> & pktIds) {
   // cannot find the packets to send
   NS_ASSERT (m_dataPktHistory.find (groupId) != m_dataPktHistory.end ());
 
@@ -554,6 +679,8 @@ void GameServer::RetransmitGroup (uint32_t groupId) {
   auto groupDataPkt = m_dataPktHistory[groupId];
   // find all packets that belong to the same group and retransmit them
   for (const auto& [pktId, dataPkt] : groupDataPkt) {
+    if (!pktIds.empty () && pktIds.find (pktId) == pktIds.end ())
+      continue;
     if (txCnt == -1) 
       txCnt = dataPkt->GetTXCount () + 1;
     if (encodeTime == Time (0)) 
@@ -561,12 +688,14 @@ void GameServer::RetransmitGroup (uint32_t groupId) {
 
     dataPkt->SetTXCount (txCnt);
     dataPkt->SetEnqueueTime (now);
+    if (m_freshRepairRtx)
+      dataPkt->SetSendTime (now);   /* not sent again, its timer restarts with its repairs */
     dataPkt->ClearFECBatch ();
     dataPktRtxQueue.push_back (dataPkt);
   }
   for (auto it = m_dataPktHistoryKey.begin (); it != m_dataPktHistoryKey.end ();) {
     Ptr<GroupPacketInfo> info = *it;
-    if (info->m_groupId == groupId)
+    if (info->m_groupId == groupId && (pktIds.empty () || pktIds.find (info->m_pktIdInGroup) != pktIds.end ()))
       it = m_dataPktHistoryKey.erase (it);
     else
       it ++;
@@ -578,6 +707,16 @@ void GameServer::RetransmitGroup (uint32_t groupId) {
     // all packets in the same group belong to the same frame
     uint32_t frameId = dataPktRtxQueue.front ()->GetFrameId ();
     SendPackets (dataPktRtxQueue, m_delayDdl - (now - encodeTime), frameId, true);
+    /* StorePackets only keeps the data packets sent, keep the repaired ones
+       for a further round if the repairs do not make it either */
+    if (m_freshRepairRtx) {
+      for (auto dataPkt : dataPktRtxQueue) {
+        Ptr<GroupPacketInfo> info = Create<GroupPacketInfo> (groupId, dataPkt->GetPktIdGroup (),
+          dataPkt->GetDataGlobalId (), m_sender->UnwrapGlobalId (dataPkt->GetGlobalId ()), txCnt);
+        info->m_state = GroupPacketInfo::PacketState::REPAIR_INFLIGHT;
+        m_dataPktHistoryKey.push_back (info);
+      }
+    }
   }
 }
 
@@ -639,7 +778,7 @@ void GameServer::CheckRetransmission () {
       it ++;
   }
 
-  uint16_t lastDataGlobalId = m_curRxHighestDataGlobalId;  /* for dup-ack check */
+  uint64_t lastDataGlobalId = m_curRxHighestDataGlobalId;  /* for dup-ack check */
   if (m_dataPktHistoryKey.empty ()) {
     return;
   }
@@ -671,6 +810,15 @@ void GameServer::CheckRetransmission () {
     
     pkt = m_dataPktHistory[info->m_groupId][info->m_pktIdInGroup];
 
+    /* repaired by a fresh-repair rtx: its old data global id says nothing
+       about holes, only its timer retransmits it again */
+    if (info->m_state == GroupPacketInfo::PacketState::REPAIR_INFLIGHT) {
+      if (IsRtxTimeout (pkt, m_rtxPolicy == "pto" ? Time (0) : Seconds (1)))
+        rtxGroupId.insert (pkt->GetGroupId ());
+      it --;
+      continue;
+    }
+
     /* this packet is too early to retransmit */
     if (now - pkt->GetEncodeTime () < statistic->minRtt)
       goto continueLoop;
@@ -682,17 +830,18 @@ void GameServer::CheckRetransmission () {
     NS_ASSERT (pkt->GetDataGlobalId () == info->m_dataGlobalId);
 
     /* If the FEC policy is RTX, we use the dup-ack retransmission policy
-      we do not count on the PTO policy. The rtx for fec packets is buggy, do not use it */
-    if (!hasHole) {
+      we do not count on the PTO policy. The rtx for fec packets is buggy, do not use it.
+      In NACK mode, the receiver reports the holes itself. */
+    if (!hasHole && !m_nackRtx) {
       // *m_debugStream->GetStream () << "[HoleCheck] m_dataGlobalId " << info->m_dataGlobalId << 
       //   " lastDataGlobalId " << lastDataGlobalId <<
       //   " m_isRecovery " << m_isRecovery << " globalId " << info->m_globalId << 
       //   " m_curContRxHighestGlobalId " << m_curContRxHighestGlobalId << std::endl;
-      if (Uint16Less (int (info->m_dataGlobalId) + 1, int (lastDataGlobalId))) {
+      if (info->m_dataGlobalId + 1 < lastDataGlobalId) {
         /* holes in data packets */
         hasHole = true;
         *m_debugStream->GetStream () << "Holes(dataGlobalId): " << lastDataGlobalId << " " << info->m_dataGlobalId << std::endl;
-      } else if (m_isRecovery && Uint16Less (info->m_globalId, m_curContRxHighestGlobalId)) {
+      } else if (m_isRecovery && info->m_globalId < m_curContRxHighestGlobalId) {
         /* dataGlobalId is continuous, but fec packets might be lost */
         hasHole = true;
         *m_debugStream->GetStream () << "Holes(globalId): " << m_curContRxHighestGlobalId << " " << info->m_globalId << std::endl;
@@ -758,7 +907,7 @@ void GameServer::RcvACKPacket (Ptr<AckPacket> ackPkt) {
   for (Ptr<GroupPacketInfo> pktInfo : pktInfos) {
    if (!m_isRecovery) {
       m_curContRxHighestGlobalId = pktInfo->m_globalId;
-      if (Uint16Less (int (m_curRxHighestGlobalId) + 1, pktInfo->m_globalId)) {
+      if (m_curRxHighestGlobalId + 1 < pktInfo->m_globalId) {
         m_isRecovery = true;
       }
     }
@@ -780,7 +929,7 @@ void GameServer::RcvACKPacket (Ptr<AckPacket> ackPkt) {
       if (senderInfo->m_groupId == pktInfo->m_groupId && senderInfo->m_pktIdInGroup == pktInfo->m_pktIdInGroup) {
         if (senderInfo->m_globalId == pktInfo->m_globalId) {
           it = m_dataPktHistoryKey.erase (it);
-          if (Uint16Less (m_curRxHighestDataGlobalId, senderInfo->m_dataGlobalId))
+          if (m_curRxHighestDataGlobalId < senderInfo->m_dataGlobalId)
             m_curRxHighestDataGlobalId = senderInfo->m_dataGlobalId;
         } else
           senderInfo->m_state = GroupPacketInfo::PacketState::RCVD_PREV_DATA;
@@ -810,6 +959,38 @@ void GameServer::RcvFrameAckPacket (Ptr<FrameAckPacket> frameAckPkt) {
   m_frameIdToGroupId.erase (frameId);
 };
 
+void GameServer::RcvRtxRequestPacket (Ptr<RtxRequestPacket> rtxReqPkt) {
+  if (!m_nackRtx)
+    return;
+  Time now = Simulator::Now ();
+  auto statistic = m_sender->GetNetworkStatistics ();
+
+  std::unordered_map<uint32_t, std::unordered_set<uint16_t>> rtxPktIds;
+  for (auto info : rtxReqPkt->GetRequestedPktInfos ()) {
+    /* acknowledged or expired since */
+    if (m_dataPktHistory.find (info->m_groupId) == m_dataPktHistory.end ())
+      continue;
+    auto groupDataPkt = &m_dataPktHistory[info->m_groupId];
+    for (const auto& [pktId, dataPkt] : *groupDataPkt) {
+      if (info->m_pktIdInGroup != RtxRequestPacket::WHOLE_GROUP && info->m_pktIdInGroup != pktId)
+        continue;
+      /* sent again after the receiver sent the request */
+      if (now - dataPkt->GetEnqueueTime () < statistic->minRtt)
+        continue;
+      if (MissesDdl (dataPkt))
+        continue;
+      rtxPktIds[info->m_groupId].insert (pktId);
+    }
+  }
+
+  for (const auto& [groupId, pktIds] : rtxPktIds) {
+    /* retransmitted now rather than after the dispersion */
+    m_delayedRtxGroup.erase (groupId);
+    RetransmitGroup (groupId, pktIds);
+    *m_debugStream->GetStream () << "NACK retransmit group " << groupId << " packets " << pktIds.size () << std::endl;
+  }
+};
+
 Ptr<Socket> GameServer::GetSocket() {
   return m_socket;
 };
@@ -817,13 +998,15 @@ Ptr<Socket> GameServer::GetSocket() {
 FECPolicy::FECParam GameServer::GetFECParam (
     uint16_t maxGroupSize, uint32_t bitrate,
     Time ddlLeft, bool fixGroupSize,
-    bool isRtx, uint8_t frameSize
+    bool isRtx, uint16_t frameSize
   ) {
   m_sender->GetNetworkStatistics ()->curLossRate = m_lossEstimator->GetLoss (Simulator::Now ());
   auto fecParam = m_fecPolicy->GetFECParam (m_sender->GetNetworkStatistics (), bitrate, 
     m_delayDdl.GetMilliSeconds (), (uint16_t) floor (ddlLeft.GetMicroSeconds () / 1e3), 
     isRtx, frameSize, maxGroupSize, fixGroupSize);
   m_curFecParam = fecParam;
+  if (!isRtx)
+    m_mediaFecRate = fecParam.fec_rate;
   return fecParam;
 };
 
@@ -831,25 +1014,46 @@ FECPolicy::FECParam GameServer::GetFECParam (
 void GameServer::UpdateBitrate(){
   if(!this->m_cc_enable) return;
   m_sender->UpdateSendingRate ();
-  double_t bitrate = m_sender->GetSendingRate ();
-  m_ccaQuotaPkt = bitrate / 8.0 / this->fps / DataPacket::GetMaxPayloadSize ();
-  if (m_ccaQuotaPkt > 50) {
-    bitrate = bitrate * 50 / m_ccaQuotaPkt;
-    m_ccaQuotaPkt = 50;
-  }
-  double last_goodput_ratio = m_sender->GetGoodputRatio ();
-  NS_ASSERT_MSG(last_goodput_ratio<=1 , "Goodput ratio must not be greater than 1");
-
-  double_t goodput_ratio = 0.5;
-  bitrate *= goodput_ratio;
-
-  m_encoder->SetBitrate((uint32_t)(bitrate / 1000.));
+  double_t sendBps = m_sender->GetSendingRate ();
+  uint16_t payloadSize = m_maxPayloadSize;
+
+  /* all packets of the next frame interval, CreatePacketBatch clips the FEC
+     packets of the frame with what the data packets leave of it */
+  m_ccaQuotaPkt = sendBps / 8.0 / this->fps / payloadSize;
+
+  /* queued retransmissions go out before the next frame */
+  double_t rtxBps = MIN (sendBps, m_sender->GetQueuedRtxPackets () * payloadSize * 8.0 * this->fps);
+
+  /* media share: what the queued retransmissions and the FEC policy currently
+     leave, or the measured goodput share of the sent bytes if lower. The
+     measured share already counts the retransmissions, so it applies to the
+     whole sending rate */
+  m_goodput_ratio = m_sender->GetGoodputRatio ();
+  NS_ASSERT_MSG(m_goodput_ratio<=1 , "Goodput ratio must not be greater than 1");
+  double_t redundancy = m_mediaFecRate / (1 + m_mediaFecRate);
+  double_t mediaBps = MIN ((sendBps - rtxBps) * (1 - redundancy), sendBps * m_goodput_ratio);
+
+  /* the data packet count of a frame is kept in 16 bits */
+  double_t mediaPkt = mediaBps / 8.0 / this->fps / payloadSize;
+  if (mediaPkt > UINT16_MAX)
+    mediaBps = mediaBps * UINT16_MAX / mediaPkt;
+
+  NS_LOG_FUNCTION ("[Allocator] send " << sendBps << " rtx " << rtxBps
+    << " redundancy " << redundancy << " media " << mediaBps << " quota " << m_ccaQuotaPkt);
+  m_encoder->SetBitrate((uint32_t)(mediaBps / 1000.));
 };
 
 void GameServer::OutputStatistics() {
   NS_LOG_ERROR("[Server] Total Frames: " << this->send_frame_cnt);
   NS_LOG_ERROR("[Server] [Result] Total Frames: " << this->send_frame_cnt - 10);
   NS_LOG_ERROR("[Server] Total Groups: " << this->send_group_cnt);
+  if (m_windowEncoder != NULL)
+    NS_LOG_ERROR("[Server] Window FEC repairs: " << m_windowEncoder->GetRepairCount ());
+  if (m_codec != NULL) {
+    std::ostringstream report;
+    m_codec->Report (report);
+    NS_LOG_ERROR("[Server] " << report.str ());
+  }
 }
 
 }; // namespace ns3
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "packet-sender.h"
 #include "video-encoder.h"
 #include "ns3/fec-policy.h"
+#include "ns3/fec-codec.h"
+#include "ns3/window-fec.h"
 #include "ns3/application.h"
 #include "ns3/network-module.h"
 #include "ns3/internet-module.h"
@@ -14,6 +16,7 @@
 #include <vector>
 #include <deque>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace ns3 {
 
@@ -62,6 +65,72 @@ public:
         Ptr<OutputStreamWrapper> debugcStream
     );
     void SetController(CC_ALG);
+    /**
+     * \brief Mark the outgoing packets as ECN-capable. Call before the start.
+     *
+     * \param ect ECN codepoint, 1 for ECT(1) (L4S) or 2 for ECT(0), 0 to disable
+     */
+    void SetEcn(uint8_t ect);
+    /**
+     * \brief Size of the media packets of this flow, headers included. Call
+     * after Setup, which takes ns3::NetworkPacket::MaxPacketSize.
+     *
+     * \param size packet size in bytes
+     */
+    void SetPacketSize(uint16_t size);
+    /**
+     * \brief Replace the default encoder with a FrameTraceEncoder. Call after Setup.
+     *
+     * \param traceFile per-frame size trace, see FrameTraceEncoder
+     * \param rcDelay encoder rate-control response time
+     */
+    void SetFrameTrace(std::string traceFile, Time rcDelay);
+    /**
+     * \brief Real payload mode: data packets carry generated frame bytes and
+     * the FEC packets repair symbols encoded over them. Call after Setup.
+     *
+     * \param codec encodes the FEC packets of every batch, NULL to simulate
+     * the payload sizes only (default)
+     */
+    void SetFecCodec(Ptr<FecCodec> codec);
+    /**
+     * \brief Sliding-window FEC: first transmissions are protected by repairs
+     * over the recent data packets across frames (see WindowFecEncoder)
+     * instead of the FEC packets of their batch, at the rate of the FEC
+     * policy. Retransmissions keep the batch FEC. Call after Setup and
+     * SetPacketSize.
+     *
+     * \param maxWindow data packets covered by a repair at most; 0 disables
+     * it (default). The window also shrinks so that the repair header takes
+     * at most a tenth of a data packet.
+     */
+    void SetWindowFec(uint16_t maxWindow);
+    /**
+     * \brief Fresh-repair retransmission: a group is retransmitted as new
+     * FEC packets over its data packets not acknowledged yet, as many as
+     * them plus the redundancy of the FEC policy, instead of the data
+     * packets themselves. Any of them, as many as the packets still missing,
+     * complete the group (see PacketGroup), whichever packets were lost.
+     *
+     * \param enable false by default
+     */
+    void SetFreshRepairRtx(bool enable);
+    /**
+     * \brief Receiver-driven retransmission: the packets NACKed by the
+     * client (see GameClient::SetNack) are retransmitted as soon as the
+     * request arrives, and the sender no longer looks for holes in the ACKs.
+     * The retransmission timer is kept for lost requests.
+     *
+     * \param enable false by default
+     */
+    void SetNackRtx(bool enable);
+    /**
+     * \brief Use fixed random streams for this flow (sender and FEC policy).
+     * Call after Setup.
+     *
+     * \return number of streams used
+     */
+    int64_t AssignStreams(int64_t stream);
     void StopEncoding();
 protected:
     void DoDispose();
@@ -104,10 +173,10 @@ private:
         uint32_t, std::deque<uint32_t>> m_frameIdToGroupId; /* frame_id -> group_id */
     /* Record how many data packets there are in a frame */
     /* frame id -> data packet count */
-    std::unordered_map<uint32_t, uint8_t> m_frameDataPktCnt;
-    uint16_t m_curRxHighestDataGlobalId;
-    uint16_t m_curRxHighestGlobalId;
-    uint16_t m_curContRxHighestGlobalId;
+    std::unordered_map<uint32_t, uint16_t> m_frameDataPktCnt;
+    uint64_t m_curRxHighestDataGlobalId;
+    uint64_t m_curRxHighestGlobalId;
+    uint64_t m_curContRxHighestGlobalId;
     bool m_isRecovery;
     std::unordered_map<uint32_t, Time> m_delayedRtxGroup;
     Time m_lastRtt;
@@ -133,16 +202,22 @@ private:
     /* Congestion Control-related variables */
     bool m_cc_enable;
     CC_ALG m_cc_algorithm;
+    uint8_t m_ect;                  /* ECN codepoint of the sent packets */
     Timer m_cc_timer;
     Time m_cc_interval;
 
-    int m_ccaQuotaPkt;
+    int m_ccaQuotaPkt;      /* packets the CC allows for the next frame, media, FEC and RTX */
+    double_t m_mediaFecRate;    /* FEC rate of the last first-transmission group */
 
     FECPolicy::FECParam m_curFecParam; /* record the latest FEC parameters for encoding bitrate convertion */
 
     float m_goodput_ratio; /* (data pkt number / all pkts sent) in a time window */
 
-    uint32_t m_maxPayloadSize;
+    uint32_t m_maxPayloadSize;     /* frame bytes carried by a data packet */
+    Ptr<FecCodec> m_codec;          /* real payload mode, NULL otherwise */
+    Ptr<WindowFecEncoder> m_windowEncoder;  /* sliding-window FEC mode, NULL otherwise */
+    bool m_freshRepairRtx;          /* retransmit repairs instead of data packets */
+    bool m_nackRtx;                 /* retransmit on the requests of the receiver */
 
     // statistics
     uint64_t send_group_cnt;
@@ -203,6 +278,11 @@ private:
 
     Time GetDispersion (Ptr<DataPacket> pkt);
 
+    /**
+     * \brief Largest batch, data and FEC packets, the FEC code can protect
+     */
+    uint16_t GetMaxBatchSize ();
+
     bool IsRtxTimeout (Ptr<DataPacket> packet, Time rto);
 
 
@@ -215,7 +295,12 @@ private:
 
     void SendPackets(std::deque<Ptr<DataPacket>> pkts, Time ddl_left, uint32_t frame_id, bool is_rtx);
 
-    void RetransmitGroup(uint32_t);
+    /**
+     * \brief Retransmit the data packets of a group not acknowledged yet
+     *
+     * \param pktIds only these packet ids in the group, all if empty
+     */
+    void RetransmitGroup(uint32_t groupId, const std::unordered_set<uint16_t> & pktIds = std::unordered_set<uint16_t> ());
 
     /**
      * \brief Check for packets to be retransmitted regularly
@@ -227,7 +312,7 @@ private:
         uint16_t max_group_size, 
         uint32_t bitrate,
         Time ddl_left, bool fix_group_size,
-        bool is_rtx, uint8_t frame_size
+        bool is_rtx, uint16_t frame_size
     );
 
 public:
@@ -248,6 +333,12 @@ public:
 
     void RcvFrameAckPacket (Ptr<FrameAckPacket> frameAckPkt);
 
+    /**
+     * \brief Process NACK packet: retransmit the requested packets still in
+     * the history
+     */
+    void RcvRtxRequestPacket (Ptr<RtxRequestPacket> rtxReqPkt);
+
     /**
      * \brief For packet_sender to get the UDP socket
      *
@@ -256,7 +347,10 @@ public:
     Ptr<Socket> GetSocket();
 
     /**
-     * @brief Update sending bitrate in CC controller and report to video encoder.
+     * @brief Update sending bitrate in CC controller and split it between the
+     * video encoder and the FEC and retransmission packets: the encoder gets
+     * what the queued retransmissions and the expected FEC redundancy leave,
+     * or the measured goodput share of the sending rate if smaller.
      *
      */
     void UpdateBitrate();
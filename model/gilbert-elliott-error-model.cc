@@ -0,0 +1,127 @@
+#include "gilbert-elliott-error-model.h"
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "ns3/simulator.h"
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("GilbertElliottErrorModel");
+
+TypeId GilbertElliottErrorModel::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::GilbertElliottErrorModel")
+        .SetParent<ErrorModel> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<GilbertElliottErrorModel> ()
+        .AddAttribute ("GoodToBad", "Probability p of moving from the good to the bad state",
+                       DoubleValue (0),
+                       MakeDoubleAccessor (&GilbertElliottErrorModel::m_p),
+                       MakeDoubleChecker<double> (0, 1))
+        .AddAttribute ("BadToGood", "Probability r of moving from the bad to the good state",
+                       DoubleValue (1),
+                       MakeDoubleAccessor (&GilbertElliottErrorModel::m_r),
+                       MakeDoubleChecker<double> (0, 1))
+        .AddAttribute ("GoodLossRate", "Loss rate in the good state",
+                       DoubleValue (0),
+                       MakeDoubleAccessor (&GilbertElliottErrorModel::m_goodLoss),
+                       MakeDoubleChecker<double> (0, 1))
+        .AddAttribute ("BadLossRate", "Loss rate in the bad state",
+                       DoubleValue (1),
+                       MakeDoubleAccessor (&GilbertElliottErrorModel::m_badLoss),
+                       MakeDoubleChecker<double> (0, 1))
+        .AddAttribute ("MeanBurstLength", "Mean loss burst length in packets when the trace "
+                       "only gives the loss rate, 0 for independent losses",
+                       DoubleValue (0),
+                       MakeDoubleAccessor (&GilbertElliottErrorModel::m_meanBurstLength),
+                       MakeDoubleChecker<double> (0))
+    ;
+    return tid;
+};
+
+GilbertElliottErrorModel::GilbertElliottErrorModel ()
+: m_p {0}
+, m_r {1}
+, m_goodLoss {0}
+, m_badLoss {1}
+, m_meanBurstLength {0}
+, m_bad {false}
+, m_traceStore {NULL}
+, m_traceStart {Time (0)}
+, m_traceInterval {MilliSeconds (16)}
+{
+    m_rv = CreateObject<UniformRandomVariable> ();
+};
+
+GilbertElliottErrorModel::~GilbertElliottErrorModel () {};
+
+void GilbertElliottErrorModel::SetTraceStore (Ptr<TraceStore> store, Time start, Time interval) {
+    NS_ASSERT (interval.IsStrictlyPositive ());
+    m_traceStore = store;
+    m_traceStart = start;
+    m_traceInterval = interval;
+};
+
+void GilbertElliottErrorModel::SetParams (double_t p, double_t r) {
+    NS_ASSERT (p >= 0 && p <= 1 && r >= 0 && r <= 1);
+    m_p = p;
+    m_r = r;
+};
+
+int64_t GilbertElliottErrorModel::AssignStreams (int64_t stream) {
+    m_rv->SetStream (stream);
+    return 1;
+};
+
+bool GilbertElliottErrorModel::IsBad () const {
+    return m_bad;
+};
+
+void GilbertElliottErrorModel::GetParams (double_t & p, double_t & r, double_t & goodLoss, double_t & badLoss) const {
+    p = m_p;
+    r = m_r;
+    goodLoss = m_goodLoss;
+    badLoss = m_badLoss;
+    if (m_traceStore == NULL)
+        return;
+
+    Time elapsed = Simulator::Now () - m_traceStart;
+    uint64_t index = elapsed.IsNegative () ? 0 : elapsed.GetTimeStep () / m_traceInterval.GetTimeStep ();
+    index = MIN (index, (uint64_t) m_traceStore->GetSize () - 1);
+
+    double_t traceP = m_traceStore->GetGoodToBad (index);
+    if (!std::isnan (traceP)) {
+        p = traceP;
+        r = m_traceStore->GetBadToGood (index);
+        return;
+    }
+    double_t loss = m_traceStore->GetLossRate (index);
+    goodLoss = 0;
+    badLoss = 1;
+    if (m_meanBurstLength <= 0) {
+        /* independent losses: stay in the good state */
+        p = 0;
+        goodLoss = loss;
+        return;
+    }
+    /* stationary loss rate p / (p + r) equals the loss rate of the sample */
+    r = 1. / MAX (m_meanBurstLength, 1.);
+    p = loss >= 1 ? 1 : MIN (r * loss / (1 - loss), 1.);
+};
+
+bool GilbertElliottErrorModel::DoCorrupt (Ptr<Packet> pkt) {
+    double_t p, r, goodLoss, badLoss;
+    GetParams (p, r, goodLoss, badLoss);
+    if (m_bad) {
+        if (m_rv->GetValue () < r)
+            m_bad = false;
+    }
+    else {
+        if (m_rv->GetValue () < p)
+            m_bad = true;
+    }
+    return m_rv->GetValue () < (m_bad ? badLoss : goodLoss);
+};
+
+void GilbertElliottErrorModel::DoReset () {
+    m_bad = false;
+};
+
+}; // namespace ns3
@@ -0,0 +1,63 @@
+#ifndef GILBERT_ELLIOTT_ERROR_MODEL_H
+#define GILBERT_ELLIOTT_ERROR_MODEL_H
+
+#include "common-header.h"
+#include "trace-store.h"
+#include "ns3/error-model.h"
+#include "ns3/nstime.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+/**
+ * \brief Two-state (Gilbert-Elliott) burst loss model.
+ *
+ * Before each packet the state moves good->bad with probability p or
+ * bad->good with probability r, then the packet is lost with the loss rate
+ * of the state. The parameters come from, in order of precedence:
+ *  - the "<p> <r>" columns of the current sample of a bound TraceStore;
+ *  - the loss rate of the current sample and MeanBurstLength, with r =
+ *    1 / MeanBurstLength and p chosen so that the mean loss rate matches;
+ *  - the GoodToBad / BadToGood attributes.
+ * A packet costs two draws from one RNG stream, see AssignStreams.
+ */
+class GilbertElliottErrorModel : public ErrorModel {
+public:
+    static TypeId GetTypeId (void);
+    GilbertElliottErrorModel ();
+    ~GilbertElliottErrorModel ();
+
+    /**
+     * \brief Take the parameters from the trace sample of the current time
+     */
+    void SetTraceStore (Ptr<TraceStore> store, Time start, Time interval);
+
+    void SetParams (double_t p, double_t r);
+
+    int64_t AssignStreams (int64_t stream);
+
+    bool IsBad () const;
+
+private:
+    bool DoCorrupt (Ptr<Packet> p) override;
+    void DoReset () override;
+
+    void GetParams (double_t & p, double_t & r, double_t & goodLoss, double_t & badLoss) const;
+
+    double_t m_p;           /* good -> bad */
+    double_t m_r;           /* bad -> good */
+    double_t m_goodLoss;
+    double_t m_badLoss;
+    double_t m_meanBurstLength;
+    bool m_bad;
+
+    Ptr<TraceStore> m_traceStore;
+    Time m_traceStart;
+    Time m_traceInterval;
+
+    Ptr<UniformRandomVariable> m_rv;
+};  // class GilbertElliottErrorModel
+
+};  // namespace ns3
+
+#endif  /* GILBERT_ELLIOTT_ERROR_MODEL_H */
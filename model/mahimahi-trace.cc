@@ -0,0 +1,134 @@
+#include "mahimahi-trace.h"
+#include "trace-store.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include <cstdlib>
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("MahimahiTrace");
+
+TypeId MahimahiTrace::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::MahimahiTrace")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<MahimahiTrace> ()
+    ;
+    return tid;
+};
+
+MahimahiTrace::MahimahiTrace ()
+: m_path {""}
+, m_period {0}
+, m_offset {0}
+, m_last {0}
+{};
+
+MahimahiTrace::~MahimahiTrace () {};
+
+void MahimahiTrace::Open (std::string path) {
+    m_path = path;
+    m_file.open (path);
+    if (m_file.fail ())
+        NS_FATAL_ERROR ("Mahimahi trace fail to open! " + path);
+    m_period = 0;
+    m_offset = 0;
+    m_last = 0;
+};
+
+bool MahimahiTrace::ReadLine (uint64_t & ts) {
+    std::string line;
+    while (std::getline (m_file, line)) {
+        const char * p = line.c_str ();
+        char * end;
+        unsigned long long v = std::strtoull (p, &end, 10);
+        if (end == p)
+            continue;
+        ts = v;
+        return true;
+    }
+    return false;
+};
+
+uint64_t MahimahiTrace::Next () {
+    uint64_t ts;
+    if (!ReadLine (ts)) {
+        /* end of the trace, start over with the last timestamp as the period */
+        if (m_period == 0)
+            m_period = m_last - m_offset;
+        if (m_period == 0)
+            NS_FATAL_ERROR ("Mahimahi trace must end with a positive timestamp! " + m_path);
+        m_offset += m_period;
+        m_file.clear ();
+        m_file.seekg (0);
+        if (!ReadLine (ts))
+            NS_FATAL_ERROR ("Mahimahi trace is empty! " + m_path);
+    }
+    uint64_t next = m_offset + ts;
+    NS_ASSERT_MSG (next >= m_last, "Mahimahi trace timestamps must be non-decreasing");
+    m_last = next;
+    return next;
+};
+
+uint64_t MahimahiTrace::ToSampleTrace (std::string mmPath, std::string outPath,
+    uint16_t interval, double_t rtt, double_t loss) {
+    std::ifstream in (mmPath);
+    if (in.fail ())
+        NS_FATAL_ERROR ("Mahimahi trace fail to open! " + mmPath);
+    std::ofstream out (outPath, std::ios::trunc);
+    if (out.fail ())
+        NS_FATAL_ERROR ("Trace file fail to open! " + outPath);
+
+    uint64_t sample = 0;        /* index of the sample being counted */
+    uint64_t count = 0;         /* opportunities in the sample */
+    std::string line;
+    auto writeSample = [&] () {
+        out << count * k_mtu * 8. / (interval * 1e3) << "Mbps " << rtt << "ms " << loss << "\n";
+        count = 0;
+        sample ++;
+    };
+    while (std::getline (in, line)) {
+        const char * p = line.c_str ();
+        char * end;
+        uint64_t ts = std::strtoull (p, &end, 10);
+        if (end == p)
+            continue;
+        while (ts >= (sample + 1) * interval)
+            writeSample ();
+        count ++;
+    }
+    if (count > 0)
+        writeSample ();
+    return sample;
+};
+
+uint64_t MahimahiTrace::FromSampleTrace (std::string inPath, std::string mmPath, uint16_t interval) {
+    std::ifstream in (inPath);
+    if (in.fail ())
+        NS_FATAL_ERROR ("Trace file fail to open! " + inPath);
+    std::ofstream out (mmPath, std::ios::trunc);
+    if (out.fail ())
+        NS_FATAL_ERROR ("Mahimahi trace fail to open! " + mmPath);
+
+    uint64_t now = 0;           /* in ms */
+    uint64_t written = 0;
+    double_t credit = 0;        /* fractional opportunities carried over */
+    std::string line;
+    float bw, rtt, loss;
+    while (std::getline (in, line)) {
+        if (!TraceStore::ParseLine (line, bw, rtt, loss))
+            continue;
+        double_t perMs = bw * 1e6 / 8 / k_mtu / 1e3;
+        for (uint16_t i = 0; i < interval; i++, now++) {
+            credit += perMs;
+            while (credit >= 1) {
+                out << now << "\n";
+                credit -= 1;
+                written ++;
+            }
+        }
+    }
+    return written;
+};
+
+}; // namespace ns3
@@ -0,0 +1,66 @@
+#ifndef MAHIMAHI_TRACE_H
+#define MAHIMAHI_TRACE_H
+
+#include "common-header.h"
+#include "ns3/object.h"
+#include <cmath>
+#include <fstream>
+#include <string>
+
+namespace ns3 {
+
+/**
+ * \brief Streaming reader of a Mahimahi packet-delivery trace, one
+ * millisecond timestamp per delivery opportunity of k_mtu bytes.
+ *
+ * Only the current line is kept in memory. As in Mahimahi, the trace is
+ * repeated with a period of its last timestamp once it is exhausted.
+ */
+class MahimahiTrace : public Object {
+public:
+    static TypeId GetTypeId (void);
+    MahimahiTrace ();
+    ~MahimahiTrace ();
+
+    /* bytes that can be delivered at one opportunity, as PACKET_SIZE in Mahimahi */
+    static const uint32_t k_mtu = 1504;
+
+    void Open (std::string path);
+
+    /**
+     * \brief Time of the next delivery opportunity in ms, non-decreasing
+     */
+    uint64_t Next ();
+
+    /**
+     * \brief Convert a Mahimahi trace into the "<bw>Mbps <rtt>ms <loss>" format
+     *
+     * \param interval sample duration in ms
+     * \param rtt RTT written to every sample in ms
+     * \param loss loss rate written to every sample
+     * \return number of samples written
+     */
+    static uint64_t ToSampleTrace (std::string mmPath, std::string outPath,
+        uint16_t interval, double_t rtt, double_t loss);
+
+    /**
+     * \brief Convert a "<bw>Mbps <rtt>ms <loss>" trace into a Mahimahi trace,
+     * spreading the opportunities of a sample evenly over its interval
+     *
+     * \return number of delivery opportunities written
+     */
+    static uint64_t FromSampleTrace (std::string inPath, std::string mmPath, uint16_t interval);
+
+private:
+    bool ReadLine (uint64_t & ts);
+
+    std::string m_path;
+    std::ifstream m_file;
+    uint64_t m_period;      /* last timestamp of the trace */
+    uint64_t m_offset;      /* m_period * number of completed loops */
+    uint64_t m_last;
+};  // class MahimahiTrace
+
+};  // namespace ns3
+
+#endif  /* MAHIMAHI_TRACE_H */
@@ -14,7 +14,7 @@ TypeId GroupPacketInfo::GetTypeId() {
 
 GroupPacketInfo::GroupPacketInfo () {};
 
-GroupPacketInfo::GroupPacketInfo (uint32_t groupId, uint16_t pktIdInGroup, uint16_t dataGlobalId, uint16_t globalId,
+GroupPacketInfo::GroupPacketInfo (uint32_t groupId, uint16_t pktIdInGroup, uint64_t dataGlobalId, uint64_t globalId,
     uint8_t txCnt) {
     m_groupId = groupId;
     m_pktIdInGroup = pktIdInGroup;
@@ -298,6 +298,178 @@ void FECPacketHeader::Print (std::ostream &os) const {
     }
 };
 
+/* class WindowPktDigest */
+TypeId WindowPktDigest::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::WindowPktDigest")
+        .SetParent<DataPktDigest> ()
+        .SetGroupName("sparkrtc")
+    ;
+    return tid;
+};
+
+WindowPktDigest::~WindowPktDigest() {};
+
+// class WindowFECPacketHeader
+TypeId WindowFECPacketHeader::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::WindowFECPacketHeader")
+        .SetParent<Header> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<WindowFECPacketHeader> ()
+    ;
+    return tid;
+};
+
+WindowFECPacketHeader::WindowFECPacketHeader() : repair_id {0} {};
+WindowFECPacketHeader::~WindowFECPacketHeader() {};
+
+TypeId WindowFECPacketHeader::GetInstanceTypeId (void) const { return GetTypeId(); };
+
+bool WindowFECPacketHeader::ContinuesRun(Ptr<WindowPktDigest> prev, Ptr<WindowPktDigest> next) {
+    return next->frame_id == prev->frame_id && next->frame_pkt_num == prev->frame_pkt_num
+        && next->pkt_id_in_frame == prev->pkt_id_in_frame + 1
+        && next->group_id == prev->group_id && next->group_data_num == prev->group_data_num
+        && next->group_fec_num == prev->group_fec_num && next->pkt_id_in_group == prev->pkt_id_in_group + 1
+        && next->batch_id == prev->batch_id && next->batch_data_num == prev->batch_data_num
+        && next->batch_fec_num == prev->batch_fec_num && next->pkt_id_in_batch == prev->pkt_id_in_batch + 1
+        && next->encode_time.GetMilliSeconds() == prev->encode_time.GetMilliSeconds();
+};
+
+uint16_t WindowFECPacketHeader::GetRunLength(size_t first) const {
+    uint16_t run = 1;
+    while(first + run < this->data_pkts.size()
+        && ContinuesRun(this->data_pkts[first + run - 1], this->data_pkts[first + run]))
+        run ++;
+    return run;
+};
+
+uint32_t WindowFECPacketHeader::GetSerializedSize () const {
+    uint32_t run_num = 0;
+    for(size_t i = 0; i < this->data_pkts.size(); i += this->GetRunLength(i))
+        run_num ++;
+    return 4 + 2 + run_num * (2 + 2 + 2 + 4 + 2 + 2 + 4 + 2 + 2 + 4 + 2 + 2 + 4);
+};
+
+void WindowFECPacketHeader::Serialize (Buffer::Iterator start) const {
+    uint16_t run_num = 0;
+    for(size_t i = 0; i < this->data_pkts.size(); i += this->GetRunLength(i))
+        run_num ++;
+    start.WriteHtonU32(this->repair_id);
+    start.WriteHtonU16(run_num);
+    for(size_t i = 0; i < this->data_pkts.size();) {
+        uint16_t run = this->GetRunLength(i);
+        auto digest = this->data_pkts[i];
+        start.WriteHtonU16(run);
+        start.WriteHtonU16(digest->pkt_id_in_batch);
+        start.WriteHtonU16(digest->pkt_id_in_group);
+        start.WriteHtonU32(digest->frame_id);
+        start.WriteHtonU16(digest->frame_pkt_num);
+        start.WriteHtonU16(digest->pkt_id_in_frame);
+        start.WriteHtonU32(digest->group_id);
+        start.WriteHtonU16(digest->group_data_num);
+        start.WriteHtonU16(digest->group_fec_num);
+        start.WriteHtonU32(digest->batch_id);
+        start.WriteHtonU16(digest->batch_data_num);
+        start.WriteHtonU16(digest->batch_fec_num);
+        start.WriteHtonU32(digest->encode_time.GetMilliSeconds());
+        i += run;
+    }
+};
+
+uint32_t WindowFECPacketHeader::Deserialize (Buffer::Iterator start) {
+    uint32_t read_size = 6;
+    this->repair_id = start.ReadNtohU32();
+    uint16_t run_num = start.ReadNtohU16();
+    while(run_num>0) {
+        uint16_t run = start.ReadNtohU16();
+        Ptr<WindowPktDigest> first = Create<WindowPktDigest> ();
+        first->pkt_id_in_batch = start.ReadNtohU16();
+        first->pkt_id_in_group = start.ReadNtohU16();
+        first->frame_id = start.ReadNtohU32();
+        first->frame_pkt_num = start.ReadNtohU16();
+        first->pkt_id_in_frame = start.ReadNtohU16();
+        first->group_id = start.ReadNtohU32();
+        first->group_data_num = start.ReadNtohU16();
+        first->group_fec_num = start.ReadNtohU16();
+        first->batch_id = start.ReadNtohU32();
+        first->batch_data_num = start.ReadNtohU16();
+        first->batch_fec_num = start.ReadNtohU16();
+        first->encode_time = MilliSeconds(start.ReadNtohU32());
+        // the other packets of the run follow the first one
+        for(uint16_t i = 0; i < run; i++) {
+            Ptr<WindowPktDigest> digest = Create<WindowPktDigest> (*first);
+            digest->pkt_id_in_batch += i;
+            digest->pkt_id_in_group += i;
+            digest->pkt_id_in_frame += i;
+            this->data_pkts.push_back(digest);
+        }
+        read_size += 34;
+        run_num--;
+    }
+    return read_size;
+};
+
+void WindowFECPacketHeader::Print (std::ostream &os) const {
+    os << "this->repair_id" << this->repair_id;
+    os << "Window Size=" << this->data_pkts.size();
+    for(auto digest : this->data_pkts) {
+        os << "digest->group_id" << digest->group_id;
+        os << "digest->pkt_id_in_group" << digest->pkt_id_in_group;
+        os << "digest->batch_id" << digest->batch_id;
+        os << "digest->pkt_id_in_batch" << digest->pkt_id_in_batch;
+        os << "digest->frame_id" << digest->frame_id;
+        os << "digest->pkt_id_in_frame" << digest->pkt_id_in_frame;
+    }
+};
+
+
+// class RtxRequestPacketHeader
+TypeId RtxRequestPacketHeader::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::RtxRequestPacketHeader")
+        .SetParent<Header> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<RtxRequestPacketHeader> ()
+    ;
+    return tid;
+};
+
+RtxRequestPacketHeader::RtxRequestPacketHeader() : frame_req {0}, rtx_frame_id {0} {};
+RtxRequestPacketHeader::~RtxRequestPacketHeader() {};
+
+TypeId RtxRequestPacketHeader::GetInstanceTypeId (void) const { return GetTypeId(); };
+
+uint32_t RtxRequestPacketHeader::GetSerializedSize () const {
+    return sizeof(this->frame_req) + sizeof(this->rtx_frame_id) + sizeof(uint16_t) +
+        this->pkt_infos.size() * 6 /* group id and packet id in group */;
+};
+
+void RtxRequestPacketHeader::Serialize (Buffer::Iterator start) const {
+    start.WriteU8(this->frame_req);
+    start.WriteHtonU32(this->rtx_frame_id);
+    start.WriteHtonU16(this->pkt_infos.size());
+    for(auto pkt_info : this->pkt_infos) {
+        start.WriteHtonU32 (pkt_info->m_groupId);
+        start.WriteHtonU16 (pkt_info->m_pktIdInGroup);
+    }
+};
+
+uint32_t RtxRequestPacketHeader::Deserialize (Buffer::Iterator start) {
+    this->frame_req = start.ReadU8();
+    this->rtx_frame_id = start.ReadNtohU32();
+    uint16_t pktInfoCnt = start.ReadNtohU16();
+    for (uint16_t i = 0; i < pktInfoCnt; i++) {
+        Ptr<GroupPacketInfo> pkt = Create<GroupPacketInfo> ();
+        pkt->m_groupId = start.ReadNtohU32();
+        pkt->m_pktIdInGroup = start.ReadNtohU16();
+        this->pkt_infos.push_back(pkt);
+    }
+    return GetSerializedSize();
+};
+
+void RtxRequestPacketHeader::Print (std::ostream &os) const {
+    os << "Rtx request for " << this->pkt_infos.size() << " packets";
+    if(this->frame_req)
+        os << ", frame id: " << this->rtx_frame_id;
+};
 
 // class AckPacketHeader
 TypeId AckPacketHeader::GetTypeId() {
@@ -425,7 +597,7 @@ NetStatePacketHeader::~NetStatePacketHeader() {};
 TypeId NetStatePacketHeader::GetInstanceTypeId (void) const { return GetTypeId(); };
 
 uint32_t NetStatePacketHeader::GetSerializedSize () const {
-    return 12 + 4 * netstates->loss_seq.size() + 8 * netstates->recvtime_hist.size();
+    return 12 + 4 * netstates->loss_seq.size() + 9 * netstates->recvtime_hist.size();
 };
 
 void NetStatePacketHeader::Serialize (Buffer::Iterator start) const {
@@ -446,8 +618,9 @@ void NetStatePacketHeader::Serialize (Buffer::Iterator start) const {
     }
     start.WriteHtonU16(this->netstates->recvtime_hist.size());
     for(auto recvtime : this->netstates->recvtime_hist) {
-        start.WriteHtonU32(recvtime->pkt_id);
+        start.WriteHtonU32((uint32_t) recvtime->pkt_id);
         start.WriteHtonU32(recvtime->rt_us);
+        start.WriteU8(recvtime->ecn);
     }
 };
 
@@ -475,9 +648,10 @@ uint32_t NetStatePacketHeader::Deserialize (Buffer::Iterator start) {
     while(hist_size>0) {
         uint32_t pkt_id = start.ReadNtohU32();
         uint32_t pkt_rcvtime = start.ReadNtohU32();
-        Ptr<RcvTime> rt = Create<RcvTime>(pkt_id, pkt_rcvtime, 0);
+        uint8_t ecn = start.ReadU8();
+        Ptr<RcvTime> rt = Create<RcvTime>(pkt_id, pkt_rcvtime, 0, ecn);
         netstate->recvtime_hist.push_back(rt);
-        read_size += 8;
+        read_size += 9;
         hist_size--;
     }
     this->netstates = netstate;
@@ -497,6 +671,63 @@ void NetStatePacketHeader::Print (std::ostream &os) const {
     for(auto recvtime : this->netstates->recvtime_hist) {
         os << "Packet ID=" << recvtime->pkt_id;
         os << "Receive time(us)=" << recvtime->rt_us;
+        os << "ECN=" << unsigned(recvtime->ecn);
+    }
+};
+
+// class DelayHintPacketHeader
+TypeId DelayHintPacketHeader::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::DelayHintPacketHeader")
+        .SetParent<Header> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<DelayHintPacketHeader> ()
+    ;
+    return tid;
+};
+
+DelayHintPacketHeader::DelayHintPacketHeader()
+: queue_delay_us {0}
+, dequeue_rate_kbps {0}
+, hints {}
+{};
+DelayHintPacketHeader::~DelayHintPacketHeader() {};
+
+TypeId DelayHintPacketHeader::GetInstanceTypeId (void) const { return GetTypeId(); };
+
+uint32_t DelayHintPacketHeader::GetSerializedSize () const {
+    return 10 + 8 * this->hints.size();
+};
+
+void DelayHintPacketHeader::Serialize (Buffer::Iterator start) const {
+    start.WriteHtonU32(this->queue_delay_us);
+    start.WriteHtonU32(this->dequeue_rate_kbps);
+    start.WriteHtonU16(this->hints.size());
+    for(auto hint : this->hints) {
+        start.WriteHtonU32((uint32_t) hint->pkt_id);
+        start.WriteHtonU32(hint->rt_us);
+    }
+};
+
+uint32_t DelayHintPacketHeader::Deserialize (Buffer::Iterator start) {
+    this->queue_delay_us = start.ReadNtohU32();
+    this->dequeue_rate_kbps = start.ReadNtohU32();
+    uint16_t hint_size = start.ReadNtohU16();
+    this->hints.clear();
+    for(uint16_t i = 0; i < hint_size; i++) {
+        uint32_t pkt_id = start.ReadNtohU32();
+        uint32_t rt_us = start.ReadNtohU32();
+        this->hints.push_back(Create<RcvTime>(pkt_id, rt_us, 0));
+    }
+    return 10 + 8 * hint_size;
+};
+
+void DelayHintPacketHeader::Print (std::ostream &os) const {
+    os << "Queue delay(us)=" << this->queue_delay_us;
+    os << "Dequeue rate(kbps)=" << this->dequeue_rate_kbps;
+    os << "Delay hints for " << this->hints.size() << " packets";
+    for(auto hint : this->hints) {
+        os << "Packet ID=" << hint->pkt_id;
+        os << "Predicted receive time(us)=" << hint->rt_us;
     }
 };
 
@@ -15,21 +15,22 @@ class DataPacket;
 
 class GroupPacketInfo : public Object {
 public:
-    enum PacketState {INFLIGHT, RCVD_PREV_DATA};
+    /* REPAIR_INFLIGHT: retransmitted as fresh repairs, out of the data global id order */
+    enum PacketState {INFLIGHT, RCVD_PREV_DATA, REPAIR_INFLIGHT};
     static TypeId GetTypeId (void);
     uint32_t m_groupId;
     uint16_t m_pktIdInGroup;
-    uint16_t m_dataGlobalId;
-    uint16_t m_globalId;
+    uint64_t m_dataGlobalId;    /* extended, see SeqUnwrapper */
+    uint64_t m_globalId;
     uint8_t m_txCnt;
     PacketState m_state;
     GroupPacketInfo ();
-    GroupPacketInfo (uint32_t group_id, uint16_t pktIdInGroup, uint16_t dataGlobalId, uint16_t globalId, 
+    GroupPacketInfo (uint32_t group_id, uint16_t pktIdInGroup, uint64_t dataGlobalId, uint64_t globalId, 
         uint8_t txCnt = 0);
     ~GroupPacketInfo ();
 };
 
-enum PacketType { DATA_PKT, DUP_FEC_PKT, FEC_PKT, RTX_REQ_PKT, ACK_PKT, FRAME_ACK_PKT, NETSTATE_PKT };
+enum PacketType { DATA_PKT, DUP_FEC_PKT, FEC_PKT, RTX_REQ_PKT, ACK_PKT, FRAME_ACK_PKT, NETSTATE_PKT, DELAY_HINT_PKT, WIN_FEC_PKT };
 
 class NetworkPacketHeader : public SimpleRefCount<NetworkPacketHeader,Header> {
 private:
@@ -149,10 +150,49 @@ public:
     void Print (std::ostream &os) const;
 };  // class FECPacket
 
+/* Digest of a data packet covered by a sliding-window repair: the window
+ * spans groups and batches, so each digest carries them */
+class WindowPktDigest : public DataPktDigest {
+public:
+    static TypeId GetTypeId (void);
+    uint32_t group_id;
+    uint16_t group_data_num;
+    uint16_t group_fec_num;
+    uint32_t batch_id;
+    uint16_t batch_data_num;
+    uint16_t batch_fec_num;
+    Time encode_time;
+    WindowPktDigest();
+    WindowPktDigest(Ptr<DataPacket> pkt);
+    ~WindowPktDigest();
+};
+
+/* On the wire the digests are grouped in runs of consecutive packets of a
+ * batch, each run sent as its first digest and its length */
+class WindowFECPacketHeader : public SimpleRefCount<WindowFECPacketHeader,Header> {
+private:
+    uint32_t repair_id;         /* seeds the coefficients of the repair, see WindowFecEncoder */
+    std::vector<Ptr<WindowPktDigest>> data_pkts;
+    /* next is the packet after prev in the same frame, group and batch */
+    static bool ContinuesRun(Ptr<WindowPktDigest> prev, Ptr<WindowPktDigest> next);
+    uint16_t GetRunLength(size_t first) const;
+public:
+    friend class WindowFECPacket;
+    static TypeId GetTypeId (void);
+    WindowFECPacketHeader();
+    ~WindowFECPacketHeader();
+    TypeId GetInstanceTypeId (void) const;
+    uint32_t GetSerializedSize (void) const;
+    void Serialize (Buffer::Iterator start) const;
+    uint32_t Deserialize (Buffer::Iterator start);
+    void Print (std::ostream &os) const;
+};  // class WindowFECPacketHeader
+
 class RtxRequestPacketHeader : public SimpleRefCount<RtxRequestPacketHeader,Header> {
 private:
     uint8_t frame_req; // request retransmission of a whole frame or group
     uint32_t rtx_frame_id;
+    /* missing data packets, or RtxRequestPacket::WHOLE_GROUP for a group none of which arrived */
     std::vector<Ptr<GroupPacketInfo>> pkt_infos;
 public:
     friend class RtxRequestPacket;
@@ -200,15 +240,17 @@ public:
 
 class RcvTime : public Object {
 public:
-    RcvTime(uint32_t pkt_id_, uint32_t rt_us_, uint32_t pkt_size_) {
+    RcvTime(uint64_t pkt_id_, uint32_t rt_us_, uint32_t pkt_size_, uint8_t ecn_ = 0) {
         this->pkt_id = pkt_id_;
         this->rt_us = rt_us_;
         this->pkt_size = pkt_size_;
+        this->ecn = ecn_;
     };
     ~RcvTime() {};
-    uint32_t pkt_id;
+    uint64_t pkt_id;    /* extended global id at the receiver, its low 32 bits on the wire */
     uint32_t rt_us;
     uint32_t pkt_size;
+    uint8_t ecn;    /* ECN codepoint of the IP header as received, CE = 3 */
 }; // class RcvTime
 
 class NetStates : public Object {
@@ -241,6 +283,23 @@ public:
 
 };  // class NetStatePacketHeader
 
+class DelayHintPacketHeader : public SimpleRefCount<DelayHintPacketHeader,Header> {
+private:
+    uint32_t queue_delay_us;        /* predicted queuing delay of the last hinted packet */
+    uint32_t dequeue_rate_kbps;     /* estimated dequeue rate of the bottleneck */
+    std::vector<Ptr<RcvTime>> hints;    /* predicted arrival time of each packet */
+public:
+    friend class DelayHintPacket;
+    static TypeId GetTypeId (void);
+    DelayHintPacketHeader();
+    ~DelayHintPacketHeader();
+    TypeId GetInstanceTypeId (void) const;
+    uint32_t GetSerializedSize (void) const;
+    void Serialize (Buffer::Iterator start) const;
+    uint32_t Deserialize (Buffer::Iterator start);
+    void Print (std::ostream &os) const;
+};  // class DelayHintPacketHeader
+
 };  // namespace ns3
 
 #endif  /* NETWORK_PACKET_HEADER_H */
\ No newline at end of file
@@ -24,6 +24,7 @@ NetworkPacket::NetworkPacket(PacketType packet_type) {
     this->network_payload.payload_size = 0;
     this->send_time = MicroSeconds(0);
     this->rcv_time = MicroSeconds(0);
+    this->m_payloadData = NULL;
 };
 
 NetworkPacket::~NetworkPacket() {};
@@ -43,7 +44,12 @@ uint16_t NetworkPacket::GetMaxPayloadSize() {
     Ptr<NetworkPacket> netPkt = CreateObject<NetworkPacket> (PacketType::DATA_PKT);
     UintegerValue maxPacketSize;
     netPkt->GetAttribute ("MaxPacketSize", maxPacketSize);
-    return maxPacketSize.Get () - 4; 
+    return GetMaxPayloadSize (maxPacketSize.Get ());
+};
+
+uint16_t NetworkPacket::GetMaxPayloadSize(uint16_t packet_size) {
+    NS_ASSERT_MSG(packet_size > 50, "Packet size must leave room for the headers");
+    return packet_size - 4;
 };
 
 uint32_t NetworkPacket::GetPayloadSize() { return this->network_payload.payload_size; };
@@ -51,11 +57,24 @@ uint32_t NetworkPacket::GetPayloadSize() { return this->network_payload.payload_
 uint8_t * NetworkPacket::GetPayloadPtr() { return this->network_payload.payload_buffer; };
 
 void NetworkPacket::SetPayload(uint8_t * buffer, uint32_t size) {
-    NS_ASSERT(size <= NetworkPacket::GetMaxPayloadSize());
+    // the packet size is set per flow, MaxPacketSize is only its default
+    NS_ASSERT(size <= NetworkPacket::GetMaxPayloadSize(UINT16_MAX));
     this->network_payload.payload_buffer = buffer;
     this->network_payload.payload_size = size;
 }
 
+void NetworkPacket::SetPayloadData(Ptr<Packet> data) { this->m_payloadData = data; };
+
+Ptr<Packet> NetworkPacket::GetPayloadData() { return this->m_payloadData; };
+
+std::vector<uint8_t> NetworkPacket::CopyPayloadData() {
+    if(this->m_payloadData == NULL)
+        return std::vector<uint8_t> ();
+    std::vector<uint8_t> data(this->m_payloadData->GetSize());
+    this->m_payloadData->CopyData(data.data(), data.size());
+    return data;
+};
+
 // static
 Ptr<NetworkPacket> NetworkPacket::ToInstance(Ptr<Packet> packet) {
     NetworkPacketHeader network_header = NetworkPacketHeader();
@@ -68,12 +87,18 @@ Ptr<NetworkPacket> NetworkPacket::ToInstance(Ptr<Packet> packet) {
         return Create<DupFECPacket> (packet);
     case PacketType::FEC_PKT:
         return Create<FECPacket> (packet);
+    case PacketType::WIN_FEC_PKT:
+        return Create<WindowFECPacket> (packet);
+    case PacketType::RTX_REQ_PKT:
+        return Create<RtxRequestPacket> (packet);
     case PacketType::ACK_PKT:
         return Create<AckPacket> (packet);
     case PacketType::FRAME_ACK_PKT:
         return Create<FrameAckPacket> (packet);
     case PacketType::NETSTATE_PKT:
         return Create<NetStatePacket> (packet);
+    case PacketType::DELAY_HINT_PKT:
+        return Create<DelayHintPacket> (packet);
     default:
         return nullptr; //casually defined
     }
@@ -145,6 +170,7 @@ uint16_t VideoPacket::GetPktIdBatch() { return this->video_header.pkt_id_in_batc
 uint8_t VideoPacket::GetTXCount() { return this->video_header.tx_count; };
 
 uint16_t VideoPacket::GetMaxPayloadSize() { return NetworkPacket::GetMaxPayloadSize () - 38; };
+uint16_t VideoPacket::GetMaxPayloadSize(uint16_t packet_size) { return NetworkPacket::GetMaxPayloadSize (packet_size) - 38; };
 
 Ptr<Packet> VideoPacket::ToNetPacket () {
     NS_FATAL_ERROR ("Virtual function called");
@@ -160,6 +186,18 @@ DataPktDigest::DataPktDigest(Ptr<DataPacket> pkt) {
     this->pkt_id_in_frame = pkt->GetPktIdFrame();
 };
 
+WindowPktDigest::WindowPktDigest() {};
+
+WindowPktDigest::WindowPktDigest(Ptr<DataPacket> pkt) : DataPktDigest(pkt) {
+    this->group_id = pkt->GetGroupId();
+    this->group_data_num = pkt->GetGroupDataNum();
+    this->group_fec_num = pkt->GetGroupFECNum();
+    this->batch_id = pkt->GetBatchId();
+    this->batch_data_num = pkt->GetBatchDataNum();
+    this->batch_fec_num = pkt->GetBatchFECNum();
+    this->encode_time = pkt->GetEncodeTime();
+};
+
 /* class DataPacket */
 TypeId DataPacket::GetTypeId() {
     static TypeId tid = TypeId ("ns3::DataPacket")
@@ -180,13 +218,14 @@ DataPacket::DataPacket(Ptr<Packet> packet) : VideoPacket(PacketType::DATA_PKT) {
     packet->RemoveHeader(this->video_header);
     packet->RemoveHeader(this->data_header);
     //packet->RemoveTrailer(this->network_payload);
+    this->m_payloadData = packet;
 };
 
 DataPacket::~DataPacket() {};
 
 Ptr<Packet> DataPacket::ToNetPacket() {
     uint32_t packet_size = this->GetPayloadSize();
-    Ptr<Packet> packet = Create<Packet> (packet_size);
+    Ptr<Packet> packet = this->m_payloadData != NULL ? this->m_payloadData->Copy() : Create<Packet> (packet_size);
     packet->AddHeader(this->data_header);
     packet->AddHeader(this->video_header);
     packet->AddHeader(this->network_header);
@@ -206,6 +245,10 @@ DataPacket::DataPacket(Ptr<DataPktDigest> data_pkt_digest,
 };
 
 uint16_t DataPacket::GetMaxPayloadSize() { return VideoPacket::GetMaxPayloadSize() - 8; };
+uint16_t DataPacket::GetMaxPayloadSize(uint16_t packet_size) { return VideoPacket::GetMaxPayloadSize(packet_size) - 8; };
+
+uint32_t DataPacket::GetFecProtectedSize() { return this->data_header.GetSerializedSize() + this->GetPayloadSize(); };
+
 
 void DataPacket::SetFrameInfo(uint32_t frame_id, uint16_t frame_pkt_num, uint16_t pkt_id_in_frame) {
     this->data_header.frame_id = frame_id;
@@ -219,8 +262,8 @@ uint32_t DataPacket::GetFrameId() { return this->data_header.frame_id; };
 uint16_t DataPacket::GetFramePktNum() { return this->data_header.frame_pkt_num; };
 uint16_t DataPacket::GetPktIdFrame() { return this->data_header.pkt_id_in_frame; };
 bool DataPacket::GetLastPktMark() { return this->data_header.last_pkt_mark; };
-void DataPacket::SetDataGlobalId (uint16_t id) { m_dataGlobalId = id; };
-uint16_t DataPacket::GetDataGlobalId () { return m_dataGlobalId; };
+void DataPacket::SetDataGlobalId (uint64_t id) { m_dataGlobalId = id; };
+uint64_t DataPacket::GetDataGlobalId () { return m_dataGlobalId; };
 
 
 /* class DupFECPacket */
@@ -258,22 +301,30 @@ TypeId FECPacket::GetTypeId() {
 
 FECPacket::FECPacket(uint8_t tx_count, std::vector<Ptr<DataPacket>> data_pkts) : VideoPacket(PacketType::FEC_PKT) {
     this->SetTXCount(tx_count);
-    for(auto data_pkt : data_pkts) {
-        this->fec_header.data_pkts.push_back(Create<DataPktDigest> (data_pkt));
-    }
+    this->protected_size = 0;
+    this->SetDataPackets(data_pkts);
 };
 
 FECPacket::FECPacket(Ptr<Packet> packet) : VideoPacket(PacketType::FEC_PKT) {
+    this->protected_size = 0;
     // NetworkPacketHeader has been removed in NetworkPacket::ToInstance
     packet->RemoveHeader(this->video_header);
     packet->RemoveHeader(this->fec_header);
     //packet->RemoveTrailer(this->network_payload);
+    this->m_payloadData = packet;
 };
 
 FECPacket::~FECPacket() {};
 
 Ptr<Packet> FECPacket::ToNetPacket() {
-    Ptr<Packet> packet = Create<Packet> ( - this->GetHeaderLength() + VideoPacket::GetMaxPayloadSize());
+    Ptr<Packet> packet;
+    if(this->m_payloadData != NULL)
+        packet = this->m_payloadData->Copy();   /* the repair symbol */
+    else {
+        /* sizes only: as large as the largest protected data packet, digests included */
+        uint32_t header_length = this->fec_header.GetSerializedSize();
+        packet = Create<Packet> (this->protected_size > header_length ? this->protected_size - header_length : 0);
+    }
     packet->AddHeader(this->fec_header);
     packet->AddHeader(this->video_header);
     packet->AddHeader(this->network_header);
@@ -282,19 +333,67 @@ Ptr<Packet> FECPacket::ToNetPacket() {
     return packet;
 };
 
-uint32_t FECPacket::GetHeaderLength() {
-    return 2 /* size */ + this->fec_header.data_pkts.size() * (2 + 2 + 4 + 2 + 2);
-};
-
 std::vector<Ptr<DataPktDigest>> FECPacket::GetDataPacketDigests() { return this->fec_header.data_pkts; };
 
 void FECPacket::SetDataPackets(std::vector<Ptr<DataPacket>> data_pkts) {
     for(auto data_pkt : data_pkts) {
         this->fec_header.data_pkts.push_back(Create<DataPktDigest> (data_pkt));
+        this->protected_size = MAX(this->protected_size, data_pkt->GetFecProtectedSize());
     }
 };
 
 
+/* class WindowFECPacket */
+TypeId WindowFECPacket::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::WindowFECPacket")
+        .SetParent<VideoPacket> ()
+        .SetGroupName("sparkrtc")
+    ;
+    return tid;
+};
+
+WindowFECPacket::WindowFECPacket(uint32_t repair_id, std::vector<Ptr<DataPacket>> data_pkts) : VideoPacket(PacketType::WIN_FEC_PKT) {
+    this->SetTXCount(0);
+    this->protected_size = 0;
+    this->win_fec_header.repair_id = repair_id;
+    for(auto data_pkt : data_pkts) {
+        this->win_fec_header.data_pkts.push_back(Create<WindowPktDigest> (data_pkt));
+        this->protected_size = MAX(this->protected_size, data_pkt->GetFecProtectedSize());
+    }
+};
+
+WindowFECPacket::WindowFECPacket(Ptr<Packet> packet) : VideoPacket(PacketType::WIN_FEC_PKT) {
+    this->protected_size = 0;
+    // NetworkPacketHeader has been removed in NetworkPacket::ToInstance
+    packet->RemoveHeader(this->video_header);
+    packet->RemoveHeader(this->win_fec_header);
+    this->m_payloadData = packet;
+};
+
+WindowFECPacket::~WindowFECPacket() {};
+
+Ptr<Packet> WindowFECPacket::ToNetPacket() {
+    Ptr<Packet> packet;
+    if(this->m_payloadData != NULL)
+        packet = this->m_payloadData->Copy();   /* the repair symbol */
+    else {
+        /* sizes only: as large as the largest protected data packet, digests included */
+        uint32_t header_length = this->win_fec_header.GetSerializedSize();
+        packet = Create<Packet> (this->protected_size > header_length ? this->protected_size - header_length : 0);
+    }
+    packet->AddHeader(this->win_fec_header);
+    packet->AddHeader(this->video_header);
+    packet->AddHeader(this->network_header);
+    return packet;
+};
+
+uint32_t WindowFECPacket::GetHeaderLength() { return this->win_fec_header.GetSerializedSize(); };
+
+uint32_t WindowFECPacket::GetRepairId() { return this->win_fec_header.repair_id; };
+
+std::vector<Ptr<WindowPktDigest>> WindowFECPacket::GetDataPacketDigests() { return this->win_fec_header.data_pkts; };
+
+
 /* class ControlPacket */
 TypeId ControlPacket::GetTypeId() {
     static TypeId tid = TypeId ("ns3::ControlPacket")
@@ -360,6 +459,46 @@ uint16_t AckPacket::GetLastPktId() {
 };
 
 
+/* class RtxRequestPacket */
+TypeId RtxRequestPacket::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::RtxRequestPacket")
+        .SetParent<ControlPacket> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<RtxRequestPacket> ()
+    ;
+    return tid;
+};
+
+RtxRequestPacket::RtxRequestPacket() : ControlPacket(PacketType::RTX_REQ_PKT) {
+
+};
+
+RtxRequestPacket::RtxRequestPacket(Ptr<Packet> packet) : ControlPacket(PacketType::RTX_REQ_PKT) {
+    // NetworkPacketHeader has been removed in NetworkPacket::ToInstance
+    packet->RemoveHeader(this->rtx_req_header);
+};
+
+RtxRequestPacket::RtxRequestPacket(std::vector<Ptr<GroupPacketInfo>> pkt_infos) : ControlPacket(PacketType::RTX_REQ_PKT) {
+    for(auto pkt_info : pkt_infos) {
+        Ptr<GroupPacketInfo> pkt = Create<GroupPacketInfo> (*pkt_info);
+        this->rtx_req_header.pkt_infos.push_back(pkt);
+    }
+};
+
+RtxRequestPacket::~RtxRequestPacket() {};
+
+Ptr<Packet> RtxRequestPacket::ToNetPacket() {
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader(this->rtx_req_header);
+    packet->AddHeader(this->network_header);
+    return packet;
+};
+
+std::vector<Ptr<GroupPacketInfo>> RtxRequestPacket::GetRequestedPktInfos() {
+    return this->rtx_req_header.pkt_infos;
+};
+
+
 /* class FrameAckPacket */
 TypeId FrameAckPacket::GetTypeId() {
     static TypeId tid = TypeId ("ns3::FrameAckPacket")
@@ -444,4 +583,50 @@ void NetStatePacket::SetNetStates(Ptr<NetStates> netstate) {
     this->net_state_header.netstates = netstate;
 };
 
+/* class DelayHintPacket */
+TypeId DelayHintPacket::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::DelayHintPacket")
+        .SetParent<ControlPacket> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<DelayHintPacket> ()
+    ;
+    return tid;
+};
+
+DelayHintPacket::DelayHintPacket() : ControlPacket(PacketType::DELAY_HINT_PKT) {
+};
+
+DelayHintPacket::DelayHintPacket(Ptr<Packet> packet) : ControlPacket(PacketType::DELAY_HINT_PKT) {
+    // NetworkPacketHeader has been removed in NetworkPacket::ToInstance
+    packet->RemoveHeader(this->hint_header);
+};
+
+DelayHintPacket::DelayHintPacket(std::vector<Ptr<RcvTime>> hints, Time queue_delay, uint32_t dequeue_rate_kbps)
+    : ControlPacket(PacketType::DELAY_HINT_PKT) {
+    this->hint_header.hints = hints;
+    this->hint_header.queue_delay_us = queue_delay.GetMicroSeconds();
+    this->hint_header.dequeue_rate_kbps = dequeue_rate_kbps;
+};
+
+DelayHintPacket::~DelayHintPacket() {};
+
+Ptr<Packet> DelayHintPacket::ToNetPacket() {
+    Ptr<Packet> packet = Create<Packet> ();
+    packet->AddHeader(this->hint_header);
+    packet->AddHeader(this->network_header);
+    return packet;
+};
+
+std::vector<Ptr<RcvTime>> DelayHintPacket::GetHints() {
+    return this->hint_header.hints;
+};
+
+Time DelayHintPacket::GetQueueDelay() {
+    return MicroSeconds(this->hint_header.queue_delay_us);
+};
+
+uint32_t DelayHintPacket::GetDequeueRateKbps() {
+    return this->hint_header.dequeue_rate_kbps;
+};
+
 } // namespace ns3
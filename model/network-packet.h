@@ -53,9 +53,18 @@ protected:
     NetworkPacketPayload network_payload;
 public:
     static uint16_t GetMaxPayloadSize();
+    static uint16_t GetMaxPayloadSize(uint16_t packet_size);
     uint32_t GetPayloadSize();
     uint8_t * GetPayloadPtr();
     void SetPayload(uint8_t *, uint32_t);
+
+/* Payload bytes, real payload mode only (see FecCodec) */
+protected:
+    Ptr<Packet> m_payloadData;  /* NULL if only the payload size is simulated; at the receiver, what follows the headers */
+public:
+    void SetPayloadData(Ptr<Packet>);
+    Ptr<Packet> GetPayloadData();
+    std::vector<uint8_t> CopyPayloadData();
 };  // class NetworkPacket
 
 
@@ -106,6 +115,7 @@ public:
     uint8_t GetTXCount();
 
     static uint16_t GetMaxPayloadSize();
+    static uint16_t GetMaxPayloadSize(uint16_t packet_size);
 };  // class VideoPacket
 
 
@@ -143,9 +153,14 @@ public:
 
 protected:
     DataPacketHeader data_header;
-    uint16_t m_dataGlobalId;    /* dataGlobalId is used for all data packets, including rtx ones bu excluding fec */
+    uint64_t m_dataGlobalId;    /* dataGlobalId is used for all data packets, including rtx ones bu excluding fec. Sender only, never wraps */
 public:
     static uint16_t GetMaxPayloadSize();
+    static uint16_t GetMaxPayloadSize(uint16_t packet_size);
+    /**
+     * \brief Bytes covered by the FEC packets of the batch: data header and payload
+     */
+    uint32_t GetFecProtectedSize();
     void SetFrameInfo(uint32_t frame_id, uint16_t frame_pkt_num, uint16_t pkt_id_in_frame);
     void SetLastPkt(bool);
 
@@ -153,8 +168,8 @@ public:
     uint16_t GetFramePktNum();
     uint16_t GetPktIdFrame();
     bool GetLastPktMark();
-    void SetDataGlobalId (uint16_t);
-    uint16_t GetDataGlobalId ();
+    void SetDataGlobalId (uint64_t);
+    uint64_t GetDataGlobalId ();
 
 };  // class DataPacket
 
@@ -178,14 +193,36 @@ public:
     Ptr<Packet> ToNetPacket();
 protected:
     FECPacketHeader fec_header;
-private:
-    uint32_t GetHeaderLength();
+    uint32_t protected_size;    /* as large as the largest protected data packet */
 public:
     std::vector<Ptr<DataPktDigest>> GetDataPacketDigests();
     void SetDataPackets(std::vector<Ptr<DataPacket>> data_pkts);
 };  // class FECPacket
 
 
+/**
+ * \brief Repair packet of the sliding-window FEC (see WindowFecEncoder): a
+ * random linear combination of the recent data packets, across batches,
+ * groups and frames
+ */
+class WindowFECPacket : public VideoPacket {
+public:
+    static TypeId GetTypeId (void);
+    WindowFECPacket(uint32_t repair_id, std::vector<Ptr<DataPacket>> data_pkts);
+    WindowFECPacket(Ptr<Packet>);
+    ~WindowFECPacket();
+    Ptr<Packet> ToNetPacket();
+protected:
+    WindowFECPacketHeader win_fec_header;
+    uint32_t protected_size;    /* as large as the largest protected data packet */
+public:
+    /* header listing the covered packets, in runs of consecutive packets */
+    uint32_t GetHeaderLength();
+    uint32_t GetRepairId();
+    std::vector<Ptr<WindowPktDigest>> GetDataPacketDigests();
+};  // class WindowFECPacket
+
+
 class ControlPacket : public NetworkPacket {
 public:
     static TypeId GetTypeId (void);
@@ -210,6 +247,26 @@ public:
     uint16_t GetLastPktId();
 };
 
+/**
+ * \brief NACK of the receiver-driven retransmission mode: the data packets
+ * the receiver found missing, batched over groups (see GameClient::SetNack).
+ */
+class RtxRequestPacket : public ControlPacket {
+public:
+    /* packet id in group requesting every packet of the group */
+    static constexpr uint16_t WHOLE_GROUP = -1;
+    static TypeId GetTypeId (void);
+    RtxRequestPacket();
+    RtxRequestPacket(Ptr<Packet>);
+    RtxRequestPacket(std::vector<Ptr<GroupPacketInfo>>);
+    ~RtxRequestPacket();
+    Ptr<Packet> ToNetPacket();
+protected:
+    RtxRequestPacketHeader rtx_req_header;
+public:
+    std::vector<Ptr<GroupPacketInfo>> GetRequestedPktInfos();
+};
+
 class FrameAckPacket : public ControlPacket {
 public:
     static TypeId GetTypeId (void);
@@ -239,6 +296,27 @@ public:
     void SetNetStates(Ptr<NetStates>);
 };  // class NetStatePacket
 
+/**
+ * \brief Feedback generated by a router in front of the bottleneck (see
+ * ZhugeAgent): the predicted arrival time of each forwarded media packet,
+ * sent to the media sender as if it came from the receiver
+ */
+class DelayHintPacket : public ControlPacket {
+public:
+    static TypeId GetTypeId (void);
+    DelayHintPacket();
+    DelayHintPacket(Ptr<Packet>);
+    DelayHintPacket(std::vector<Ptr<RcvTime>> hints, Time queue_delay, uint32_t dequeue_rate_kbps);
+    ~DelayHintPacket();
+    Ptr<Packet> ToNetPacket();
+protected:
+    DelayHintPacketHeader hint_header;
+public:
+    std::vector<Ptr<RcvTime>> GetHints();
+    Time GetQueueDelay();
+    uint32_t GetDequeueRateKbps();
+};  // class DelayHintPacket
+
 };  // namespace ns3
 
 #endif  /* NETWORK_PACKET_H */
\ No newline at end of file
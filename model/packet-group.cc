@@ -1,102 +1,7 @@
 #include "packet-group.h"
 
 namespace ns3 {
-NS_LOG_COMPONENT_DEFINE("PacketBatch");
-
-TypeId PacketBatch::GetTypeId() {
-    static TypeId tid = TypeId ("ns3::PacketBatch")
-        .SetParent<Object> ()
-        .SetGroupName("sparkrtc")
-    ;
-    return tid;
-};
-
-PacketBatch::PacketBatch(Ptr<VideoPacket> pkt, Ptr<PacketGroup> packet_group) {
-    this->packet_group = packet_group;
-    // Batch info
-    this->batch_id = pkt->GetBatchId();
-    this->data_num = pkt->GetBatchDataNum();
-    this->fec_num = pkt->GetBatchFECNum();
-    NS_ASSERT_MSG(this->data_num>0, "Must have at least 1 packet in PacketBatch");
-    // Add packet
-    this->AddPacket(pkt);
-};
-
-PacketBatch::~PacketBatch() {
-
-};
-
-void PacketBatch::AddPacket(Ptr<VideoPacket> pkt) {
-    uint16_t pkt_id = pkt->GetPktIdBatch();
-    if(this->decoded_pkts.find(pkt_id) != this->decoded_pkts.end())
-        return;
-
-    auto packet_type = pkt->GetPacketType();
-    if(packet_type == PacketType::DATA_PKT) {
-        // data packet, can be passed to decoder directly
-        Ptr<DataPacket> data_pkt = DynamicCast<DataPacket, VideoPacket> (pkt);
-        this->data_pkts[pkt_id] = data_pkt;
-        this->undecoded_pkts.push_back(data_pkt);
-    } else if(packet_type == PacketType::DUP_FEC_PKT) {
-        // actually the same as data packet
-        Ptr<DupFECPacket> dup_fec_pkt = DynamicCast<DupFECPacket, VideoPacket> (pkt);
-        this->data_pkts[pkt_id] = dup_fec_pkt;
-        this->undecoded_pkts.push_back(dup_fec_pkt);
-    } else if(packet_type == PacketType::FEC_PKT)
-        this->fec_pkts[pkt_id] = DynamicCast<FECPacket, VideoPacket> (pkt);
-};
-
-bool PacketBatch::CheckComplete() {
-    // DEBUG("[PacketBatch] batch id: " << this->batch_id << ", batch_data_num: " << this->data_num << ", current data pkt num:" << this->data_pkts.size() << ", current fec pkt num:" << this->fec_pkts.size());
-    // FEC calculation here
-    // DEBUG("data size: " << this->data_pkts.size() << ", FEC size: " << this->fec_pkts.size() << ", DATA num: " << this->data_num <<"\n";
-
-    if(this->data_pkts.size() + this->fec_pkts.size() >= this->data_num) {
-        if(this->data_pkts.size() == this->data_num){
-            // all data packets arrived
-            return true;
-        } else {
-            // recover data from FEC
-            // Assume every FEC packet stores data of all other data packets
-            NS_ASSERT(this->fec_pkts.size() > 0);
-            Time now = Simulator::Now();
-            auto data_pkt_digests = this->fec_pkts.begin()->second->GetDataPacketDigests();
-            for(auto data_pkt_digest : data_pkt_digests) {
-                // std::cout << "[PacketBatch] in FEC packets: pkt_id_in_batch: " << 
-                //     data_pkt_digest->pkt_id_in_batch << "pkt_id_in_group: " << 
-                //     data_pkt_digest->pkt_id_in_group <<'\n';
-                if(this->data_pkts.find(data_pkt_digest->pkt_id_in_batch) == this->data_pkts.end()) {
-                    // data packet not exists in this->data_pkts
-                    Ptr<DataPacket> data_pkt = Create<DataPacket> (
-                        data_pkt_digest,
-                        this->packet_group->GetGroupId(), this->packet_group->GetDataNum(), this->packet_group->GetFECNum(),
-                        this->batch_id, this->data_num, this->fec_num
-                    );
-                    data_pkt->SetRcvTime(now);
-                    data_pkt->SetEncodeTime(this->fec_pkts.begin()->second->GetEncodeTime());
-                    // std::cout << "[PacketBatch] group id: " << this->packet_group->GetGroupId() << ", batch id: " << this->batch_id <<
-                    //     ", pkt id: " << data_pkt->GetPktIdGroup());
-                    this->undecoded_pkts.push_back(data_pkt);
-                }
-            }
-            this->data_pkts.clear();
-            this->fec_pkts.clear();
-            return true;
-        }
-    }
-    return false;
-};
-
-std::vector<Ptr<DataPacket>> PacketBatch::GetUndecodedPackets() {
-    auto data_pkt_list = this->undecoded_pkts;
-    // clear this->undecoded_pkts
-    this->undecoded_pkts.clear();
-    // mark data packets as decoded
-    for(auto pkt : data_pkt_list)
-        this->decoded_pkts.insert(pkt->GetPktIdBatch());
-    // return those undecoded data packets
-    return data_pkt_list;
-};
+NS_LOG_COMPONENT_DEFINE("PacketGroup");
 
 TypeId PacketGroup::GetTypeId() {
     static TypeId tid = TypeId ("ns3::PacketGroup")
@@ -118,6 +23,11 @@ PacketGroup::PacketGroup(uint32_t group_id, uint16_t data_num, Time encode_time)
     this->rtx_data_count = 0;
     this->rtx_fec_count = 0;
     this->next_rtx_count = 1;
+    this->repair_cnt = 0;
+    this->recovered_cnt = 0;
+    this->decode_bytes = 0;
+    this->decode_cpu_ns = 0;
+    this->decode_recorded = false;
 };
 
 PacketGroup::PacketGroup(Ptr<VideoPacket> pkt, Time group_delay) {
@@ -131,6 +41,11 @@ PacketGroup::PacketGroup(Ptr<VideoPacket> pkt, Time group_delay) {
     this->rtx_data_count = 0;
     this->rtx_fec_count = 0;
     this->next_rtx_count = 1;
+    this->repair_cnt = 0;
+    this->recovered_cnt = 0;
+    this->decode_bytes = 0;
+    this->decode_cpu_ns = 0;
+    this->decode_recorded = false;
     // Add packet
     this->AddPacket(pkt, group_delay);
 };
@@ -172,6 +87,31 @@ uint16_t PacketGroup::GetRtxFECCount() { return this->rtx_fec_count; };
 
 std::unordered_map<uint8_t, uint32_t> PacketGroup::GetPktArriveDistribution() { return this->pkt_arrive_dis; };
 
+Time PacketGroup::GetExpectedCompletionTime() { return this->expected_completion_time; };
+
+std::vector<uint16_t> PacketGroup::GetMissingDataIds() {
+    // the pivot of each pending equation is determined once the other packets arrive
+    auto pivots = this->solver.GetPivots();
+    std::unordered_set<uint16_t> pivot_ids(pivots.begin(), pivots.end());
+    std::vector<uint16_t> missing;
+    for(uint16_t pkt_id = 0; pkt_id < this->data_num; pkt_id++)
+        if(!this->solver.IsKnown(pkt_id) && pivot_ids.find(pkt_id) == pivot_ids.end())
+            missing.push_back(pkt_id);
+    return missing;
+};
+
+void PacketGroup::SetFecCodec(Ptr<FecCodec> codec) { this->codec = codec; };
+
+Ptr<FecCodec> PacketGroup::GetFecCodec() { return this->codec; };
+
+
+void PacketGroup::UpdateExpectedCompletionTime(Ptr<VideoPacket> pkt, Time group_delay) {
+    // the rest of its batch follows at the group delay
+    int32_t pkts_left = pkt->GetBatchDataNum() + pkt->GetBatchFECNum() - 1 - pkt->GetPktIdBatch();
+    Time expected = pkt->GetRcvTime() + MAX(pkts_left, 0) * group_delay;
+    if(expected > this->expected_completion_time)
+        this->expected_completion_time = expected;
+};
 
 void PacketGroup::AddPacket(Ptr<VideoPacket> pkt, Time group_delay) {
 
@@ -201,30 +141,101 @@ void PacketGroup::AddPacket(Ptr<VideoPacket> pkt, Time group_delay) {
         this->pkt_cnt_tx_0 ++;
     }
     if(pkt->GetPktIdGroup() > this->last_pkt_id_tx_0 && pkt->GetPktIdGroup() < data_num + fec_num && pkt->GetTXCount() == 0) this->last_pkt_id_tx_0 = pkt->GetPktIdGroup();
+    this->UpdateExpectedCompletionTime(pkt, group_delay);
 
-    uint32_t batch_id = pkt->GetBatchId();
     // if it's a useless packet for decoding, return
-    if(this->complete_batches.find(batch_id) != this->complete_batches.end()) return;
     if(this->decoded_pkts.find(pkt->GetPktIdGroup()) != this->decoded_pkts.end()) return;
 
-    // insert it into PacketBatch
-    if(this->incomplete_batches.find(batch_id) == this->incomplete_batches.end())
-        this->incomplete_batches[batch_id] = Create<PacketBatch> (pkt, this);
-    else
-        this->incomplete_batches[batch_id]->AddPacket(pkt);
-
-    // check if the batch is complete
-    bool batch_complete = this->incomplete_batches[batch_id]->CheckComplete();
-    // Get undecoded data packets and store it
-    auto batch_undecoded_pkts = this->incomplete_batches[batch_id]->GetUndecodedPackets();
-    this->undecoded_pkts.insert(
-        this->undecoded_pkts.end(), batch_undecoded_pkts.begin(), batch_undecoded_pkts.end()
-    );
-    // If complete, move the batch to complete_batches
-    if(batch_complete) {
-        this->complete_batches[batch_id] = this->incomplete_batches[batch_id];
-        this->incomplete_batches.erase(batch_id);
+    // data packets are passed to the decoder directly, FEC packets once they decode some
+    std::vector<LinearFecDecoder::SourceId> decoded;
+    if(packet_type == PacketType::DATA_PKT || packet_type == PacketType::DUP_FEC_PKT) {
+        Ptr<DataPacket> data_pkt = DynamicCast<DataPacket, VideoPacket> (pkt);
+        if(this->solver.IsKnown(data_pkt->GetPktIdGroup()))
+            return;
+        this->undecoded_pkts.push_back(data_pkt);
+        this->missing_pkts.erase(data_pkt->GetPktIdGroup());
+        FecCodec::Symbol symbol;
+        if(this->codec != NULL) {
+            auto payload = data_pkt->CopyPayloadData();
+            symbol.resize(payload.size() + 2);
+            FecCodec::ToSymbol(payload, symbol.size(), symbol.data());
+        }
+        uint64_t start = FecCodec::GetCpuTimeNs();
+        decoded = this->solver.AddSource(data_pkt->GetPktIdGroup(), symbol);
+        if(this->codec != NULL) this->decode_cpu_ns += FecCodec::GetCpuTimeNs() - start;
+    } else if(packet_type == PacketType::FEC_PKT)
+        decoded = this->AddRepair(DynamicCast<FECPacket, VideoPacket> (pkt));
+
+    Time now = Simulator::Now();
+    for(auto id : decoded) {
+        auto it = this->missing_pkts.find(id);
+        NS_ASSERT_MSG(it != this->missing_pkts.end(), "A decoded data packet must be known from a FEC packet");
+        Ptr<DataPacket> data_pkt = it->second;
+        data_pkt->SetRcvTime(now);
+        if(this->codec != NULL) {
+            auto & symbol = this->solver.GetSymbol(id);
+            FecCodec::Symbol payload;
+            FecCodec::FromSymbol(symbol.data(), symbol.size(), payload);
+            this->codec->CheckPayload(payload, data_pkt->GetFrameId(), data_pkt->GetPktIdFrame());
+            data_pkt->SetPayload(nullptr, payload.size());
+            data_pkt->SetPayloadData(Create<Packet> (payload.data(), payload.size()));
+            this->decode_bytes += payload.size();
+        }
+        this->undecoded_pkts.push_back(data_pkt);
+        this->missing_pkts.erase(it);
+        this->recovered_cnt ++;
+    }
+
+    if(this->decoded_pkts.size() + this->undecoded_pkts.size() == this->data_num)
+        this->RecordDecode();
+};
+
+std::vector<LinearFecDecoder::SourceId> PacketGroup::AddRepair(Ptr<FECPacket> fec_pkt) {
+    uint16_t batch_data_num = fec_pkt->GetBatchDataNum();
+    uint16_t batch_fec_num = fec_pkt->GetBatchFECNum();
+    // repair index of a FEC packet: its place after the data packets of the batch
+    uint16_t repair_idx = fec_pkt->GetPktIdBatch() - batch_data_num;
+    // sizes only: the RS coefficients, the server keeps the batches within FecCodec::k_maxRsBatch
+    FecCodec::CodeType type = this->codec != NULL ? this->codec->GetCodeType() : FecCodec::RS;
+
+    std::map<LinearFecDecoder::SourceId, uint8_t> coeffs;
+    for(auto digest : fec_pkt->GetDataPacketDigests()) {
+        uint16_t id = digest->pkt_id_in_group;
+        coeffs[id] = FecCodec::GetCoefficient(type, repair_idx, digest->pkt_id_in_batch, batch_data_num, batch_fec_num);
+        if(this->solver.IsKnown(id) || this->missing_pkts.find(id) != this->missing_pkts.end())
+            continue;
+        Ptr<DataPacket> data_pkt = Create<DataPacket> (
+            digest,
+            this->group_id, this->data_num, this->fec_num,
+            fec_pkt->GetBatchId(), batch_data_num, batch_fec_num
+        );
+        data_pkt->SetEncodeTime(fec_pkt->GetEncodeTime());
+        this->missing_pkts[id] = data_pkt;
     }
+
+    this->repair_cnt ++;
+    uint64_t start = FecCodec::GetCpuTimeNs();
+    auto decoded = this->solver.AddRepair(coeffs, this->codec != NULL ? fec_pkt->CopyPayloadData() : FecCodec::Symbol());
+    if(this->codec != NULL) this->decode_cpu_ns += FecCodec::GetCpuTimeNs() - start;
+    return decoded;
+};
+
+void PacketGroup::RecordDecode() {
+    if(this->codec == NULL || this->decode_recorded || this->recovered_cnt == 0)
+        return;
+    this->decode_recorded = true;
+    this->codec->RecordDecode(this->group_id, this->data_num, this->repair_cnt,
+        this->decode_bytes, this->decode_cpu_ns, true);
+};
+
+void PacketGroup::RecordTimeout() {
+    if(this->codec == NULL || this->decode_recorded || this->repair_cnt == 0)
+        return;
+    if(this->decoded_pkts.size() + this->undecoded_pkts.size() == this->data_num)
+        return;
+    this->decode_recorded = true;
+    this->codec->RecordDecode(this->group_id, this->data_num, this->repair_cnt,
+        this->decode_bytes, this->decode_cpu_ns, false);
 };
 
 
@@ -3,13 +3,20 @@
 
 #include "common-header.h"
 #include "network-packet.h"
+#include "ns3/fec-codec.h"
 #include "ns3/simulator.h"
 #include <unordered_set>
 #include <unordered_map>
 
 namespace ns3 {
-class PacketBatch;
 
+/**
+ * \brief Receiver side of a FEC group. The data packets and FEC packets of
+ * all batches of the group, first transmissions and retransmissions, are
+ * decoded jointly: each FEC packet is an equation over the data packets of
+ * its batch, so that the group is recovered as soon as the received symbols
+ * determine it, whichever batches they come from.
+ */
 class PacketGroup : public Object {
 public:
     static TypeId GetTypeId (void);
@@ -42,12 +49,13 @@ private:
     Time first_rcv_time;
     Time last_rcv_time_tx_0;
     Time group_delay;
+    Time expected_completion_time;  /* when the last packet sent of the group should have arrived */
 
     uint16_t pkt_cnt_tx_0;
 
     std::vector<Ptr<DataPacket>> undecoded_pkts;
-    std::unordered_map<uint32_t, Ptr<PacketBatch>> incomplete_batches;
-    std::unordered_map<uint32_t, Ptr<PacketBatch>> complete_batches;
+    LinearFecDecoder solver;    /* sources are the packet ids in the group */
+    std::unordered_map<uint16_t, Ptr<DataPacket>> missing_pkts;   /* rebuilt from the digests of the FEC packets */
 
     // mark the next round of rtx packets
     uint8_t next_rtx_count;
@@ -61,6 +69,14 @@ private:
     uint16_t rtx_fec_count;
     std::unordered_map<uint8_t, uint32_t> pkt_arrive_dis;
 
+    Ptr<FecCodec> codec;    /* real payload mode, NULL otherwise */
+    // decoding work of the group, recorded once in the codec
+    uint16_t repair_cnt;
+    uint16_t recovered_cnt;
+    uint64_t decode_bytes;
+    uint64_t decode_cpu_ns;
+    bool decode_recorded;
+
 public:
     uint32_t GetGroupId();
     uint16_t GetDataNum();
@@ -74,43 +90,43 @@ public:
     uint16_t GetRtxDataCount();
     uint16_t GetRtxFECCount();
     std::unordered_map<uint8_t, uint32_t> GetPktArriveDistribution();
+    Time GetExpectedCompletionTime();
+    /**
+     * @brief Data packets to request so that the group can be decoded: the
+     * missing ones that are not the pivot of a received FEC equation
+     *
+     * @return packet ids in the group
+     */
+    std::vector<uint16_t> GetMissingDataIds();
+    void SetFecCodec(Ptr<FecCodec>);
+    Ptr<FecCodec> GetFecCodec();
 
 public:
     void InitGroup(Ptr<VideoPacket> pkt);
     void AddPacket(Ptr<VideoPacket> pkt, Time group_delay);
     std::vector<Ptr<DataPacket>> GetUndecodedPackets();
     bool CheckComplete();
+    /**
+     * @brief The group missed its deadline: a decoding failure if FEC packets
+     * arrived but could not recover it
+     */
+    void RecordTimeout();
 private:
     void UpdateExpectedCompletionTime(Ptr<VideoPacket> pkt, Time group_delay);
+    /**
+     * @brief Add a FEC packet as an equation over the data packets of its batch
+     *
+     * @return packet ids in the group of the data packets it lets decode
+     */
+    std::vector<LinearFecDecoder::SourceId> AddRepair(Ptr<FECPacket> fec_pkt);
+    /**
+     * @brief Record the decoding of the group once the FEC packets have
+     * helped recover all its data packets
+     */
+    void RecordDecode();
 };  // class PacketGroup
 
 
-class PacketBatch : public Object {
-public:
-    static TypeId GetTypeId (void);
-    PacketBatch(Ptr<VideoPacket> pkt, Ptr<PacketGroup> packet_group);
-    ~PacketBatch();
-
-private:
-     Ptr<PacketGroup> packet_group;
-
-    uint32_t batch_id;
-    uint16_t data_num;
-    uint16_t fec_num;
-
-    std::unordered_set<uint16_t> decoded_pkts;
-    std::vector<Ptr<DataPacket>> undecoded_pkts;
-
-    std::unordered_map<uint16_t, Ptr<DataPacket>> data_pkts;
-    std::unordered_map<uint16_t, Ptr<FECPacket>> fec_pkts;
-
-public:
-    void AddPacket(Ptr<VideoPacket> pkt);
-    bool CheckComplete();
-    std::vector<Ptr<DataPacket>> GetUndecodedPackets();
-};  // class PacketBatch
-
-
 }; // namespace ns3
 
 #endif  /* PACKET_GROUP_H */
\ No newline at end of file
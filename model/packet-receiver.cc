@@ -16,10 +16,11 @@ PacketReceiver::PacketReceiver (GameClient * game_client, void (GameClient::*Rcv
 : game_client{game_client}
 , m_socket {socket}
 , RcvPacketFunc {RcvPacketFunc}
+, m_seqUnwrapper {}
 , m_record {}
 , m_feedback_interval {MilliSeconds(16)}
 , m_feedbackTimer {Timer::CANCEL_ON_DESTROY}
-, m_last_feedback {65535}
+, m_last_feedback {0}
 , wnd_size {1000}
 , time_wnd_size{wndsize}
 , m_credible {1000}
@@ -36,6 +37,7 @@ PacketReceiver::PacketReceiver (GameClient * game_client, void (GameClient::*Rcv
 , m_recv_sample {}
 {
     this->m_socket->SetRecvCallback(MakeCallback(&PacketReceiver::OnSocketRecv_receiver,this));
+    this->m_socket->SetIpRecvTos(true);
     this->m_feedbackTimer.SetFunction(&PacketReceiver::Feedback_NetState,this);
     this->m_feedbackTimer.SetDelay(m_feedback_interval);
 };
@@ -46,11 +48,16 @@ void PacketReceiver::OnSocketRecv_receiver(Ptr<Socket> socket)
 {
     Time time_now = Simulator::Now();
     Ptr<Packet> pkt = socket->Recv();
+    // ECN codepoint, reported back per packet in the NetState feedback
+    uint8_t ecn = 0;
+    SocketIpTosTag tosTag;
+    if(pkt->PeekPacketTag(tosTag))
+        ecn = tosTag.GetTos() & 0x3;
     Ptr<NetworkPacket> net_pkt = NetworkPacket::ToInstance(pkt);
     net_pkt->SetRcvTime(time_now);
     PacketType pkt_type = net_pkt->GetPacketType();
 
-    if(pkt_type != DATA_PKT && pkt_type != FEC_PKT && pkt_type != DUP_FEC_PKT)
+    if(pkt_type != DATA_PKT && pkt_type != FEC_PKT && pkt_type != DUP_FEC_PKT && pkt_type != WIN_FEC_PKT)
         // not data or FEC packets
         return;
 
@@ -58,9 +65,9 @@ void PacketReceiver::OnSocketRecv_receiver(Ptr<Socket> socket)
     ((this->game_client)->*RcvPacketFunc)(video_pkt);
 
     /* update network statistics */
-    uint32_t id = video_pkt->GetGlobalId();
+    uint64_t id = this->m_seqUnwrapper.Unwrap(video_pkt->GetGlobalId());
     uint32_t RxTime = time_now.GetMicroSeconds();
-    Ptr<RcvTime> rt = Create<RcvTime>(id, RxTime, pkt->GetSize());
+    Ptr<RcvTime> rt = Create<RcvTime>(id, RxTime, pkt->GetSize(), ecn);
 
     if(this->m_record.empty()) {
         this->m_record.push_back(rt);
@@ -90,13 +97,13 @@ void PacketReceiver::OnSocketRecv_receiver(Ptr<Socket> socket)
             this->m_record.push_back(rt);
         }
         else {
-            if(this->lessThan_simple(id, this->m_record.front()->pkt_id)){
+            if(id < this->m_record.front()->pkt_id){
                 this->m_record.push_front(rt);
             }
             else{
                 std::deque<Ptr<RcvTime>>::iterator it = this->m_record.end();
                 while(it > this->m_record.begin()){
-                    if(this->lessThan_simple((*(it-1))->pkt_id, id)){
+                    if((*(it-1))->pkt_id < id){
                         this->m_record.insert(it, rt);
                         break;
                     }
@@ -107,7 +114,7 @@ void PacketReceiver::OnSocketRecv_receiver(Ptr<Socket> socket)
         }
 
 
-        // if(lessThan_simple(id, this->m_last_feedback)){
+        // if(id < this->m_last_feedback){
         //     this->m_recv_sample.push_back(rt);
         // }
     }
@@ -123,7 +130,7 @@ void PacketReceiver::Feedback_NetState ()
     if(this->m_record.size() > 1) {
         Ptr<RcvTime> record_end = m_record.back();
         Ptr<RcvTime> record_front = m_record.front();
-        this->pkts_in_wnd = (record_end->pkt_id - record_front->pkt_id + 65537) % 65536;
+        this->pkts_in_wnd = record_end->pkt_id - record_front->pkt_id + 1;
         //NS_ASSERT_MSG(this->pkts_in_wnd <= this->wnd_size + 1,"Packets in window "<<this->pkts_in_wnd<<" is larger than window size limit "<<(this->wnd_size + 1));
         //this->time_in_wnd = record_end->rt_us - record_front->rt_us;
     }
@@ -144,11 +151,11 @@ void PacketReceiver::Feedback_NetState ()
     //Gather m_loss_seq & m_recvtime_sample from m_record
     this->m_loss_seq.clear();
     this->m_recv_sample.clear();
-    uint32_t prev_id = 0;
+    uint64_t prev_id = 0;
 
     auto it = this->m_record.begin();
     int consecutive_recv = 0;
-    uint32_t id;
+    uint64_t id;
     if(!this->m_record.empty()){
         prev_id = (*it)->pkt_id - 1;
         bool first=true;
@@ -157,23 +164,23 @@ void PacketReceiver::Feedback_NetState ()
             id = (*it)->pkt_id;
 
             if(!first){
-                NS_ASSERT_MSG(this->lessThan_simple(prev_id,id),"history should be ordered. Previous ID="<<prev_id<<" while ID="<<id<<" with last_id="<<this->last_id);
+                NS_ASSERT_MSG(prev_id < id,"history should be ordered. Previous ID="<<prev_id<<" while ID="<<id<<" with last_id="<<this->last_id);
             }
             else{
                 first=false;
             }
 
-            if ((id - prev_id + 65536)%65536 == 1) {
+            if (id - prev_id == 1) {
                 consecutive_recv += 1;
                 if(it == this->m_record.end()-1) {this->m_loss_seq.push_back(consecutive_recv);}
             }
             else {
                 this->m_loss_seq.push_back(consecutive_recv);
-                this->m_loss_seq.push_back(1 - (id - prev_id + 65536)%65536);
+                this->m_loss_seq.push_back(1 - (int)(id - prev_id));
                 consecutive_recv = 1;
                 this->losses_in_wnd += id - prev_id - 1;
             }
-            if(this->lessThan_simple(this->m_last_feedback, id)){
+            if(this->m_last_feedback < id){
                 this->m_recv_sample.push_back(*it);
                 this->m_last_feedback = id;
             }
@@ -221,32 +228,4 @@ void PacketReceiver::StopRunning() {
     }
 };
 
-bool PacketReceiver::lessThan(uint16_t id1, uint16_t id2) {
-    //NS_ASSERT_MSG(((this->last_id - id1 + 65536) % 65536) <= this->wnd_size &&
-    //              ((this->last_id - id2 + 65536) % 65536) <= this->wnd_size,
-    //              "ID1 and ID2 must be in-window.");
-    if(this->last_id >= this->wnd_size && id1 < id2)
-        return true;
-
-    if(this->last_id<this->wnd_size) {
-        if(id2<=this->last_id && id1>=65536-this->wnd_size+this->last_id)
-            return true;
-        if(id1<id2) {
-            if((id1 >= 65536 - this->wnd_size + this->last_id) &&
-               (id2 >= 65536 - this->wnd_size + this->last_id))
-                return true;
-            if((id1 <= this->last_id) &&
-               (id2 <= this->last_id))
-                return true;
-        }
-    }
-    return false;
-};
-
-bool PacketReceiver::lessThan_simple(uint16_t id1, uint16_t id2){
-    uint16_t noWarpSubtract = id2 - id1;
-    uint16_t wrapSubtract = id1 - id2;
-    return noWarpSubtract < wrapSubtract;
-}
-
 }; // namespace ns3
\ No newline at end of file
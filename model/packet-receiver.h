@@ -35,29 +35,27 @@ public:
 
     void StopRunning();
 
-    bool lessThan (uint16_t id1, uint16_t id2);
-
-    bool lessThan_simple(uint16_t id1, uint16_t id2);
-
 private:
     GameClient * game_client;
     Ptr<Socket> m_socket;
     void (GameClient::*RcvPacketFunc)(Ptr<VideoPacket>);
 
+    /* global ids of the wire extended to 64 bits, the record is ordered by them */
+    SeqUnwrapper m_seqUnwrapper;
     std::deque<Ptr<RcvTime>> m_record;
 
     Time     m_feedback_interval;
     Timer    m_feedbackTimer;
-    uint16_t m_last_feedback;
+    uint64_t m_last_feedback;
 
     /* Calculate statistics within a sliding window */
     uint16_t wnd_size;
     uint32_t time_wnd_size; // in us
     uint16_t m_credible;
     uint32_t bytes_per_packet;
-    uint16_t last_id;
+    uint64_t last_id;
 
-    uint16_t pkts_in_wnd;
+    uint32_t pkts_in_wnd;
     uint32_t bytes_in_wnd;
     uint32_t time_in_wnd;
     uint32_t losses_in_wnd;
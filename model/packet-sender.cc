@@ -15,11 +15,13 @@ PacketSender::PacketSender (
     GameServer * game_server, uint16_t interval,
     Time delay_ddl, Ptr<OutputStreamWrapper> debugStream,
     void (GameServer::*ReportACKFunc)(Ptr<AckPacket>),
-    void (GameServer::*ReportFrameAckFunc)(Ptr<FrameAckPacket>)
+    void (GameServer::*ReportFrameAckFunc)(Ptr<FrameAckPacket>),
+    void (GameServer::*ReportRtxRequestFunc)(Ptr<RtxRequestPacket>)
 )
 : game_server {game_server}
 , ReportACKFunc {ReportACKFunc}
 , ReportFrameAckFunc {ReportFrameAckFunc}
+, ReportRtxRequestFunc {ReportRtxRequestFunc}
 , m_netStat {NULL}
 , m_queue {}
 , pktsHistory {}
@@ -46,6 +48,7 @@ PacketSender::PacketSender (
 , m_curr_frame_TxTime{0}
 , m_prev_frame_RxTime{0}
 , m_curr_frame_RxTime{0}
+, m_curr_frame_ce{false}
 , m_interval{interval}
 , inter_arrival{0}
 , inter_departure{0}
@@ -53,6 +56,9 @@ PacketSender::PacketSender (
 , inter_group_size{0}
 , m_firstFeedback {true}
 , m_controller {NULL}
+, m_cwnd_blocked {false}
+, m_inNetworkFeedback {false}
+, m_pendingCe {false}
 , m_pacing {false}
 , m_pacing_interval {MilliSeconds(0)}
 , m_pacingTimer {Timer::CANCEL_ON_DESTROY}
@@ -65,8 +71,12 @@ PacketSender::PacketSender (
 , m_finished_frame_cnt {0}
 , m_timeout_frame_cnt {0}
 , trace_set {false}
+, m_traceStore {NULL}
+, m_traceCursor {0}
+, m_tracePending {}
 , m_debugStream {debugStream}
 {
+    m_lossSeqRv = CreateObject<UniformRandomVariable> ();
     NS_LOG_ERROR("[Sender] Delay DDL is: " << this->m_delay_ddl.GetMilliSeconds() << " ms");
     this->init_data_pkt_count = 0;
     this->other_pkt_count = 0;
@@ -93,11 +103,22 @@ void PacketSender::SetNetworkStatistics (
     m_netStat->curBw            = bw;
     m_netStat->curLossRate      = loss;
     m_netStat->oneWayDispersion = MicroSeconds ((uint64_t) (delay * 1e3));
+    InitLossSeq ();
+};
+
+int64_t PacketSender::AssignStreams (int64_t stream) {
+    m_lossSeqRv->SetStream (stream);
+    if (m_netStat != NULL)
+        InitLossSeq ();
+    return 1;
+};
+
+void PacketSender::InitLossSeq () {
     // randomly generate loss seq
     m_netStat->loss_seq.clear();
     int next_seq = 0;
-    for(uint16_t i = 0;i < bw * 1e6 / 8 * 0.1 / 1300/* packet count in 100ms */;i++) {
-        bool lost = bool(std::rand() % 2);
+    for(uint16_t i = 0;i < m_netStat->curBw * 1e6 / 8 * 0.1 / 1300/* packet count in 100ms */;i++) {
+        bool lost = m_lossSeqRv->GetInteger (0, 1) == 1;
         if(lost) {
             if(next_seq <= 0) {
                 next_seq --;
@@ -241,11 +262,13 @@ void PacketSender::OnSocketRecv_sender(Ptr<Socket> socket)
     {
         NS_LOG_FUNCTION("ACK packet received!");
         Ptr<AckPacket> ack_pkt = DynamicCast<AckPacket, NetworkPacket> (packet);
+        for(auto pkt_info : ack_pkt->GetAckedPktInfos())
+            pkt_info->m_globalId = this->UnwrapGlobalId(pkt_info->m_globalId);
         // hand to GameServer for retransmission
         ((this->game_server)->*ReportACKFunc)(ack_pkt);
 
         // Update RTT and inter-packet delay
-        uint16_t pkt_id = ack_pkt->GetLastPktId();
+        uint64_t pkt_id = this->UnwrapGlobalId(ack_pkt->GetLastPktId());
         DEBUG("[Sender] At " << Simulator::Now().GetMilliSeconds() << " ms rcvd ACK for packet " << pkt_id);
         if(this->pktsHistory.find(pkt_id) != this->pktsHistory.end()) {
             // RTT
@@ -292,15 +315,39 @@ void PacketSender::OnSocketRecv_sender(Ptr<Socket> socket)
         return;
     }
 
+    if(pkt_type == RTX_REQ_PKT) {
+        NS_LOG_FUNCTION ("Rtx request packet received!");
+        Ptr<RtxRequestPacket> rtx_req_pkt = DynamicCast<RtxRequestPacket, NetworkPacket> (packet);
+        ((this->game_server)->*ReportRtxRequestFunc)(rtx_req_pkt);
+        return;
+    }
+
+    if(pkt_type == DELAY_HINT_PKT)
+    {
+        // predicted arrival times from the router in front of the bottleneck,
+        // they replace the receive times of the NetState feedback
+        Ptr<DelayHintPacket> hint_pkt = DynamicCast<DelayHintPacket, NetworkPacket> (packet);
+        this->m_inNetworkFeedback = true;
+        if(this->m_cc_enable)
+            this->ProcessRecvTimes(hint_pkt->GetHints(), true);
+        return;
+    }
+
     // netstate packet
-    NS_ASSERT_MSG(pkt_type == NETSTATE_PKT, "Sender should receive FRAME_ACK_PKT, ACK_PKT or NETSTATE_PKT");
+    NS_ASSERT_MSG(pkt_type == NETSTATE_PKT, "Sender should receive FRAME_ACK_PKT, ACK_PKT, RTX_REQ_PKT, DELAY_HINT_PKT or NETSTATE_PKT");
     Ptr<NetStatePacket> netstate_pkt = DynamicCast<NetStatePacket, NetworkPacket> (packet);
     auto states = netstate_pkt->GetNetStates();
     if(!this->trace_set){
         m_netStat->curBw = ((double_t)states->throughput_kbps) / 1000.;
         m_netStat->curLossRate = states->loss_rate;
-        if(this->m_controller)
+        if(this->m_controller) {
             this->m_controller->UpdateLossRate(uint8_t (states->loss_rate * 256));
+            uint32_t ce_cnt = 0;
+            for(auto recvtime_item : states->recvtime_hist)
+                ce_cnt += recvtime_item->ecn == rmcat::ECN_CE;
+            if(!states->recvtime_hist.empty())
+                this->m_controller->UpdateMarkRate(uint8_t (std::min<uint32_t> (ce_cnt * 256 / states->recvtime_hist.size(), 255)));
+        }
     }
     m_netStat->loss_seq = states->loss_seq;
     m_netStat->oneWayDispersion = MicroSeconds(states->fec_group_delay_us);
@@ -329,85 +376,137 @@ void PacketSender::OnSocketRecv_sender(Ptr<Socket> socket)
     }
     */
 
-    if(this->m_cc_enable){
-        uint64_t now_us = Simulator::Now().GetMicroSeconds();
-
-        for(auto recvtime_item : states->recvtime_hist){
-            uint16_t id = recvtime_item->pkt_id;
-            uint64_t RxTime = recvtime_item->rt_us;
-            uint64_t TxTime = m_controller->GetPacketTxTimestamp(id);
-            // NS_ASSERT_MSG((RxTime <= now_us), "Receiving event and feedback event should be time-ordered.");
-            if(this->m_firstFeedback) {
-                this->m_prev_id = id;
-                this->m_prev_RxTime = RxTime;
-                this->m_group_id = 0;
-                this->m_group_size = m_controller->GetPacketSize(id);
-                this->m_groupstart_TxTime = TxTime;
-                this->m_firstFeedback = false;
-                this->m_curr_pkts_in_frame = 1;
-                continue;
-            }
-            
-            if((Uint64Less (this->m_groupstart_TxTime, TxTime) && TxTime - this->m_groupstart_TxTime < 6 * this->m_interval * 1000)|| 
-               this->m_groupstart_TxTime == TxTime){
-                // std::cout<<"group start:"<<m_groupstart_TxTime<<", tx:" <<TxTime<<std::endl;
-                if((TxTime - this->m_groupstart_TxTime) > 10000) {
-                    //Switching to another burst (named as group)
-                    // update inter arrival and inter departure
-                    if(this->m_group_id > 0){
-                        NS_ASSERT_MSG(this->m_prev_pkts_in_frame>0 && this->m_prev_pkts_in_frame>0,"Consecutive frame must have pkts!");
-                        inter_arrival = this->m_curr_frame_RxTime / this->m_curr_pkts_in_frame - this->m_prev_frame_RxTime / this->m_prev_pkts_in_frame;
-                        //inter_departure = this->m_controller->UpdateDepartureTime(this->m_prev_groupend_id, this->m_prev_id);
-                        inter_departure = this->m_curr_frame_TxTime / this->m_curr_pkts_in_frame - this->m_prev_frame_TxTime / this->m_prev_pkts_in_frame;
-                        // if(inter_departure > 4e6){
-                        //     std::cout<< "Group id: " << m_group_id
-                        //             << ", inter_departure: " << inter_departure
-                        //             << ", curr_frame_tx: " << m_curr_frame_TxTime
-                        //             << ", prev_frame_tx: " << m_prev_frame_TxTime
-                        //             << ", inter_arrival: " << inter_arrival
-                        //             << ", curr_frame_rx: " << m_curr_frame_RxTime
-                        //             << ", prev_frame_rx: " << m_prev_frame_RxTime
-                        //             << ", curr_pkt_num: " << m_curr_pkts_in_frame
-                        //             << ", prev_pkt_num: " << m_prev_pkts_in_frame
-                        //             << std::endl;
-                        // }
-                        inter_delay_var = inter_arrival - inter_departure;
-                        inter_group_size = this->m_group_size - this->m_prev_group_size;
-                        //std::cout<<"inter_arrival "<<inter_arrival <<" inter_dep "<<inter_departure<<std::endl;
-                        this->m_controller->processFeedback(now_us, id, RxTime, inter_arrival, inter_departure, inter_delay_var, inter_group_size, this->m_prev_RxTime);
-                    }
-
-
-                    // update group information
-                    this->m_controller->PrunTransitHistory(this->m_prev_groupend_id);
-                    this->m_prev_group_size = this->m_group_size;
-                    this->m_prev_groupend_id = this->m_prev_id;
-                    this->m_prev_groupend_RxTime = this->m_prev_RxTime;
-                    this->m_group_id += 1;
-                    this->m_group_size = 0;
-                    this->m_groupstart_TxTime = TxTime;
-                    this->m_prev_frame_TxTime = this->m_curr_frame_TxTime;
-                    this->m_prev_frame_RxTime = this->m_curr_frame_RxTime;
-                    this->m_prev_pkts_in_frame = this->m_curr_pkts_in_frame;
-                    this->m_curr_frame_TxTime = 0;
-                    this->m_curr_frame_RxTime = 0;
-                    this->m_curr_pkts_in_frame = 0;
+    if(!this->m_cc_enable)
+        return;
+    if(!this->m_inNetworkFeedback) {
+        this->ProcessRecvTimes(states->recvtime_hist);
+        return;
+    }
+
+    // with in-network feedback the delay signal comes from the router hints,
+    // but only the receiver knows which packets made it through the bottleneck
+    // and which of them were CE-marked
+    uint64_t now_us = Simulator::Now().GetMicroSeconds();
+    for(auto recvtime_item : states->recvtime_hist) {
+        this->m_controller->processAck(now_us, recvtime_item->pkt_id, recvtime_item->rt_us, recvtime_item->ecn);
+        this->m_pendingCe |= recvtime_item->ecn == rmcat::ECN_CE;
+    }
+    this->ReopenCwnd();
+};
+
+void PacketSender::ProcessRecvTimes(const std::vector<Ptr<RcvTime>> & recvtime_hist, bool hinted)
+{
+    uint64_t now_us = Simulator::Now().GetMicroSeconds();
+
+    for(auto recvtime_item : recvtime_hist){
+        uint16_t id = recvtime_item->pkt_id;
+        uint64_t RxTime = recvtime_item->rt_us;
+        // a hinted packet may still be dropped at the bottleneck, it is acked
+        // when the receiver reports it
+        if(!hinted)
+            this->m_controller->processAck(now_us, id, RxTime, recvtime_item->ecn);
+        uint64_t TxTime = m_controller->GetPacketTxTimestamp(id);
+        // NS_ASSERT_MSG((RxTime <= now_us), "Receiving event and feedback event should be time-ordered.");
+        if(this->m_firstFeedback) {
+            this->m_prev_id = id;
+            this->m_prev_RxTime = RxTime;
+            this->m_group_id = 0;
+            this->m_group_size = m_controller->GetPacketSize(id);
+            this->m_groupstart_TxTime = TxTime;
+            this->m_firstFeedback = false;
+            // the first packet counts in the averages of its group like the others,
+            // a group may hold a single full-size packet
+            this->m_curr_pkts_in_frame = 1;
+            this->m_curr_frame_TxTime = TxTime;
+            this->m_curr_frame_RxTime = RxTime;
+            this->m_curr_frame_ce = recvtime_item->ecn == rmcat::ECN_CE;
+            continue;
+        }
+        
+        if((Uint64Less (this->m_groupstart_TxTime, TxTime) && TxTime - this->m_groupstart_TxTime < 6 * this->m_interval * 1000)|| 
+           this->m_groupstart_TxTime == TxTime){
+            // std::cout<<"group start:"<<m_groupstart_TxTime<<", tx:" <<TxTime<<std::endl;
+            if((TxTime - this->m_groupstart_TxTime) > 10000) {
+                //Switching to another burst (named as group)
+                // update inter arrival and inter departure
+                if(this->m_group_id > 0){
+                    NS_ASSERT_MSG(this->m_prev_pkts_in_frame>0 && this->m_prev_pkts_in_frame>0,"Consecutive frame must have pkts!");
+                    inter_arrival = this->m_curr_frame_RxTime / this->m_curr_pkts_in_frame - this->m_prev_frame_RxTime / this->m_prev_pkts_in_frame;
+                    //inter_departure = this->m_controller->UpdateDepartureTime(this->m_prev_groupend_id, this->m_prev_id);
+                    inter_departure = this->m_curr_frame_TxTime / this->m_curr_pkts_in_frame - this->m_prev_frame_TxTime / this->m_prev_pkts_in_frame;
+                    // if(inter_departure > 4e6){
+                    //     std::cout<< "Group id: " << m_group_id
+                    //             << ", inter_departure: " << inter_departure
+                    //             << ", curr_frame_tx: " << m_curr_frame_TxTime
+                    //             << ", prev_frame_tx: " << m_prev_frame_TxTime
+                    //             << ", inter_arrival: " << inter_arrival
+                    //             << ", curr_frame_rx: " << m_curr_frame_RxTime
+                    //             << ", prev_frame_rx: " << m_prev_frame_RxTime
+                    //             << ", curr_pkt_num: " << m_curr_pkts_in_frame
+                    //             << ", prev_pkt_num: " << m_prev_pkts_in_frame
+                    //             << std::endl;
+                    // }
+                    inter_delay_var = inter_arrival - inter_departure;
+                    inter_group_size = this->m_group_size - this->m_prev_group_size;
+                    //std::cout<<"inter_arrival "<<inter_arrival <<" inter_dep "<<inter_departure<<std::endl;
+                    // hints carry no ECN, the marks reported by the receiver since the last group stand in
+                    bool ce = this->m_curr_frame_ce || (hinted && this->m_pendingCe);
+                    if(hinted)
+                        this->m_pendingCe = false;
+                    this->m_controller->processFeedback(now_us, id, RxTime, inter_arrival, inter_departure, inter_delay_var, inter_group_size, this->m_prev_RxTime,
+                                                        ce ? rmcat::ECN_CE : rmcat::ECN_NOT_ECT);
                 }
 
-                this->m_curr_pkts_in_frame += 1;
-                this->m_curr_frame_TxTime += TxTime;
-                this->m_curr_frame_RxTime += RxTime;       
 
-                this->m_group_size += this->m_controller->GetPacketSize(id);
-                this->m_prev_id = id;
-                this->m_prev_RxTime = RxTime;
-            }
-            else{
-                // std::cout<<"group id: "<< this->m_group_id
-                //          <<", group start tx: " << this->m_groupstart_TxTime
-                //          <<", tx: " << TxTime << std::endl;
+                // update group information
+                this->m_controller->PrunTransitHistory(this->m_prev_groupend_id);
+                this->m_prev_group_size = this->m_group_size;
+                this->m_prev_groupend_id = this->m_prev_id;
+                this->m_prev_groupend_RxTime = this->m_prev_RxTime;
+                this->m_group_id += 1;
+                this->m_group_size = 0;
+                this->m_groupstart_TxTime = TxTime;
+                this->m_prev_frame_TxTime = this->m_curr_frame_TxTime;
+                this->m_prev_frame_RxTime = this->m_curr_frame_RxTime;
+                this->m_prev_pkts_in_frame = this->m_curr_pkts_in_frame;
+                this->m_curr_frame_TxTime = 0;
+                this->m_curr_frame_RxTime = 0;
+                this->m_curr_pkts_in_frame = 0;
+                this->m_curr_frame_ce = false;
             }
-            
+
+            this->m_curr_pkts_in_frame += 1;
+            this->m_curr_frame_TxTime += TxTime;
+            this->m_curr_frame_RxTime += RxTime;       
+            this->m_curr_frame_ce |= recvtime_item->ecn == rmcat::ECN_CE;
+
+            this->m_group_size += this->m_controller->GetPacketSize(id);
+            this->m_prev_id = id;
+            this->m_prev_RxTime = RxTime;
+        }
+        else{
+            // std::cout<<"group id: "<< this->m_group_id
+            //          <<", group start tx: " << this->m_groupstart_TxTime
+            //          <<", tx: " << TxTime << std::endl;
+        }
+        
+    }
+
+    this->ReopenCwnd();
+};
+
+void PacketSender::ReopenCwnd()
+{
+    if(this->m_cwnd_blocked) {
+        // acknowledged packets opened the congestion window
+        this->m_cwnd_blocked = false;
+        if(m_pacing) {
+            if(this->m_pacingTimer.IsExpired())
+                this->m_pacingTimer.Schedule();
+        }
+        else {
+            Simulator::Cancel(this->m_sendevent);
+            this->m_sendevent = Simulator::ScheduleNow(&PacketSender::SendPacket,this);
         }
     }
 };
@@ -468,6 +567,19 @@ double PacketSender::GetGoodputRatio(){
     return this->m_goodput_ratio;
 };
 
+uint32_t PacketSender::GetQueuedRtxPackets(){
+    uint32_t rtx_pkts = 0;
+    for(auto frame : this->m_queue) {
+        if(frame->retransmission)
+            rtx_pkts += frame->Frame_size_in_packet();
+    }
+    return rtx_pkts;
+};
+
+uint64_t PacketSender::UnwrapGlobalId(uint16_t id){
+    return UnwrapSeq16(id, this->m_netGlobalId);
+};
+
 void PacketSender::UpdateGoodputRatio(){
     if(this->total_pkts_inwnd > 1 && this->goodput_pkts_inwnd > 0) {
             this->m_goodput_ratio = (double)(this->goodput_pkts_inwnd) / (double)(this->total_pkts_inwnd);
@@ -479,39 +591,39 @@ void PacketSender::UpdateGoodputRatio(){
 
 void PacketSender::UpdateNetstateByTrace()
 {
-    // Load trace file
-    std::ifstream trace_file;
-    trace_file.open(this->trace_filename);
-
-    // Initialize storing variables
-    std::string trace_line;
-    StringVector trace_data;
-    StringVector bw_value;
-    StringVector rtt_value;
-    uint16_t rtt;
-    double_t bw;
-    double_t lr;
-
-    uint64_t past_time = 0;
-
-    // Set netstate for every tracefile line
-    while (std::getline(trace_file,trace_line))
-    {   
-        rtt_value.clear();
-        bw_value.clear();
-        trace_data.clear();
-        trace_data = SplitString(trace_line, " ");
-        bw_value = SplitString(trace_data[0], "Mbps");
-        rtt_value = SplitString(trace_data[1], "ms");
-        rtt = (uint16_t) std::atof(rtt_value[0].c_str());
-        bw = std::atof(bw_value[0].c_str());
-        lr = std::atof(trace_data[2].c_str());
-        this->m_settrace_event = Simulator::Schedule(
-            MilliSeconds(rtt + past_time),&PacketSender::SetNetworkStatisticsBytrace, 
-            this, rtt, bw, lr);
-        past_time += this->m_interval;
+    m_traceStore = TraceStore::Get (this->trace_filename);
+    m_traceCursor = 0;
+    m_traceStartTime = Simulator::Now ();
+    this->ScheduleNextTraceSample ();
+};
+
+void PacketSender::ScheduleNextTraceSample()
+{
+    // Sample i takes effect at rtt_i + i * interval, which is not monotonic in i.
+    // Read samples lazily until no unread one can take effect before the earliest
+    // pending one (i * interval is a lower bound), so that the samples are applied
+    // in the same order as scheduling all of them at once.
+    while (m_traceCursor < m_traceStore->GetSize () && (m_tracePending.empty ()
+        || (uint64_t) m_traceCursor * this->m_interval < m_tracePending.top ().first)) {
+        uint16_t rtt = (uint16_t) m_traceStore->GetRttMs (m_traceCursor);
+        m_tracePending.push (std::make_pair (
+            rtt + (uint64_t) m_traceCursor * this->m_interval, m_traceCursor));
+        m_traceCursor ++;
     }
-    
+    if (m_tracePending.empty ())
+        return;
+    Time at = m_traceStartTime + MilliSeconds (m_tracePending.top ().first);
+    this->m_settrace_event = Simulator::Schedule (
+        at - Simulator::Now (), &PacketSender::OnTraceSample, this);
+};
+
+void PacketSender::OnTraceSample()
+{
+    uint32_t index = m_tracePending.top ().second;
+    m_tracePending.pop ();
+    this->SetNetworkStatisticsBytrace ((uint16_t) m_traceStore->GetRttMs (index),
+        m_traceStore->GetBwMbps (index), m_traceStore->GetLossRate (index));
+    this->ScheduleNextTraceSample ();
 };
 
 void PacketSender::SetTrace(std::string tracefile)
@@ -558,24 +670,32 @@ void PacketSender::SendPacket()
         Ptr<VideoPacket> netPktToSend = *firstPkt;
         PacketType pktType = netPktToSend->GetPacketType ();
         netPktToSend->SetSendTime (time_now);
-        netPktToSend->SetGlobalId (m_netGlobalId);
+        netPktToSend->SetGlobalId ((uint16_t) m_netGlobalId);
         if (pktType == PacketType::DATA_PKT) {
             Ptr<DataPacket> dataPkt = DynamicCast<DataPacket, VideoPacket> (netPktToSend);
             dataPkt->SetDataGlobalId (m_dataGlobalId);
-            m_dataGlobalId = (m_dataGlobalId + 1) % 65536;
         }
         bool is_goodput = (pktType == PacketType::DATA_PKT)
                             && (netPktToSend->GetTXCount() == 0);
 
         Ptr<Packet> pktToSend = netPktToSend->ToNetPacket ();
         uint16_t pkt_size = pktToSend->GetSize();
+
+        if(this->m_cc_enable && !this->m_controller->canSendPacket(NowUs, pkt_size)) {
+            // congestion window full, the next feedback resumes sending
+            this->m_cwnd_blocked = true;
+            return;
+        }
+        if (pktType == PacketType::DATA_PKT) {
+            m_dataGlobalId ++;
+        }
         Ptr<SentPacketInfo> pkt_info = Create<SentPacketInfo>(m_netGlobalId,
                     netPktToSend->GetBatchId(),
                     time_now, pktType, is_goodput, pkt_size);
 
         if(this->m_cc_enable) {
             // handle pkt information to cc controller
-            this->m_controller->processSendPacket(NowUs, m_netGlobalId, pktToSend->GetSize());
+            this->m_controller->processSendPacket(NowUs, (uint16_t) m_netGlobalId, pktToSend->GetSize());
         }
 
         // statistics
@@ -608,7 +728,7 @@ void PacketSender::SendPacket()
         this->m_goodput_wnd.push_back (m_netGlobalId);
 
         while(!this->m_goodput_wnd.empty()){
-            uint16_t id_out_of_date = this->m_goodput_wnd.front();
+            uint64_t id_out_of_date = this->m_goodput_wnd.front();
             //NS_ASSERT_MSG(this->pktsHistory.find(id_out_of_date)!=this->pktsHistory.end(),"History should record every packet sent.");
             Ptr<SentPacketInfo> info_out_of_date = this->pktsHistory[id_out_of_date];
             if((uint64_t)(info_out_of_date->pkt_send_time.GetMicroSeconds()) < NowUs - this->m_goodput_wnd_size){
@@ -624,13 +744,13 @@ void PacketSender::SendPacket()
         }
 
         while(this->m_send_wnd.size()>this->m_send_wnd_size){
-            uint16_t id_out_of_date = this->m_send_wnd.front();
+            uint64_t id_out_of_date = this->m_send_wnd.front();
             NS_ASSERT_MSG(this->pktsHistory.find(id_out_of_date)!=this->pktsHistory.end(),"History should record every packet sent.");
             this->pktsHistory.erase(id_out_of_date);
             this->m_send_wnd.pop_front();
         }
 
-        m_netGlobalId = (m_netGlobalId + 1) % 65536;
+        m_netGlobalId ++;
 
         if(current_frame->empty()){
             this->m_queue.erase(this->m_queue.begin());
@@ -679,7 +799,7 @@ uint32_t PacketFrame::Frame_size_in_packet()
     return this->packets_in_Frame.size();
 };
 
-SentPacketInfo::SentPacketInfo(uint16_t id, uint16_t batch_id, Time sendtime, PacketType type, bool isgoodput, uint16_t size){
+SentPacketInfo::SentPacketInfo(uint64_t id, uint16_t batch_id, Time sendtime, PacketType type, bool isgoodput, uint16_t size){
     this->pkt_id = id;
     this->batch_id = batch_id;
     this->pkt_send_time = sendtime;
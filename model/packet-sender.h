@@ -2,10 +2,12 @@
 #define PACKET_SENDER_H
 
 #include "common-header.h"
+#include "trace-store.h"
 #include "ns3/fec-policy.h"
 #include "ns3/sender-based-controller.h"
 #include "ns3/gcc-controller.h"
 #include "ns3/nada-controller.h"
+#include "ns3/scream-controller.h"
 
 #include "ns3/core-module.h"
 #include "ns3/socket.h"
@@ -25,9 +27,9 @@ class GameServer;
 
 class SentPacketInfo : public Object {
 public:
-    SentPacketInfo(uint16_t,uint16_t,Time,PacketType,bool,uint16_t);
+    SentPacketInfo(uint64_t,uint16_t,Time,PacketType,bool,uint16_t);
     ~SentPacketInfo();
-    uint16_t pkt_id;
+    uint64_t pkt_id;
     uint16_t batch_id;
     Time pkt_send_time;
     Time pkt_ack_time;
@@ -67,7 +69,7 @@ public:
     static TypeId GetTypeId (void);
     PacketSender(GameServer * server, uint16_t interval, Time delay_ddl, 
         Ptr<OutputStreamWrapper> debugStream, void (GameServer::*)(Ptr<AckPacket>),
-        void (GameServer::*)(Ptr<FrameAckPacket>));
+        void (GameServer::*)(Ptr<FrameAckPacket>), void (GameServer::*)(Ptr<RtxRequestPacket>));
     ~PacketSender();
 
     void StartApplication(Ptr<Socket> socket);
@@ -94,11 +96,32 @@ public:
 
     void OnSocketRecv_sender(Ptr<Socket>);
 
+    /**
+     * \brief Pass the receive times of media packets to the congestion controller,
+     * grouped by bursts
+     * \param hinted the times are router predictions, the packets are not acked yet
+     */
+    void ProcessRecvTimes(const std::vector<Ptr<RcvTime>> & recvtime_hist, bool hinted = false);
+
+    /**
+     * \brief Resume sending if a packet waits for the congestion window
+     */
+    void ReopenCwnd();
+
     void SetNetworkStatistics(
         Time default_rtt, double_t bw/* in Mbps */,
         double_t loss, double_t group_delay /* in ms */
     );
 
+    /**
+     * \brief Use a fixed random stream for this flow and redraw the initial
+     * loss sequence from it. Call after SetNetworkStatistics and before the
+     * simulation starts.
+     *
+     * \return number of streams used
+     */
+    int64_t AssignStreams(int64_t stream);
+
     void SetNetworkStatisticsBytrace(uint16_t rtt /* in ms */, 
                                     double_t bw/* in Mbps */,
                                     double_t loss_rate);
@@ -113,10 +136,24 @@ public:
 
     double GetGoodputRatio();
 
+    /**
+     * \brief Extend a global id of the wire (sent or fed back) to 64 bits
+     */
+    uint64_t UnwrapGlobalId(uint16_t id);
+
+    /**
+     * \brief Retransmission packets waiting in the sending queue
+     */
+    uint32_t GetQueuedRtxPackets();
+
     void UpdateGoodputRatio();
 
     void UpdateRTT(Time rtt);
 
+    /**
+     * \brief Apply the trace samples as network statistics, sample i at
+     * rtt_i + i * interval after now. Keeps one pending event at a time.
+     */
     void UpdateNetstateByTrace();
 
     void SetTrace(std::string tracefile);
@@ -143,10 +180,20 @@ private:
      */
     uint32_t num_frame_in_queue();
 
+    void ScheduleNextTraceSample();
+
+    void OnTraceSample();
+
+    /**
+     * \brief Randomly generate the loss sequence of the initial network statistics
+     */
+    void InitLossSeq();
+
 private:
     GameServer * game_server;
     void (GameServer::*ReportACKFunc)(Ptr<AckPacket>);
     void (GameServer::*ReportFrameAckFunc)(Ptr<FrameAckPacket>);
+    void (GameServer::*ReportRtxRequestFunc)(Ptr<RtxRequestPacket>);
     Ptr<Socket> m_socket; /* UDP socket to send our packets */
 
     Ptr<FECPolicy::NetStat> m_netStat; /* stats used for FEC para calculation */
@@ -155,11 +202,11 @@ private:
 
     //std::vector<Ptr<VideoPacket>> pkts_sent;
 
-    std::unordered_map<uint16_t, Ptr<SentPacketInfo>> pktsHistory; /* Packet history for all packets */
-    std::deque<uint16_t> m_send_wnd; // Last ID in sender sliding window
-    uint16_t m_send_wnd_size;
+    std::unordered_map<uint64_t, Ptr<SentPacketInfo>> pktsHistory; /* Packet history for all packets, by extended global id */
+    std::deque<uint64_t> m_send_wnd; // Last ID in sender sliding window
+    uint32_t m_send_wnd_size;
 
-    std::deque<uint16_t> m_goodput_wnd;
+    std::deque<uint64_t> m_goodput_wnd;
     uint32_t m_goodput_wnd_size; // in us
     uint64_t goodput_pkts_inwnd;
     uint64_t total_pkts_inwnd;
@@ -191,6 +238,7 @@ private:
     uint64_t m_curr_frame_TxTime;
     uint64_t m_prev_frame_RxTime;
     uint64_t m_curr_frame_RxTime;
+    bool m_curr_frame_ce;       // a packet of the current group was CE-marked
 
     uint16_t m_interval;
 
@@ -203,6 +251,9 @@ private:
     bool m_firstFeedback;
 
     std::shared_ptr<rmcat::SenderBasedController> m_controller;
+    bool m_cwnd_blocked;    // a packet waits for the congestion window of the controller
+    bool m_inNetworkFeedback;   // delay hints from the router are used instead of the receive times
+    bool m_pendingCe;   // the receiver reported CE marks not yet passed on with a hinted group
 
     /* pacing-related variables */
     bool m_pacing; // whether to turn on pacing
@@ -217,10 +268,12 @@ private:
 
     EventId m_settrace_event;
 
-    uint16_t m_netGlobalId;
-    uint16_t m_dataGlobalId;
+    /* next global ids, extended to 64 bits: only their low 16 bits go on the
+       wire, the ids fed back are unwrapped against m_netGlobalId */
+    uint64_t m_netGlobalId;
+    uint64_t m_dataGlobalId;
 
-    uint16_t m_last_acked_global_id;
+    uint64_t m_last_acked_global_id;
 
     Time m_delay_ddl;
     uint64_t m_finished_frame_cnt;
@@ -235,6 +288,15 @@ private:
     /* statistics setup by trace */
     bool trace_set;
     std::string trace_filename;
+    Ptr<TraceStore> m_traceStore;
+    uint32_t m_traceCursor;     /* next sample to read */
+    Time m_traceStartTime;
+    /* (time to apply in ms, sample index) of the samples read but not applied yet */
+    std::priority_queue<std::pair<uint64_t, uint32_t>,
+        std::vector<std::pair<uint64_t, uint32_t>>,
+        std::greater<std::pair<uint64_t, uint32_t>>> m_tracePending;
+
+    Ptr<UniformRandomVariable> m_lossSeqRv;
 
     Ptr<OutputStreamWrapper> m_debugStream;
 };  // class PacketSender
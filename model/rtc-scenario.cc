@@ -0,0 +1,204 @@
+#include "rtc-scenario.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "ns3/ipv4.h"
+#include "ns3/trace-helper.h"
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("RtcScenario");
+
+RtcFlowConfig::RtcFlowConfig ()
+: fecPolicy {NULL}
+, rtxPolicy {"dupack"}
+, cc {NOT_USE_CC}
+, fps {60}
+, interval {16}
+, delayDdl {100}
+, bitrate {30000000}
+, defaultRtt {20}
+, defaultBw {30}
+, defaultLoss {0}
+, receiverWindow {34}
+, setTrace {false}
+, trace {""}
+, frameTrace {""}
+, rcDelay {0}
+, ecn {0}
+, packetSize {0}
+, fecCodec {""}
+, windowFec {0}
+, freshRepairRtx {false}
+, nack {false}
+, start {Seconds (0)}
+, stop {Seconds (10)}
+, logDir {"logs"}
+{};
+
+TypeId RtcScenario::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::RtcScenario")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<RtcScenario> ()
+    ;
+    return tid;
+};
+
+RtcScenario::RtcScenario () {};
+
+RtcScenario::~RtcScenario () {};
+
+uint32_t RtcScenario::AddFlow (const RtcFlowConfig & config) {
+    NS_ASSERT_MSG (config.fecPolicy != NULL, "Each flow needs its own FEC policy");
+    NS_ASSERT_MSG (m_servers.empty (), "Flows must be added before Install");
+    m_configs.push_back (config);
+    return m_configs.size () - 1;
+};
+
+int64_t RtcScenario::Install (Ptr<Node> sender, Ptr<Node> receiver, uint16_t basePort, int64_t stream) {
+    Ipv4Address receiverIp = receiver->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+    Ipv4Address senderIp = sender->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+    AsciiTraceHelper ascii;
+    int64_t used = 0;
+
+    for (uint32_t i = 0; i < m_configs.size (); i++) {
+        const RtcFlowConfig & config = m_configs[i];
+        uint16_t port = basePort + i;
+        Ptr<OutputStreamWrapper> fecStream = ascii.CreateFileStream (config.logDir + "/fec.log");
+        Ptr<OutputStreamWrapper> appStream = ascii.CreateFileStream (config.logDir + "/app.log");
+        Ptr<OutputStreamWrapper> debugStream = ascii.CreateFileStream (config.logDir + "/debug.log");
+
+        Ptr<GameServer> sendApp = CreateObject<GameServer> ();
+        Ptr<GameClient> recvApp = CreateObject<GameClient> ();
+        sender->AddApplication (sendApp);
+        receiver->AddApplication (recvApp);
+
+        sendApp->Setup (
+            senderIp, port, receiverIp, port,
+            config.fps, MilliSeconds (config.delayDdl), config.bitrate / 1e3, config.interval,
+            config.fecPolicy, config.rtxPolicy, MilliSeconds (config.receiverWindow),
+            config.defaultRtt, config.defaultBw, config.defaultLoss, 0.01,
+            config.setTrace, config.trace, fecStream, debugStream
+        );
+        recvApp->Setup (senderIp, port, port, config.fps, MilliSeconds (config.delayDdl),
+            config.receiverWindow * 1000, config.defaultRtt, appStream, debugStream);
+        if (!config.frameTrace.empty ())
+            sendApp->SetFrameTrace (config.frameTrace, MilliSeconds (config.rcDelay));
+        used += sendApp->AssignStreams (stream + used);
+
+        Simulator::Schedule (config.stop, &GameServer::StopEncoding, sendApp);
+        sendApp->SetController (config.cc);
+        sendApp->SetEcn (config.ecn);
+        if (config.packetSize > 0)
+            sendApp->SetPacketSize (config.packetSize);
+        if (!config.fecCodec.empty ()) {
+            NS_ASSERT_MSG (config.fecCodec == "rs" || config.fecCodec == "xor", "FEC codec must be rs or xor");
+            FecCodec::CodeType type = config.fecCodec == "rs" ? FecCodec::RS : FecCodec::XOR;
+            sendApp->SetFecCodec (Create<FecCodec> (type));
+            recvApp->SetFecCodec (Create<FecCodec> (type));
+        }
+        if (config.windowFec > 0) {
+            sendApp->SetWindowFec (config.windowFec);
+            recvApp->SetWindowFec (true);
+        }
+        sendApp->SetFreshRepairRtx (config.freshRepairRtx);
+        sendApp->SetNackRtx (config.nack);
+        recvApp->SetNack (config.nack);
+
+        sendApp->SetStartTime (config.start);
+        sendApp->SetStopTime (config.stop + Seconds (2));
+        recvApp->SetStartTime (config.start);
+        recvApp->SetStopTime (config.stop + Seconds (2));
+
+        m_servers.push_back (sendApp);
+        m_clients.push_back (recvApp);
+        NS_LOG_INFO ("[Scenario] flow " << i << " port " << port << " policy "
+            << config.fecPolicy->GetFecName () << " cc " << config.cc << " codec " << (config.fecCodec.empty () ? "none" : config.fecCodec) << " window " << config.windowFec << " freshRepairRtx " << config.freshRepairRtx << " nack " << config.nack << " log " << config.logDir);
+    }
+    return used;
+};
+
+uint32_t RtcScenario::GetNFlows () const {
+    return m_configs.size ();
+};
+
+Ptr<GameServer> RtcScenario::GetServer (uint32_t i) const {
+    NS_ASSERT (i < m_servers.size ());
+    return m_servers[i];
+};
+
+Ptr<GameClient> RtcScenario::GetClient (uint32_t i) const {
+    NS_ASSERT (i < m_clients.size ());
+    return m_clients[i];
+};
+
+RtcScenario::FlowStats RtcScenario::GetFlowStats (uint32_t i) const {
+    Ptr<VideoDecoder> decoder = GetClient (i)->GetDecoder ();
+    FlowStats stats;
+    stats.frames = decoder->GetFrameCount ();
+    stats.played = decoder->GetPlayedFrameCount ();
+    stats.late = decoder->GetLateFrameCount ();
+    stats.meanDelay = decoder->GetMeanFrameDelay ();
+    stats.minDelay = decoder->GetMinFrameDelay ();
+    stats.dmr = stats.frames == 0 ? 0 :
+        (double_t) (stats.frames - stats.played + stats.late) / stats.frames;
+    double_t duration = (m_configs[i].stop - m_configs[i].start).GetSeconds ();
+    stats.goodput = duration > 0 ? decoder->GetPlayedBytes () * 8 / duration / 1e6 : 0;
+    return stats;
+};
+
+RtcScenario::FlowStats RtcScenario::GetAggregateStats () const {
+    FlowStats total {0, 0, 0, Time (0), Time::Max (), 0, 0};
+    Time delaySum = Time (0);
+    for (uint32_t i = 0; i < m_clients.size (); i++) {
+        FlowStats stats = GetFlowStats (i);
+        total.frames += stats.frames;
+        total.played += stats.played;
+        total.late += stats.late;
+        total.goodput += stats.goodput;
+        delaySum += stats.meanDelay * (int64_t) stats.played;
+        if (stats.played > 0)
+            total.minDelay = std::min (total.minDelay, stats.minDelay);
+    }
+    if (total.minDelay == Time::Max ())
+        total.minDelay = Time (0);
+    if (total.played > 0)
+        total.meanDelay = delaySum / (int64_t) total.played;
+    if (total.frames > 0)
+        total.dmr = (double_t) (total.frames - total.played + total.late) / total.frames;
+    return total;
+};
+
+double_t RtcScenario::JainFairness (const std::vector<double_t> & x) {
+    double_t sum = 0, sumSq = 0;
+    for (double_t v : x) {
+        sum += v;
+        sumSq += v * v;
+    }
+    if (x.empty () || sumSq == 0)
+        return 1;
+    return sum * sum / (x.size () * sumSq);
+};
+
+void RtcScenario::Report (std::ostream & os) const {
+    auto print = [&os] (std::string name, const FlowStats & stats) {
+        os << name
+           << " frames " << stats.frames
+           << " played " << stats.played
+           << " late " << stats.late
+           << " delay " << stats.meanDelay.GetMicroSeconds () / 1e3 << "ms"
+           << " inflation " << (stats.meanDelay - stats.minDelay).GetMicroSeconds () / 1e3 << "ms"
+           << " DMR " << stats.dmr * 100 << "%"
+           << " goodput " << stats.goodput << "Mbps" << std::endl;
+    };
+    std::vector<double_t> goodputs;
+    for (uint32_t i = 0; i < m_clients.size (); i++) {
+        FlowStats stats = GetFlowStats (i);
+        goodputs.push_back (stats.goodput);
+        print ("flow " + std::to_string (i), stats);
+    }
+    print ("all", GetAggregateStats ());
+    os << "Jain fairness " << JainFairness (goodputs) << std::endl;
+};
+
+}; // namespace ns3
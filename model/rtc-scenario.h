@@ -0,0 +1,118 @@
+#ifndef RTC_SCENARIO_H
+#define RTC_SCENARIO_H
+
+#include "common-header.h"
+#include "game-server.h"
+#include "game-client.h"
+#include "ns3/fec-policy.h"
+#include "ns3/object.h"
+#include "ns3/node.h"
+#include "ns3/nstime.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief Configuration of one GameServer/GameClient pair
+ */
+struct RtcFlowConfig {
+    Ptr<FECPolicy> fecPolicy;
+    std::string rtxPolicy;
+    CC_ALG cc;
+    uint8_t fps;
+    uint16_t interval;          /* network statistics interval, in ms */
+    uint16_t delayDdl;          /* in ms */
+    uint32_t bitrate;           /* in bps */
+    uint16_t defaultRtt;        /* in ms */
+    double_t defaultBw;         /* in Mbps */
+    double_t defaultLoss;
+    uint32_t receiverWindow;    /* in ms */
+    bool setTrace;              /* sender takes the network statistics from the trace */
+    std::string trace;
+    std::string frameTrace;     /* empty for constant frame sizes */
+    uint16_t rcDelay;           /* encoder rate-control response time, in ms */
+    uint8_t ecn;                /* ECN codepoint of the media packets, 0 for Not-ECT */
+    uint16_t packetSize;        /* in bytes, 0 for ns3::NetworkPacket::MaxPacketSize */
+    std::string fecCodec;       /* real payload mode with "rs" or "xor" FecCodec, empty to simulate sizes only */
+    uint16_t windowFec;         /* packets covered by a sliding-window FEC repair, 0 for the batch FEC only */
+    bool freshRepairRtx;        /* retransmit fresh repairs instead of the lost data packets */
+    bool nack;                  /* receiver-driven retransmission on NACKs */
+    Time start;
+    Time stop;
+    std::string logDir;         /* fec.log, app.log and debug.log of the flow */
+
+    RtcFlowConfig ();
+};
+
+/**
+ * \brief N RTC flows from one sender node to one receiver node, sharing the
+ * path between them. Flow i uses port basePort + i on both ends and its own
+ * log directory, FEC policy, congestion control and trace.
+ *
+ * After the simulation, the frame delay and deadline miss rate (DMR) are
+ * reported per flow and in aggregate, with the Jain fairness index of the
+ * flow goodputs.
+ */
+class RtcScenario : public Object {
+public:
+    static TypeId GetTypeId (void);
+    RtcScenario ();
+    ~RtcScenario ();
+
+    struct FlowStats {
+        uint64_t frames;        /* frames generated, as seen by the decoder */
+        uint64_t played;        /* frames fully received */
+        uint64_t late;          /* played after the deadline */
+        Time meanDelay;         /* of the played frames */
+        Time minDelay;          /* meanDelay - minDelay is the latency inflation by queuing */
+        double_t dmr;           /* frames not played before the deadline / frames */
+        double_t goodput;       /* payload of the played frames, in Mbps */
+    };
+
+    /**
+     * \return index of the flow
+     */
+    uint32_t AddFlow (const RtcFlowConfig & config);
+
+    /**
+     * \brief Create and set up the applications of all flows
+     *
+     * \param stream first random stream, the flows take consecutive streams
+     * \return number of streams used
+     */
+    int64_t Install (Ptr<Node> sender, Ptr<Node> receiver, uint16_t basePort, int64_t stream);
+
+    uint32_t GetNFlows () const;
+    Ptr<GameServer> GetServer (uint32_t i) const;
+    Ptr<GameClient> GetClient (uint32_t i) const;
+
+    /**
+     * \brief Statistics of a flow, call after the simulation
+     */
+    FlowStats GetFlowStats (uint32_t i) const;
+    /**
+     * \brief Statistics of the frames of all flows
+     */
+    FlowStats GetAggregateStats () const;
+
+    /**
+     * \brief Jain fairness index (sum x)^2 / (n * sum x^2), 1 if all x are equal
+     */
+    static double_t JainFairness (const std::vector<double_t> & x);
+
+    /**
+     * \brief Print per-flow and aggregate statistics and the goodput fairness
+     */
+    void Report (std::ostream & os) const;
+
+private:
+    std::vector<RtcFlowConfig> m_configs;
+    std::vector<Ptr<GameServer>> m_servers;
+    std::vector<Ptr<GameClient>> m_clients;
+};  // class RtcScenario
+
+};  // namespace ns3
+
+#endif  /* RTC_SCENARIO_H */
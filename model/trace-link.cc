@@ -0,0 +1,458 @@
+#include "trace-link.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/uinteger.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/queue-size.h"
+#include "ns3/ppp-header.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/pcap-file-wrapper.h"
+#include "ns3/trace-helper.h"
+#include <sstream>
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("TraceLink");
+
+/* TraceLinkChannel */
+
+TypeId TraceLinkChannel::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::TraceLinkChannel")
+        .SetParent<Channel> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<TraceLinkChannel> ()
+    ;
+    return tid;
+};
+
+TraceLinkChannel::TraceLinkChannel ()
+: m_nDevices {0}
+{};
+
+TraceLinkChannel::~TraceLinkChannel () {};
+
+void TraceLinkChannel::Attach (Ptr<TraceLinkNetDevice> device) {
+    NS_ASSERT_MSG (m_nDevices < 2, "Only two devices permitted");
+    m_devices[m_nDevices++] = device;
+};
+
+void TraceLinkChannel::Transmit (Ptr<Packet> p, Ptr<TraceLinkNetDevice> src, Time delay) {
+    Ptr<TraceLinkNetDevice> dst = GetPeer (src);
+    /* like the ns-3 channels, the receiver gets its own copy */
+    Simulator::ScheduleWithContext (dst->GetNode ()->GetId (), delay,
+        &TraceLinkNetDevice::Receive, dst, p->Copy ());
+};
+
+std::size_t TraceLinkChannel::GetNDevices () const {
+    return m_nDevices;
+};
+
+Ptr<NetDevice> TraceLinkChannel::GetDevice (std::size_t i) const {
+    NS_ASSERT (i < m_nDevices);
+    return m_devices[i];
+};
+
+Ptr<TraceLinkNetDevice> TraceLinkChannel::GetPeer (Ptr<const TraceLinkNetDevice> device) const {
+    NS_ASSERT (m_nDevices == 2);
+    return m_devices[0] == device ? m_devices[1] : m_devices[0];
+};
+
+/* TraceLinkNetDevice */
+
+TypeId TraceLinkNetDevice::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::TraceLinkNetDevice")
+        .SetParent<NetDevice> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<TraceLinkNetDevice> ()
+        .AddAttribute ("Mtu", "The MAC-level Maximum Transmission Unit",
+                       UintegerValue (1500),
+                       MakeUintegerAccessor (&TraceLinkNetDevice::SetMtu, &TraceLinkNetDevice::GetMtu),
+                       MakeUintegerChecker<uint16_t> ())
+        .AddAttribute ("Address", "The MAC address of this device.",
+                       Mac48AddressValue (Mac48Address ("ff:ff:ff:ff:ff:ff")),
+                       MakeMac48AddressAccessor (&TraceLinkNetDevice::m_address),
+                       MakeMac48AddressChecker ())
+        .AddAttribute ("DataRate", "Rate used when the rate is not bound to the trace",
+                       DataRateValue (DataRate ("32768b/s")),
+                       MakeDataRateAccessor (&TraceLinkNetDevice::m_bps),
+                       MakeDataRateChecker ())
+        .AddAttribute ("Delay", "Propagation delay used when the delay is not bound to the trace",
+                       TimeValue (Seconds (0)),
+                       MakeTimeAccessor (&TraceLinkNetDevice::m_delay),
+                       MakeTimeChecker ())
+        .AddAttribute ("TraceRateScale", "Rate = scale * trace bandwidth, 0 to use DataRate",
+                       DoubleValue (0),
+                       MakeDoubleAccessor (&TraceLinkNetDevice::m_traceRateScale),
+                       MakeDoubleChecker<double> (0))
+        .AddAttribute ("TraceDelay", "Use trace rtt / 2 - TraceDelayOffset as the propagation delay",
+                       BooleanValue (false),
+                       MakeBooleanAccessor (&TraceLinkNetDevice::m_traceDelay),
+                       MakeBooleanChecker ())
+        .AddAttribute ("TraceDelayOffset", "Delay of the rest of the path, subtracted from rtt / 2",
+                       TimeValue (Seconds (0)),
+                       MakeTimeAccessor (&TraceLinkNetDevice::m_traceDelayOffset),
+                       MakeTimeChecker ())
+        .AddAttribute ("TraceLoss", "Drop packets sent on this device with the trace loss rate",
+                       BooleanValue (false),
+                       MakeBooleanAccessor (&TraceLinkNetDevice::m_traceLoss),
+                       MakeBooleanChecker ())
+        .AddAttribute ("ReceiveErrorModel", "Error model applied to received packets",
+                       PointerValue (),
+                       MakePointerAccessor (&TraceLinkNetDevice::m_receiveErrorModel),
+                       MakePointerChecker<ErrorModel> ())
+        .AddAttribute ("TxQueue", "Transmit queue of the device",
+                       PointerValue (),
+                       MakePointerAccessor (&TraceLinkNetDevice::m_queue),
+                       MakePointerChecker<Queue<Packet>> ())
+        .AddTraceSource ("PhyTxDrop", "Packet dropped by the trace loss",
+                         MakeTraceSourceAccessor (&TraceLinkNetDevice::m_phyTxDropTrace),
+                         "ns3::Packet::TracedCallback")
+        .AddTraceSource ("PhyRxDrop", "Packet dropped by the receive error model",
+                         MakeTraceSourceAccessor (&TraceLinkNetDevice::m_phyRxDropTrace),
+                         "ns3::Packet::TracedCallback")
+        .AddTraceSource ("Sniffer", "Packet sent or received, with the PPP header",
+                         MakeTraceSourceAccessor (&TraceLinkNetDevice::m_snifferTrace),
+                         "ns3::Packet::TracedCallback")
+    ;
+    return tid;
+};
+
+TraceLinkNetDevice::TraceLinkNetDevice ()
+: m_node {NULL}
+, m_channel {NULL}
+, m_queue {NULL}
+, m_ifIndex {0}
+, m_mtu {1500}
+, m_linkUp {false}
+, m_traceStore {NULL}
+, m_traceStart {Time (0)}
+, m_traceInterval {MilliSeconds (16)}
+, m_traceRateScale {0}
+, m_traceDelay {false}
+, m_traceDelayOffset {Time (0)}
+, m_traceLoss {false}
+, m_busy {false}
+, m_currentPkt {NULL}
+, m_lastArrival {Time (0)}
+, m_deliveryTrace {NULL}
+, m_deliveryStart {Time (0)}
+, m_currentPktSent {0}
+{
+    m_lossRv = CreateObject<UniformRandomVariable> ();
+};
+
+TraceLinkNetDevice::~TraceLinkNetDevice () {};
+
+void TraceLinkNetDevice::DoDispose () {
+    m_txEvent.Cancel ();
+    m_node = NULL;
+    m_channel = NULL;
+    m_queue = NULL;
+    m_currentPkt = NULL;
+    m_receiveErrorModel = NULL;
+    m_traceStore = NULL;
+    m_deliveryTrace = NULL;
+    m_rxCallback.Nullify ();
+    m_promiscCallback.Nullify ();
+    NetDevice::DoDispose ();
+};
+
+void TraceLinkNetDevice::SetTraceStore (Ptr<TraceStore> store, Time start, Time interval) {
+    NS_ASSERT (interval.IsStrictlyPositive ());
+    m_traceStore = store;
+    m_traceStart = start;
+    m_traceInterval = interval;
+};
+
+bool TraceLinkNetDevice::Attach (Ptr<TraceLinkChannel> channel) {
+    m_channel = channel;
+    m_channel->Attach (this);
+    m_linkUp = true;
+    m_linkChangeCallbacks ();
+    return true;
+};
+
+void TraceLinkNetDevice::SetQueue (Ptr<Queue<Packet>> queue) {
+    m_queue = queue;
+};
+
+Ptr<Queue<Packet>> TraceLinkNetDevice::GetQueue () const {
+    return m_queue;
+};
+
+int64_t TraceLinkNetDevice::AssignStreams (int64_t stream) {
+    m_lossRv->SetStream (stream);
+    return 1;
+};
+
+uint32_t TraceLinkNetDevice::GetSampleIndex () const {
+    Time elapsed = Simulator::Now () - m_traceStart;
+    if (elapsed.IsNegative ())
+        return 0;
+    uint64_t index = elapsed.GetTimeStep () / m_traceInterval.GetTimeStep ();
+    /* keep the last sample once the trace ends */
+    return (uint32_t) MIN (index, (uint64_t) m_traceStore->GetSize () - 1);
+};
+
+DataRate TraceLinkNetDevice::GetCurrentRate () const {
+    if (m_traceStore == NULL || m_traceRateScale <= 0)
+        return m_bps;
+    return DataRate ((uint64_t) (m_traceStore->GetBwMbps (GetSampleIndex ()) * m_traceRateScale * 1e6));
+};
+
+Time TraceLinkNetDevice::GetCurrentDelay () const {
+    if (m_traceStore == NULL || !m_traceDelay)
+        return m_delay;
+    Time delay = MicroSeconds ((int64_t) (m_traceStore->GetRttMs (GetSampleIndex ()) * 1e3 / 2))
+        - m_traceDelayOffset;
+    return delay.IsNegative () ? Time (0) : delay;
+};
+
+double_t TraceLinkNetDevice::GetCurrentLossRate () const {
+    if (m_traceStore == NULL || !m_traceLoss)
+        return 0;
+    return m_traceStore->GetLossRate (GetSampleIndex ());
+};
+
+void TraceLinkNetDevice::TransmitStart (Ptr<Packet> p) {
+    NS_ASSERT (!m_busy || m_currentPkt == p);
+    m_busy = true;
+    m_currentPkt = p;
+    DataRate rate = GetCurrentRate ();
+    if (rate.GetBitRate () == 0) {
+        /* link is down in this sample, retry in the next one */
+        Time elapsed = Simulator::Now () - m_traceStart;
+        Time wait = m_traceInterval - Time (elapsed.GetTimeStep () % m_traceInterval.GetTimeStep ());
+        m_txEvent = Simulator::Schedule (wait, &TraceLinkNetDevice::TransmitStart, this, p);
+        return;
+    }
+    Time txTime = rate.CalculateBytesTxTime (p->GetSize ());
+    m_txEvent = Simulator::Schedule (txTime, &TraceLinkNetDevice::TransmitComplete, this);
+};
+
+void TraceLinkNetDevice::TransmitComplete () {
+    NS_ASSERT (m_busy);
+    Ptr<Packet> p = m_currentPkt;
+    m_currentPkt = NULL;
+    m_busy = false;
+
+    Deliver (p);
+
+    if (!m_queue->IsEmpty ()) {
+        Ptr<Packet> next = m_queue->Dequeue ();
+        TransmitStart (next);
+    }
+};
+
+void TraceLinkNetDevice::Deliver (Ptr<Packet> p) {
+    double_t loss = GetCurrentLossRate ();
+    if (loss > 0 && m_lossRv->GetValue () < loss) {
+        m_phyTxDropTrace (p);
+        return;
+    }
+    m_snifferTrace (p);
+    Time arrival = Simulator::Now () + GetCurrentDelay ();
+    if (arrival < m_lastArrival)
+        arrival = m_lastArrival;
+    m_lastArrival = arrival;
+    m_channel->Transmit (p, this, arrival - Simulator::Now ());
+};
+
+void TraceLinkNetDevice::SetDeliveryTrace (std::string path, Time start) {
+    m_deliveryTrace = CreateObject<MahimahiTrace> ();
+    m_deliveryTrace->Open (path);
+    m_deliveryStart = start;
+};
+
+void TraceLinkNetDevice::ScheduleOpportunity () {
+    /* opportunities passed while the queue was empty are wasted, as in Mahimahi */
+    Time at;
+    do {
+        at = m_deliveryStart + MilliSeconds (m_deliveryTrace->Next ());
+    } while (at < Simulator::Now ());
+    m_busy = true;
+    m_txEvent = Simulator::Schedule (at - Simulator::Now (), &TraceLinkNetDevice::DeliveryOpportunity, this);
+};
+
+void TraceLinkNetDevice::DeliveryOpportunity () {
+    uint32_t budget = MahimahiTrace::k_mtu;
+    while (budget > 0) {
+        if (m_currentPkt == NULL) {
+            if (m_queue->IsEmpty ())
+                break;
+            m_currentPkt = m_queue->Dequeue ();
+            m_currentPktSent = 0;
+        }
+        uint32_t remaining = m_currentPkt->GetSize () - m_currentPktSent;
+        if (remaining <= budget) {
+            budget -= remaining;
+            Ptr<Packet> p = m_currentPkt;
+            m_currentPkt = NULL;
+            Deliver (p);
+        }
+        else {
+            /* the rest of the packet waits for the next opportunity */
+            m_currentPktSent += budget;
+            budget = 0;
+        }
+    }
+    m_busy = false;
+    if (m_currentPkt != NULL || !m_queue->IsEmpty ())
+        ScheduleOpportunity ();
+};
+
+void TraceLinkNetDevice::Receive (Ptr<Packet> p) {
+    if (m_receiveErrorModel && m_receiveErrorModel->IsCorrupt (p)) {
+        m_phyRxDropTrace (p);
+        return;
+    }
+    m_snifferTrace (p);
+    PppHeader ppp;
+    p->RemoveHeader (ppp);
+    uint16_t protocol = PppToEther (ppp.GetProtocol ());
+    if (!m_promiscCallback.IsNull ()) {
+        m_promiscCallback (this, p, protocol, GetBroadcast (), GetAddress (), NetDevice::PACKET_HOST);
+    }
+    m_rxCallback (this, p, protocol, GetBroadcast ());
+};
+
+bool TraceLinkNetDevice::Send (Ptr<Packet> packet, const Address & dest, uint16_t protocolNumber) {
+    if (!IsLinkUp ()) {
+        return false;
+    }
+    PppHeader ppp;
+    ppp.SetProtocol (EtherToPpp (protocolNumber));
+    packet->AddHeader (ppp);
+    if (!m_queue->Enqueue (packet)) {
+        return false;
+    }
+    if (m_deliveryTrace != NULL) {
+        if (!m_busy)
+            ScheduleOpportunity ();
+    }
+    else if (!m_busy) {
+        TransmitStart (m_queue->Dequeue ());
+    }
+    return true;
+};
+
+bool TraceLinkNetDevice::SendFrom (Ptr<Packet> packet, const Address & source, const Address & dest,
+    uint16_t protocolNumber) {
+    return false;
+};
+
+uint16_t TraceLinkNetDevice::PppToEther (uint16_t proto) {
+    switch (proto)
+    {
+    case 0x0021:
+        return 0x0800;   // IPv4
+    case 0x0057:
+        return 0x86DD;   // IPv6
+    default:
+        NS_ASSERT_MSG (false, "PPP Protocol number not defined!");
+    }
+    return 0;
+};
+
+uint16_t TraceLinkNetDevice::EtherToPpp (uint16_t proto) {
+    switch (proto)
+    {
+    case 0x0800:
+        return 0x0021;   // IPv4
+    case 0x86DD:
+        return 0x0057;   // IPv6
+    default:
+        NS_ASSERT_MSG (false, "PPP Protocol number not defined!");
+    }
+    return 0;
+};
+
+void TraceLinkNetDevice::SetIfIndex (const uint32_t index) { m_ifIndex = index; };
+uint32_t TraceLinkNetDevice::GetIfIndex () const { return m_ifIndex; };
+Ptr<Channel> TraceLinkNetDevice::GetChannel () const { return m_channel; };
+void TraceLinkNetDevice::SetAddress (Address address) { m_address = Mac48Address::ConvertFrom (address); };
+Address TraceLinkNetDevice::GetAddress () const { return m_address; };
+bool TraceLinkNetDevice::SetMtu (const uint16_t mtu) { m_mtu = mtu; return true; };
+uint16_t TraceLinkNetDevice::GetMtu () const { return m_mtu; };
+bool TraceLinkNetDevice::IsLinkUp () const { return m_linkUp; };
+void TraceLinkNetDevice::AddLinkChangeCallback (Callback<void> callback) { m_linkChangeCallbacks.ConnectWithoutContext (callback); };
+bool TraceLinkNetDevice::IsBroadcast () const { return true; };
+Address TraceLinkNetDevice::GetBroadcast () const { return Mac48Address ("ff:ff:ff:ff:ff:ff"); };
+bool TraceLinkNetDevice::IsMulticast () const { return true; };
+Address TraceLinkNetDevice::GetMulticast (Ipv4Address multicastGroup) const { return Mac48Address ("01:00:5e:00:00:00"); };
+Address TraceLinkNetDevice::GetMulticast (Ipv6Address addr) const { return Mac48Address ("33:33:00:00:00:00"); };
+bool TraceLinkNetDevice::IsPointToPoint () const { return true; };
+bool TraceLinkNetDevice::IsBridge () const { return false; };
+Ptr<Node> TraceLinkNetDevice::GetNode () const { return m_node; };
+void TraceLinkNetDevice::SetNode (Ptr<Node> node) { m_node = node; };
+bool TraceLinkNetDevice::NeedsArp () const { return false; };
+void TraceLinkNetDevice::SetReceiveCallback (NetDevice::ReceiveCallback cb) { m_rxCallback = cb; };
+void TraceLinkNetDevice::SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallback cb) { m_promiscCallback = cb; };
+bool TraceLinkNetDevice::SupportsSendFrom () const { return false; };
+
+/* TraceLinkHelper */
+
+TraceLinkHelper::TraceLinkHelper ()
+: m_traceStore {NULL}
+{
+    m_deviceFactory.SetTypeId ("ns3::TraceLinkNetDevice");
+    m_channelFactory.SetTypeId ("ns3::TraceLinkChannel");
+    m_queueFactory.SetTypeId ("ns3::DropTailQueue<Packet>");
+};
+
+void TraceLinkHelper::SetDeviceAttribute (std::string name, const AttributeValue & value) {
+    m_deviceFactory.Set (name, value);
+};
+
+void TraceLinkHelper::SetChannelAttribute (std::string name, const AttributeValue & value) {
+    m_channelFactory.Set (name, value);
+};
+
+void TraceLinkHelper::SetQueue (std::string type, std::string name, const AttributeValue & value) {
+    m_queueFactory.SetTypeId (type);
+    m_queueFactory.Set (name, value);
+};
+
+void TraceLinkHelper::SetTraceStore (Ptr<TraceStore> store, Time start, Time interval) {
+    m_traceStore = store;
+    m_traceStart = start;
+    m_traceInterval = interval;
+};
+
+NetDeviceContainer TraceLinkHelper::Install (NodeContainer c) {
+    NS_ASSERT (c.GetN () == 2);
+    NetDeviceContainer container;
+    Ptr<TraceLinkChannel> channel = m_channelFactory.Create<TraceLinkChannel> ();
+    for (uint32_t i = 0; i < 2; i++) {
+        Ptr<TraceLinkNetDevice> dev = m_deviceFactory.Create<TraceLinkNetDevice> ();
+        dev->SetAddress (Mac48Address::Allocate ());
+        c.Get (i)->AddDevice (dev);
+        Ptr<Queue<Packet>> queue = m_queueFactory.Create<Queue<Packet>> ();
+        dev->SetQueue (queue);
+        /* let the traffic control layer see the device queue, as PointToPointHelper does */
+        Ptr<NetDeviceQueueInterface> ndqi = CreateObject<NetDeviceQueueInterface> ();
+        ndqi->GetTxQueue (0)->ConnectQueueTraces (queue);
+        dev->AggregateObject (ndqi);
+        if (m_traceStore != NULL)
+            dev->SetTraceStore (m_traceStore, m_traceStart, m_traceInterval);
+        dev->Attach (channel);
+        container.Add (dev);
+    }
+    m_installed.Add (container);
+    return container;
+};
+
+void TraceLinkHelper::EnablePcapAll (std::string prefix) {
+    PcapHelper pcapHelper;
+    for (auto it = m_installed.Begin (); it != m_installed.End (); it++) {
+        Ptr<NetDevice> dev = *it;
+        std::ostringstream name;
+        name << prefix << "-" << dev->GetNode ()->GetId () << "-" << dev->GetIfIndex () << ".pcap";
+        Ptr<PcapFileWrapper> file = pcapHelper.CreateFile (name.str (), std::ios::out, PcapHelper::DLT_PPP);
+        pcapHelper.HookDefaultSink<TraceLinkNetDevice> (DynamicCast<TraceLinkNetDevice> (dev), "Sniffer", file);
+    }
+};
+
+}; // namespace ns3
@@ -0,0 +1,226 @@
+#ifndef TRACE_LINK_H
+#define TRACE_LINK_H
+
+#include "common-header.h"
+#include "trace-store.h"
+#include "mahimahi-trace.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+#include "ns3/node-container.h"
+#include "ns3/net-device-container.h"
+#include "ns3/object-factory.h"
+#include "ns3/queue.h"
+#include "ns3/data-rate.h"
+#include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/error-model.h"
+
+namespace ns3 {
+
+class TraceLinkNetDevice;
+
+/**
+ * \brief Point-to-point channel between two TraceLinkNetDevices. The
+ * propagation delay is decided by the sending device per packet.
+ */
+class TraceLinkChannel : public Channel {
+public:
+    static TypeId GetTypeId (void);
+    TraceLinkChannel ();
+    ~TraceLinkChannel ();
+
+    void Attach (Ptr<TraceLinkNetDevice> device);
+
+    /**
+     * \brief Deliver a packet to the peer of src after delay
+     */
+    void Transmit (Ptr<Packet> p, Ptr<TraceLinkNetDevice> src, Time delay);
+
+    std::size_t GetNDevices () const override;
+    Ptr<NetDevice> GetDevice (std::size_t i) const override;
+    Ptr<TraceLinkNetDevice> GetPeer (Ptr<const TraceLinkNetDevice> device) const;
+private:
+    Ptr<TraceLinkNetDevice> m_devices[2];
+    std::size_t m_nDevices;
+};  // class TraceLinkChannel
+
+/**
+ * \brief Point-to-point device whose rate, propagation delay and loss rate
+ * follow a TraceStore. The parameters of a packet are looked up from the
+ * trace sample of its transmission time, so the trace does not generate any
+ * event. Each of them can be bound to the trace or fixed by attributes:
+ *  - rate: TraceRateScale * bw of the sample, or DataRate if the scale is 0;
+ *  - delay: rtt / 2 - TraceDelayOffset of the sample if TraceDelay, or Delay;
+ *  - loss: loss rate of the sample if TraceLoss, plus ReceiveErrorModel of the peer.
+ * Packets never overtake each other when the delay decreases.
+ *
+ * With a Mahimahi delivery trace, the rate model is replaced by replaying the
+ * delivery opportunities exactly: each one releases up to MahimahiTrace::k_mtu
+ * bytes from the queue, and a packet larger than what is left waits for the
+ * next opportunity with its remaining bytes.
+ */
+class TraceLinkNetDevice : public NetDevice {
+public:
+    static TypeId GetTypeId (void);
+    TraceLinkNetDevice ();
+    ~TraceLinkNetDevice ();
+
+    /**
+     * \brief Bind the device to a trace
+     *
+     * \param store trace samples
+     * \param start time of the first sample
+     * \param interval duration of a sample
+     */
+    void SetTraceStore (Ptr<TraceStore> store, Time start, Time interval);
+
+    /**
+     * \brief Replay a Mahimahi delivery trace instead of serializing at a rate
+     *
+     * \param path Mahimahi trace, streamed from the file
+     * \param start time of timestamp 0 in the trace
+     */
+    void SetDeliveryTrace (std::string path, Time start);
+
+    bool Attach (Ptr<TraceLinkChannel> channel);
+    void SetQueue (Ptr<Queue<Packet>> queue);
+    Ptr<Queue<Packet>> GetQueue () const;
+
+    /**
+     * \brief Called by the channel when a packet arrives
+     */
+    void Receive (Ptr<Packet> p);
+
+    int64_t AssignStreams (int64_t stream);
+
+    DataRate GetCurrentRate () const;
+    Time GetCurrentDelay () const;
+    double_t GetCurrentLossRate () const;
+
+    /* Override NetDevice */
+    void SetIfIndex (const uint32_t index) override;
+    uint32_t GetIfIndex () const override;
+    Ptr<Channel> GetChannel () const override;
+    void SetAddress (Address address) override;
+    Address GetAddress () const override;
+    bool SetMtu (const uint16_t mtu) override;
+    uint16_t GetMtu () const override;
+    bool IsLinkUp () const override;
+    void AddLinkChangeCallback (Callback<void> callback) override;
+    bool IsBroadcast () const override;
+    Address GetBroadcast () const override;
+    bool IsMulticast () const override;
+    Address GetMulticast (Ipv4Address multicastGroup) const override;
+    Address GetMulticast (Ipv6Address addr) const override;
+    bool IsPointToPoint () const override;
+    bool IsBridge () const override;
+    bool Send (Ptr<Packet> packet, const Address & dest, uint16_t protocolNumber) override;
+    bool SendFrom (Ptr<Packet> packet, const Address & source, const Address & dest,
+        uint16_t protocolNumber) override;
+    Ptr<Node> GetNode () const override;
+    void SetNode (Ptr<Node> node) override;
+    bool NeedsArp () const override;
+    void SetReceiveCallback (NetDevice::ReceiveCallback cb) override;
+    void SetPromiscReceiveCallback (NetDevice::PromiscReceiveCallback cb) override;
+    bool SupportsSendFrom () const override;
+
+protected:
+    void DoDispose () override;
+
+private:
+    uint32_t GetSampleIndex () const;
+
+    /**
+     * \brief Start serializing a packet at the current rate
+     */
+    void TransmitStart (Ptr<Packet> p);
+    void TransmitComplete ();
+
+    /**
+     * \brief Apply the loss and the propagation delay, and hand the packet to the channel
+     */
+    void Deliver (Ptr<Packet> p);
+
+    void ScheduleOpportunity ();
+    void DeliveryOpportunity ();
+
+    static uint16_t PppToEther (uint16_t proto);
+    static uint16_t EtherToPpp (uint16_t proto);
+
+    Ptr<Node> m_node;
+    Ptr<TraceLinkChannel> m_channel;
+    Ptr<Queue<Packet>> m_queue;
+    Mac48Address m_address;
+    uint32_t m_ifIndex;
+    uint16_t m_mtu;
+    bool m_linkUp;
+    NetDevice::ReceiveCallback m_rxCallback;
+    NetDevice::PromiscReceiveCallback m_promiscCallback;
+    TracedCallback<> m_linkChangeCallbacks;
+
+    /* fixed parameters */
+    DataRate m_bps;
+    Time m_delay;
+    Ptr<ErrorModel> m_receiveErrorModel;
+
+    /* trace-bound parameters */
+    Ptr<TraceStore> m_traceStore;
+    Time m_traceStart;
+    Time m_traceInterval;
+    double_t m_traceRateScale;
+    bool m_traceDelay;
+    Time m_traceDelayOffset;
+    bool m_traceLoss;
+    Ptr<UniformRandomVariable> m_lossRv;
+
+    bool m_busy;
+    Ptr<Packet> m_currentPkt;
+    Time m_lastArrival;     /* keeps delivery in order */
+    EventId m_txEvent;
+
+    Ptr<MahimahiTrace> m_deliveryTrace;
+    Time m_deliveryStart;
+    uint32_t m_currentPktSent;  /* bytes of m_currentPkt delivered by earlier opportunities */
+
+    TracedCallback<Ptr<const Packet>> m_phyTxDropTrace;
+    TracedCallback<Ptr<const Packet>> m_phyRxDropTrace;
+    TracedCallback<Ptr<const Packet>> m_snifferTrace;
+};  // class TraceLinkNetDevice
+
+/**
+ * \brief Build TraceLinkNetDevices between two nodes, similar to PointToPointHelper
+ */
+class TraceLinkHelper {
+public:
+    TraceLinkHelper ();
+    void SetDeviceAttribute (std::string name, const AttributeValue & value);
+    void SetChannelAttribute (std::string name, const AttributeValue & value);
+    void SetQueue (std::string type, std::string name, const AttributeValue & value);
+    /**
+     * \brief Bind the devices created afterwards to a trace
+     */
+    void SetTraceStore (Ptr<TraceStore> store, Time start, Time interval);
+    /**
+     * \brief Install devices on the two nodes of c, the first one is returned first
+     */
+    NetDeviceContainer Install (NodeContainer c);
+    /**
+     * \brief Write pcap files <prefix>-<node>-<device>.pcap of all installed devices
+     */
+    void EnablePcapAll (std::string prefix);
+private:
+    ObjectFactory m_deviceFactory;
+    ObjectFactory m_channelFactory;
+    ObjectFactory m_queueFactory;
+    Ptr<TraceStore> m_traceStore;
+    Time m_traceStart;
+    Time m_traceInterval;
+    NetDeviceContainer m_installed;
+};  // class TraceLinkHelper
+
+};  // namespace ns3
+
+#endif  /* TRACE_LINK_H */
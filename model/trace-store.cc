@@ -0,0 +1,228 @@
+#include "trace-store.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/fatal-error.h"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("TraceStore");
+
+const char TraceStore::k_magic[8] = {'S', 'R', 'T', 'C', 'T', 'R', 'C', '1'};
+
+std::unordered_map<std::string, Ptr<TraceStore>> TraceStore::s_stores;
+
+TypeId TraceStore::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::TraceStore")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<TraceStore> ()
+    ;
+    return tid;
+};
+
+TraceStore::TraceStore ()
+: m_count {0}
+, m_bw {nullptr}
+, m_rtt {nullptr}
+, m_loss {nullptr}
+, m_geP {nullptr}
+, m_geR {nullptr}
+, m_map {nullptr}
+, m_mapLen {0}
+, m_columns {}
+{};
+
+TraceStore::~TraceStore () {
+    if (m_map != nullptr)
+        munmap (m_map, m_mapLen);
+};
+
+Ptr<TraceStore> TraceStore::Get (std::string path) {
+    auto it = s_stores.find (path);
+    if (it != s_stores.end ())
+        return it->second;
+    Ptr<TraceStore> store = CreateObject<TraceStore> ();
+    store->Load (path);
+    s_stores[path] = store;
+    return store;
+};
+
+void TraceStore::Load (std::string path) {
+    if (!LoadBinary (path))
+        LoadText (path);
+    if (m_count == 0)
+        NS_FATAL_ERROR ("Trace file has no valid sample! " + path);
+    NS_LOG_INFO ("[TraceStore] " << path << " loaded, " << m_count << " samples");
+};
+
+bool TraceStore::LoadBinary (std::string path) {
+    int fd = open (path.c_str (), O_RDONLY);
+    if (fd < 0)
+        NS_FATAL_ERROR ("Trace file fail to open! " + path);
+    struct stat st;
+    if (fstat (fd, &st) < 0 || (size_t) st.st_size < sizeof (BinaryHeader)) {
+        close (fd);
+        return false;
+    }
+    BinaryHeader header;
+    if (read (fd, &header, sizeof (header)) != sizeof (header)
+        || memcmp (header.magic, k_magic, sizeof (k_magic)) != 0) {
+        close (fd);
+        return false;
+    }
+    size_t columns = header.version == 2 ? 5 : 3;
+    size_t len = sizeof (BinaryHeader) + columns * (size_t) header.count * sizeof (float);
+    if ((header.version != 1 && header.version != 2) || (size_t) st.st_size < len) {
+        close (fd);
+        NS_FATAL_ERROR ("Binary trace is corrupted! " + path);
+    }
+    void * addr = mmap (nullptr, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (addr == MAP_FAILED)
+        NS_FATAL_ERROR ("Binary trace fail to mmap! " + path);
+    m_map = addr;
+    m_mapLen = len;
+    m_count = header.count;
+    m_bw = (const float *) ((const char *) addr + sizeof (BinaryHeader));
+    m_rtt = m_bw + m_count;
+    m_loss = m_rtt + m_count;
+    if (columns == 5) {
+        m_geP = m_loss + m_count;
+        m_geR = m_geP + m_count;
+    }
+    return true;
+};
+
+void TraceStore::LoadText (std::string path) {
+    std::ifstream traceFile (path);
+    if (traceFile.fail ())
+        NS_FATAL_ERROR ("Trace file fail to open! " + path);
+    std::vector<float> bw, rtt, loss, geP, geR;
+    bool hasBurst = false;
+    std::string line;
+    float values[5];
+    while (std::getline (traceFile, line)) {
+        if (line.compare (0, 2, "//") == 0 || line.compare (0, 1, "#") == 0)
+            continue;
+        /* a line without separators ends the trace, same as the former readers */
+        int n = ParseColumns (line, values, 5);
+        if (n < 3)
+            break;
+        bw.push_back (values[0]);
+        rtt.push_back (values[1]);
+        loss.push_back (values[2]);
+        if (n == 5) {
+            hasBurst = true;
+            geP.push_back (values[3]);
+            geR.push_back (values[4]);
+        }
+        else {
+            geP.push_back (NAN);
+            geR.push_back (NAN);
+        }
+    }
+    m_count = bw.size ();
+    m_columns.reserve ((hasBurst ? 5 : 3) * m_count);
+    m_columns.insert (m_columns.end (), bw.begin (), bw.end ());
+    m_columns.insert (m_columns.end (), rtt.begin (), rtt.end ());
+    m_columns.insert (m_columns.end (), loss.begin (), loss.end ());
+    if (hasBurst) {
+        m_columns.insert (m_columns.end (), geP.begin (), geP.end ());
+        m_columns.insert (m_columns.end (), geR.begin (), geR.end ());
+    }
+    m_bw = m_columns.data ();
+    m_rtt = m_bw + m_count;
+    m_loss = m_rtt + m_count;
+    if (hasBurst) {
+        m_geP = m_loss + m_count;
+        m_geR = m_geP + m_count;
+    }
+};
+
+bool TraceStore::ParseLine (const std::string & line, float & bw, float & rtt, float & loss) {
+    float values[3];
+    if (ParseColumns (line, values, 3) < 3)
+        return false;
+    bw = values[0];
+    rtt = values[1];
+    loss = values[2];
+    return true;
+};
+
+int TraceStore::ParseColumns (const std::string & line, float * values, int maxColumns) {
+    if (line.find (' ') == std::string::npos)
+        return 0;
+    const char * p = line.c_str ();
+    char * end;
+    int n = 0;
+    while (n < maxColumns) {
+        float v = std::strtof (p, &end);
+        if (end == p)
+            break;
+        values[n++] = v;
+        /* skip the unit ("Mbps", "ms") and the separator */
+        p = end;
+        while (*p != '\0' && *p != ' ' && *p != '\t')
+            p++;
+        while (*p == ' ' || *p == '\t')
+            p++;
+    }
+    return n;
+};
+
+uint32_t TraceStore::ConvertToBinary (std::string textPath, std::string binPath) {
+    Ptr<TraceStore> store = CreateObject<TraceStore> ();
+    store->LoadText (textPath);
+
+    std::ofstream out (binPath, std::ios::binary | std::ios::trunc);
+    if (out.fail ())
+        NS_FATAL_ERROR ("Binary trace fail to open! " + binPath);
+    BinaryHeader header;
+    memcpy (header.magic, k_magic, sizeof (k_magic));
+    header.version = store->HasBurstParams () ? 2 : 1;
+    header.count = store->m_count;
+    out.write ((const char *) &header, sizeof (header));
+    out.write ((const char *) store->m_columns.data (), store->m_columns.size () * sizeof (float));
+    return store->m_count;
+};
+
+uint32_t TraceStore::GetSize () const {
+    return m_count;
+};
+
+double_t TraceStore::GetBwMbps (uint32_t index) const {
+    NS_ASSERT (index < m_count);
+    return m_bw[index];
+};
+
+double_t TraceStore::GetRttMs (uint32_t index) const {
+    NS_ASSERT (index < m_count);
+    return m_rtt[index];
+};
+
+double_t TraceStore::GetLossRate (uint32_t index) const {
+    NS_ASSERT (index < m_count);
+    return m_loss[index];
+};
+
+bool TraceStore::HasBurstParams () const {
+    return m_geP != nullptr;
+};
+
+double_t TraceStore::GetGoodToBad (uint32_t index) const {
+    NS_ASSERT (index < m_count);
+    return m_geP == nullptr ? NAN : m_geP[index];
+};
+
+double_t TraceStore::GetBadToGood (uint32_t index) const {
+    NS_ASSERT (index < m_count);
+    return m_geR == nullptr ? NAN : m_geR[index];
+};
+
+}; // namespace ns3
@@ -0,0 +1,110 @@
+#ifndef TRACE_STORE_H
+#define TRACE_STORE_H
+
+#include "common-header.h"
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include <cmath>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+namespace ns3 {
+
+/**
+ * \brief Network trace (bandwidth, RTT, loss rate per sample) loaded once and
+ * shared by all consumers in the process.
+ *
+ * Two input formats are accepted:
+ *  - the text format of examples/sample.tr, one "<bw>Mbps <rtt>ms <loss>"
+ *    sample per line ("//" and "#" lines are comments), parsed once.
+ *    Two optional columns "<p> <r>" give the Gilbert-Elliott good->bad and
+ *    bad->good transition probabilities of the sample;
+ *  - the binary columnar format written by ConvertToBinary, which is
+ *    memory-mapped and used in place.
+ * Samples are accessed in O(1) by index.
+ */
+class TraceStore : public Object {
+public:
+    static TypeId GetTypeId (void);
+    TraceStore ();
+    ~TraceStore ();
+
+    /**
+     * \brief Get the store of a trace file, loading it on the first call
+     *
+     * \param path trace file in text or binary format
+     */
+    static Ptr<TraceStore> Get (std::string path);
+
+    /**
+     * \brief Convert a text trace into the binary columnar format
+     *
+     * \return number of samples written
+     */
+    static uint32_t ConvertToBinary (std::string textPath, std::string binPath);
+
+    /**
+     * \brief Parse one "<bw>Mbps <rtt>ms <loss>" line
+     *
+     * \return false if the line is not a sample
+     */
+    static bool ParseLine (const std::string & line, float & bw, float & rtt, float & loss);
+
+    /**
+     * \brief Parse up to maxColumns numbers of a sample line, ignoring units
+     *
+     * \return number of columns parsed
+     */
+    static int ParseColumns (const std::string & line, float * values, int maxColumns);
+
+    uint32_t GetSize () const;
+    double_t GetBwMbps (uint32_t index) const;
+    double_t GetRttMs (uint32_t index) const;
+    double_t GetLossRate (uint32_t index) const;
+
+    /**
+     * \brief Whether the trace has the burst loss columns
+     */
+    bool HasBurstParams () const;
+    /**
+     * \return good->bad transition probability, NaN if the sample does not give it
+     */
+    double_t GetGoodToBad (uint32_t index) const;
+    /**
+     * \return bad->good transition probability, NaN if the sample does not give it
+     */
+    double_t GetBadToGood (uint32_t index) const;
+
+    /* Binary layout: header, then bw[n], rtt[n] and loss[n] as float32 columns,
+       followed by p[n] and r[n] in version 2 */
+    static const char k_magic[8];
+    struct BinaryHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t count;
+    };
+
+private:
+    void Load (std::string path);
+    bool LoadBinary (std::string path);
+    void LoadText (std::string path);
+
+    uint32_t m_count;
+    const float * m_bw;     /* Mbps */
+    const float * m_rtt;    /* ms */
+    const float * m_loss;   /* [0, 1] */
+    const float * m_geP;    /* NULL if the trace has no burst loss columns */
+    const float * m_geR;
+
+    /* backing storage: either a mapped binary file or parsed columns */
+    void * m_map;
+    size_t m_mapLen;
+    std::vector<float> m_columns;
+
+    static std::unordered_map<std::string, Ptr<TraceStore>> s_stores;
+};  // class TraceStore
+
+};  // namespace ns3
+
+#endif  /* TRACE_STORE_H */
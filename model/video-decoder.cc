@@ -17,6 +17,7 @@ VideoFrame::VideoFrame(Ptr<DataPacket> pkt) {
     this->first_pkt_rcv_time = pkt->GetRcvTime();
     this->last_pkt_rcv_time = pkt->GetRcvTime();
     this->encode_time = pkt->GetEncodeTime();
+    this->data_bytes = 0;
     this->AddPacket(pkt);
 };
 
@@ -27,7 +28,8 @@ void VideoFrame::AddPacket(Ptr<DataPacket> pkt) {
         this->last_pkt_rcv_time = pkt->GetRcvTime();
     if(pkt->GetEncodeTime() < this->encode_time)
         this->encode_time = pkt->GetEncodeTime();
-    this->pkts.insert(pkt->GetPktIdFrame());
+    if(this->pkts.insert(pkt->GetPktIdFrame()).second)
+        this->data_bytes += pkt->GetPayloadSize();
 };
 
 uint16_t VideoFrame::GetDataPktNum() { return this->data_pkt_num; };
@@ -48,6 +50,8 @@ Time VideoFrame::GetLastRcvTime() {
     return this->last_pkt_rcv_time;
 }
 
+uint32_t VideoFrame::GetDataBytes() { return this->data_bytes; };
+
 
 TypeId VideoDecoder::GetTypeId() {
     static TypeId tid = TypeId ("ns3::VideoDecoder")
@@ -66,6 +70,10 @@ VideoDecoder::VideoDecoder (Time delayDdl, GameClient * gameClient, Ptr<OutputSt
     m_gameClient = gameClient;
     m_appStream = appStream;
     m_funcReplyFrameAck = ReplyFrameAck;
+    m_lateFrameCnt = 0;
+    m_frameDelaySum = Time (0);
+    m_minFrameDelay = Time::Max ();
+    m_playedBytes = 0;
 };
 
 VideoDecoder::VideoDecoder () {
@@ -102,6 +110,11 @@ void VideoDecoder::DecodeDataPacket (std::vector<Ptr<DataPacket>> pkts) {
                 " played at " << now.GetMilliSeconds () << 
                 " missddl? " << (m_playedFrames[frameId]->GetFrameDelay () > m_delayDdl) << std::endl;
             NS_ASSERT (m_playedFrames[frameId]->GetFrameDelay () == now - m_playedFrames[frameId]->GetEncodeTime ());
+            m_frameDelaySum += m_playedFrames[frameId]->GetFrameDelay ();
+            m_minFrameDelay = std::min (m_minFrameDelay, m_playedFrames[frameId]->GetFrameDelay ());
+            m_playedBytes += m_playedFrames[frameId]->GetDataBytes ();
+            if (m_playedFrames[frameId]->GetFrameDelay () > m_delayDdl)
+                m_lateFrameCnt ++;
         }
     }
 };
@@ -134,4 +147,29 @@ double_t VideoDecoder::GetDDLMissRate() {
 
     return ddl_miss_rate;
 };
+
+uint64_t VideoDecoder::GetFrameCount () {
+    if (m_playedFrames.empty () && m_unplayedFrames.empty ())
+        return 0;
+    return m_curMaxFrameId - m_curMinFrameId + 1;
+};
+
+uint64_t VideoDecoder::GetPlayedFrameCount () { return m_playedFrames.size (); };
+
+uint64_t VideoDecoder::GetLateFrameCount () { return m_lateFrameCnt; };
+
+Time VideoDecoder::GetMeanFrameDelay () {
+    if (m_playedFrames.empty ())
+        return Time (0);
+    return m_frameDelaySum / (int64_t) m_playedFrames.size ();
+};
+
+Time VideoDecoder::GetMinFrameDelay () {
+    if (m_playedFrames.empty ())
+        return Time (0);
+    return m_minFrameDelay;
+};
+
+uint64_t VideoDecoder::GetPlayedBytes () { return m_playedBytes; };
+
 };
\ No newline at end of file
@@ -20,6 +20,7 @@ class VideoFrame : public Object {
     Time first_pkt_rcv_time, last_pkt_rcv_time;
     std::unordered_set<uint16_t> group_ids;
     std::unordered_set<uint16_t> pkts;
+    uint32_t data_bytes;
 public:
     static TypeId GetTypeId (void);
     VideoFrame(Ptr<DataPacket> pkt);
@@ -31,6 +32,7 @@ public:
     Time GetFrameDelay();
     Time GetEncodeTime();
     Time GetLastRcvTime();
+    uint32_t GetDataBytes();
 };
 
 class VideoDecoder : public Object {
@@ -51,10 +53,35 @@ private:
     void (GameClient::*m_funcReplyFrameAck)(uint32_t, Time);
 
     Ptr<OutputStreamWrapper> m_appStream;
+
+    /* statistics of the played frames */
+    uint64_t m_lateFrameCnt;    /* played after the deadline */
+    Time m_frameDelaySum;
+    Time m_minFrameDelay;
+    uint64_t m_playedBytes;
 public:
     void DecodeDataPacket(std::vector<Ptr<DataPacket>> pkts);
     double_t GetDDLMissRate();
 
+    /**
+     * \brief Number of frames between the first and the last frame seen
+     */
+    uint64_t GetFrameCount();
+    uint64_t GetPlayedFrameCount();
+    uint64_t GetLateFrameCount();
+    /**
+     * \brief Mean delay from encoding to playing of the played frames
+     */
+    Time GetMeanFrameDelay();
+    /**
+     * \brief Lowest delay of the played frames, the delay of an empty path
+     */
+    Time GetMinFrameDelay();
+    /**
+     * \brief Data payload bytes of the played frames
+     */
+    uint64_t GetPlayedBytes();
+
 }; // class VideoDecoder
 
 }; // namespace ns3
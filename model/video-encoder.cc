@@ -1,4 +1,10 @@
 #include "video-encoder.h"
+#include "ns3/log.h"
+#include <cmath>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace ns3 {
 NS_LOG_COMPONENT_DEFINE("VideoEncoder");
@@ -79,4 +85,152 @@ void DumbVideoEncoder::EncodeFrame() {
     // if(this->frame_count % (this->fps * 10) == 0)
     //     DEBUG(Simulator::Now().GetSeconds());
 };
-}
\ No newline at end of file
+
+TypeId FrameTraceEncoder::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::FrameTraceEncoder")
+        .SetParent<VideoEncoder> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<FrameTraceEncoder> ()
+    ;
+    return tid;
+};
+
+FrameTraceEncoder::FrameTraceEncoder (uint8_t fps, uint32_t bitrate, std::string traceFile, Time rcDelay,
+    GameServer * game_server, void (GameServer::*SendFrameFunc)(uint8_t *, uint32_t)) :
+    VideoEncoder(fps, game_server, SendFrameFunc),
+    m_trace {nullptr},
+    m_traceLen {0},
+    m_cursor {0},
+    m_traceBps {0},
+    m_rcDelay {rcDelay},
+    m_rcBitrate {(double_t) bitrate},
+    m_lastEncodeTime {Time (0)},
+    m_lastFrameType {P_FRAME},
+    frame_count {0},
+    key_frame_count {0} {
+    this->bitrate = bitrate;
+
+    int fd = open (traceFile.c_str (), O_RDONLY);
+    if (fd < 0)
+        NS_FATAL_ERROR ("Frame trace fail to open! " + traceFile);
+    struct stat st;
+    if (fstat (fd, &st) < 0 || st.st_size == 0) {
+        close (fd);
+        NS_FATAL_ERROR ("Frame trace is empty! " + traceFile);
+    }
+    m_traceLen = st.st_size;
+    void * addr = mmap (nullptr, m_traceLen, PROT_READ, MAP_PRIVATE, fd, 0);
+    close (fd);
+    if (addr == MAP_FAILED)
+        NS_FATAL_ERROR ("Frame trace fail to mmap! " + traceFile);
+    madvise (addr, m_traceLen, MADV_SEQUENTIAL);
+    m_trace = (const char *) addr;
+
+    /* One pass over the trace to get its mean bitrate for scaling */
+    FrameType type;
+    uint32_t size, interval_us;
+    double_t totalBits = 0, totalUs = 0;
+    while (NextFrame (type, size, interval_us)) {
+        totalBits += size * 8.;
+        totalUs += interval_us;
+    }
+    if (totalUs == 0)
+        NS_FATAL_ERROR ("Frame trace has no valid frame! " + traceFile);
+    m_traceBps = totalBits / totalUs * 1e6;
+    m_cursor = 0;
+    NS_LOG_INFO ("[FrameTraceEncoder] " << traceFile << " mean bitrate " << m_traceBps / 1e6 << " Mbps");
+};
+
+FrameTraceEncoder::FrameTraceEncoder () :
+    m_trace {nullptr},
+    m_traceLen {0},
+    m_cursor {0} {};
+
+FrameTraceEncoder::~FrameTraceEncoder () {
+    if (m_trace != nullptr)
+        munmap ((void *) m_trace, m_traceLen);
+};
+
+FrameTraceEncoder::FrameType FrameTraceEncoder::GetLastFrameType () {
+    return m_lastFrameType;
+};
+
+uint64_t FrameTraceEncoder::GetKeyFrameCount () {
+    return this->key_frame_count;
+};
+
+bool FrameTraceEncoder::NextFrame (FrameType & type, uint32_t & size, uint32_t & interval_us) {
+    while (m_cursor < m_traceLen) {
+        /* skip blank lines and comments */
+        char c = m_trace[m_cursor];
+        if (c == '\n' || c == '\r' || c == ' ' || c == '\t') {
+            m_cursor ++;
+            continue;
+        }
+        if (c == '#') {
+            while (m_cursor < m_traceLen && m_trace[m_cursor] != '\n')
+                m_cursor ++;
+            continue;
+        }
+        type = (c == 'I' || c == 'i' || c == 'K' || c == 'k') ? I_FRAME : P_FRAME;
+        /* the type column is optional, frames without it are P frames */
+        if (c < '0' || c > '9')
+            m_cursor ++;
+
+        /* read up to two unsigned integers on this line */
+        uint64_t values[2] = {0, 0};
+        int found = 0;
+        while (m_cursor < m_traceLen && m_trace[m_cursor] != '\n') {
+            c = m_trace[m_cursor];
+            if (c >= '0' && c <= '9') {
+                uint64_t v = 0;
+                while (m_cursor < m_traceLen && m_trace[m_cursor] >= '0' && m_trace[m_cursor] <= '9')
+                    v = v * 10 + (m_trace[m_cursor ++] - '0');
+                if (found < 2)
+                    values[found] = v;
+                found ++;
+            }
+            else
+                m_cursor ++;
+        }
+        if (found == 0)
+            continue;
+        size = (uint32_t) values[0];
+        interval_us = (found > 1 && values[1] > 0) ? (uint32_t) values[1] : (uint32_t) (1e6 / this->fps);
+        return true;
+    }
+    return false;
+};
+
+void FrameTraceEncoder::EncodeFrame () {
+    NS_ASSERT (m_trace != nullptr);
+    FrameType type;
+    uint32_t size, interval_us;
+    if (!NextFrame (type, size, interval_us)) {
+        m_cursor = 0;
+        NextFrame (type, size, interval_us);
+    }
+
+    /* rate control converges to the CC target with time constant m_rcDelay */
+    Time now = Simulator::Now ();
+    if (m_rcDelay.IsZero () || frame_count == 0)
+        m_rcBitrate = this->bitrate;
+    else {
+        double_t alpha = 1 - std::exp (- (now - m_lastEncodeTime).GetSeconds () / m_rcDelay.GetSeconds ());
+        m_rcBitrate += alpha * ((double_t) this->bitrate - m_rcBitrate);
+    }
+    m_lastEncodeTime = now;
+
+    uint32_t frame_size = (uint32_t) std::round (size * m_rcBitrate * 1000. / m_traceBps);
+    m_lastFrameType = type;
+    if (type == I_FRAME)
+        this->key_frame_count ++;
+    NS_LOG_DEBUG ("[FrameTraceEncoder] " << now.GetMilliSeconds () << " frame " << this->frame_count <<
+        (type == I_FRAME ? " I " : " P ") << frame_size << " B, rc bitrate " << m_rcBitrate << " kbps");
+
+    ((this->game_server)->*SendFrameFunc)(nullptr, frame_size);
+    this->encode_event = Simulator::Schedule (MicroSeconds (interval_us), &FrameTraceEncoder::EncodeFrame, this);
+    this->frame_count ++;
+};
+
+}
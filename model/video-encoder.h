@@ -71,6 +71,57 @@ private:
     virtual void EncodeFrame();
 };  // class VideoEncoder
 
+/**
+ * \brief Encoder that replays per-frame sizes and types recorded from a real
+ * encoder. Each line of the trace is "<I|P> <size in bytes> [interval in us]".
+ * The file is memory-mapped and read one line per frame, so the cost of a
+ * frame is constant regardless of the trace length. Frame sizes are scaled
+ * by (target bitrate / mean trace bitrate), where the target follows the
+ * bitrate set by CC with a first-order lag of m_rcDelay to mimic encoder
+ * rate control. The trace is replayed from the start once it is exhausted.
+ */
+class FrameTraceEncoder : public VideoEncoder {
+public:
+    static TypeId GetTypeId (void);
+    /**
+     * @param fps default fps, used when the trace has no interval column
+     * @param bitrate initial target bitrate in kbps
+     * @param traceFile per-frame size trace
+     * @param rcDelay rate-control response time constant, 0 for immediate response
+     */
+    FrameTraceEncoder (uint8_t fps, uint32_t bitrate, std::string traceFile, Time rcDelay,
+        GameServer *, void (GameServer::*SendFrameFunc)(uint8_t *, uint32_t));
+    FrameTraceEncoder ();
+    ~FrameTraceEncoder ();
+
+    enum FrameType { I_FRAME, P_FRAME };
+
+    FrameType GetLastFrameType ();
+    uint64_t GetKeyFrameCount ();
+private:
+    const char * m_trace;       /* mmap-ed trace file */
+    size_t m_traceLen;
+    size_t m_cursor;            /* offset of the next line in m_trace */
+    double_t m_traceBps;        /* mean bitrate of the trace */
+
+    Time m_rcDelay;
+    double_t m_rcBitrate;       /* bitrate the rate control currently aims at, in kbps */
+    Time m_lastEncodeTime;
+
+    FrameType m_lastFrameType;
+    uint64_t frame_count;
+    uint64_t key_frame_count;
+
+    /**
+     * \brief Parse the line at m_cursor and advance to the next line
+     *
+     * \return false if there is no valid line left before the end of file
+     */
+    bool NextFrame (FrameType & type, uint32_t & size, uint32_t & interval_us);
+
+    virtual void EncodeFrame ();
+};  // class FrameTraceEncoder
+
 };  // namespace ns3
 
 #endif  /* VIDEO_ENCODER_H */
\ No newline at end of file
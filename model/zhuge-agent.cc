@@ -0,0 +1,174 @@
+#include "zhuge-agent.h"
+#include "ns3/log.h"
+#include "ns3/assert.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/pointer.h"
+#include "ns3/data-rate.h"
+#include "ns3/udp-header.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/traffic-control-layer.h"
+
+namespace ns3 {
+NS_LOG_COMPONENT_DEFINE("ZhugeAgent");
+
+TypeId ZhugeAgent::GetTypeId() {
+    static TypeId tid = TypeId ("ns3::ZhugeAgent")
+        .SetParent<Object> ()
+        .SetGroupName("sparkrtc")
+        .AddConstructor<ZhugeAgent> ()
+    ;
+    return tid;
+};
+
+ZhugeAgent::ZhugeAgent ()
+: m_ports {}
+, m_feedbackInterval {MilliSeconds (1)}
+, m_ipv4 {NULL}
+, m_interface {0}
+, m_devQueue {NULL}
+, m_queueDisc {NULL}
+, m_rateBps {0}
+, m_lastDequeue {Time (0)}
+, m_lastDequeueSize {0}
+, m_lastDequeueBacklogged {false}
+, m_lastPrediction {Time (0)}
+, m_pending {}
+, m_flushEvent {}
+, m_hintCnt {0}
+, m_predictionSum {Time (0)}
+{};
+
+ZhugeAgent::~ZhugeAgent () {
+    Simulator::Cancel (m_flushEvent);
+};
+
+void ZhugeAgent::AddFlowPorts (uint16_t basePort, uint16_t nPorts) {
+    m_ports.push_back (std::make_pair (basePort, nPorts));
+};
+
+void ZhugeAgent::SetFeedbackInterval (Time interval) {
+    m_feedbackInterval = interval;
+};
+
+void ZhugeAgent::Install (Ptr<NetDevice> bottleneck) {
+    NS_ASSERT_MSG (m_ipv4 == NULL, "ZhugeAgent can only be installed once");
+    Ptr<Node> router = bottleneck->GetNode ();
+    m_ipv4 = router->GetObject<Ipv4L3Protocol> ();
+    NS_ASSERT_MSG (m_ipv4 != NULL, "ZhugeAgent needs the internet stack on the router");
+    int32_t interface = m_ipv4->GetInterfaceForDevice (bottleneck);
+    NS_ASSERT_MSG (interface >= 0, "ZhugeAgent must be installed after the address assignment");
+    m_interface = interface;
+
+    PointerValue queue;
+    bottleneck->GetAttribute ("TxQueue", queue);
+    m_devQueue = queue.Get<Queue<Packet>> ();
+    m_devQueue->TraceConnectWithoutContext ("Dequeue", MakeCallback (&ZhugeAgent::OnDequeue, this));
+    Ptr<TrafficControlLayer> tc = router->GetObject<TrafficControlLayer> ();
+    if (tc != NULL)
+        m_queueDisc = tc->GetRootQueueDiscOnDevice (bottleneck);
+
+    /* the configured rate until the queue has been backlogged */
+    DataRateValue rate;
+    if (bottleneck->GetAttributeFailSafe ("DataRate", rate))
+        m_rateBps = rate.Get ().GetBitRate ();
+
+    m_ipv4->TraceConnectWithoutContext ("UnicastForward", MakeCallback (&ZhugeAgent::OnForward, this));
+    NS_LOG_INFO ("[Zhuge] router " << router->GetId () << " interface " << m_interface
+        << " queue disc " << (m_queueDisc != NULL));
+};
+
+uint32_t ZhugeAgent::GetBacklog () const {
+    uint32_t backlog = m_devQueue->GetNBytes ();
+    if (m_queueDisc != NULL)
+        backlog += m_queueDisc->GetNBytes ();
+    return backlog;
+};
+
+void ZhugeAgent::OnDequeue (Ptr<const Packet> packet) {
+    Time now = Simulator::Now ();
+    /* the time between two dequeues of a backlogged queue is the service
+       time of the first packet */
+    if (m_lastDequeueBacklogged && now > m_lastDequeue) {
+        double_t sample = m_lastDequeueSize * 8 / (now - m_lastDequeue).GetSeconds ();
+        m_rateBps = m_rateBps == 0 ? sample : 0.875 * m_rateBps + 0.125 * sample;
+    }
+    m_lastDequeue = now;
+    m_lastDequeueSize = packet->GetSize ();
+    m_lastDequeueBacklogged = GetBacklog () > 0;
+};
+
+Time ZhugeAgent::PredictQueueDelay (uint32_t size) const {
+    if (m_rateBps <= 0)
+        return Time (0);
+    return Seconds ((GetBacklog () + size) * 8 / m_rateBps);
+};
+
+void ZhugeAgent::OnForward (const Ipv4Header & header, Ptr<const Packet> packet, uint32_t interface) {
+    if (interface != m_interface || header.GetProtocol () != UdpL4Protocol::PROT_NUMBER)
+        return;
+    Ptr<Packet> copy = packet->Copy ();
+    UdpHeader udp;
+    copy->RemoveHeader (udp);
+    uint16_t port = udp.GetDestinationPort ();
+    bool media = false;
+    for (auto range : m_ports)
+        media |= port >= range.first && port - range.first < range.second;
+    if (!media)
+        return;
+    Ptr<VideoPacket> video = DynamicCast<VideoPacket, NetworkPacket> (NetworkPacket::ToInstance (copy));
+    if (video == NULL)
+        return;
+
+    /* fortune teller: the packet leaves the router after the current backlog */
+    Time delay = PredictQueueDelay (packet->GetSize () + header.GetSerializedSize ());
+    Time arrival = Simulator::Now () + delay;
+    FlowKey flow = std::make_tuple (header.GetSource ().Get (), udp.GetSourcePort (),
+        header.GetDestination ().Get (), port);
+    m_pending[flow].push_back (Create<RcvTime> (video->GetGlobalId (), arrival.GetMicroSeconds (), packet->GetSize ()));
+    m_lastPrediction = delay;
+    m_hintCnt ++;
+    m_predictionSum += delay;
+
+    if (m_feedbackInterval.IsZero ())
+        Flush ();
+    else if (!m_flushEvent.IsRunning ())
+        m_flushEvent = Simulator::Schedule (m_feedbackInterval, &ZhugeAgent::Flush, this);
+};
+
+void ZhugeAgent::Flush () {
+    for (auto & item : m_pending) {
+        if (!item.second.empty ())
+            SendHints (item.first, item.second);
+    }
+    m_pending.clear ();
+};
+
+void ZhugeAgent::SendHints (const FlowKey & flow, std::vector<Ptr<RcvTime>> hints) {
+    /* feedback updater: the hints go to the media sender on behalf of the
+       receiver, so that they reach the socket of the flow */
+    Ipv4Address sender (std::get<0> (flow));
+    Ipv4Address receiver (std::get<2> (flow));
+    Ptr<DelayHintPacket> hint = Create<DelayHintPacket> (hints, m_lastPrediction, m_rateBps / 1000);
+    Ptr<Packet> packet = hint->ToNetPacket ();
+    UdpHeader udp;
+    udp.SetSourcePort (std::get<3> (flow));
+    udp.SetDestinationPort (std::get<1> (flow));
+    if (Node::ChecksumEnabled ()) {
+        udp.EnableChecksums ();
+        udp.InitializeChecksum (receiver, sender, UdpL4Protocol::PROT_NUMBER);
+    }
+    packet->AddHeader (udp);
+    m_ipv4->Send (packet, receiver, sender, UdpL4Protocol::PROT_NUMBER, NULL);
+    NS_LOG_FUNCTION ("[Zhuge] " << hints.size () << " hints to " << sender << ":" << std::get<1> (flow)
+        << " predicted delay " << m_lastPrediction.GetMicroSeconds () << "us");
+};
+
+void ZhugeAgent::Report (std::ostream & os) const {
+    os << "zhuge hints " << m_hintCnt
+       << " mean predicted queuing delay "
+       << (m_hintCnt > 0 ? m_predictionSum.GetMicroSeconds () / 1e3 / m_hintCnt : 0) << "ms"
+       << " dequeue rate " << m_rateBps / 1e6 << "Mbps" << std::endl;
+};
+
+}; // namespace ns3
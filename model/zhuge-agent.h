@@ -0,0 +1,98 @@
+#ifndef ZHUGE_AGENT_H
+#define ZHUGE_AGENT_H
+
+#include "common-header.h"
+#include "network-packet.h"
+#include "ns3/object.h"
+#include "ns3/net-device.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-header.h"
+#include "ns3/queue.h"
+#include "ns3/queue-disc.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include <map>
+#include <ostream>
+#include <tuple>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \brief In-network feedback at the router in front of the bottleneck, after
+ * Zhuge (SIGCOMM'22).
+ *
+ * The fortune teller watches the bottleneck queue (queue disc and device
+ * queue) and its dequeue rate, and predicts for every media packet forwarded
+ * to the bottleneck when it will leave the router. The feedback updater sends
+ * these predictions to the media sender in DelayHintPackets, on behalf of the
+ * receiver, so that the congestion controller sees the queue build up one
+ * bottleneck queue and one return path earlier than with the receiver
+ * feedback.
+ */
+class ZhugeAgent : public Object {
+public:
+    static TypeId GetTypeId (void);
+    ZhugeAgent ();
+    ~ZhugeAgent ();
+
+    /**
+     * \brief Media flows to give feedback for, by destination port
+     */
+    void AddFlowPorts (uint16_t basePort, uint16_t nPorts);
+
+    /**
+     * \brief Hints are batched for interval, 0 sends one DelayHintPacket per
+     * media packet
+     */
+    void SetFeedbackInterval (Time interval);
+
+    /**
+     * \brief Watch the queues of the bottleneck device and the media packets
+     * forwarded to it. Call after the IP addresses are assigned.
+     *
+     * \param bottleneck device of the router towards the bottleneck
+     */
+    void Install (Ptr<NetDevice> bottleneck);
+
+    /**
+     * \brief Predicted queuing delay of a packet arriving now
+     */
+    Time PredictQueueDelay (uint32_t size) const;
+
+    void Report (std::ostream & os) const;
+
+private:
+    /* media flow, in the direction of the media packets */
+    typedef std::tuple<uint32_t, uint16_t, uint32_t, uint16_t> FlowKey;
+
+    void OnForward (const Ipv4Header & header, Ptr<const Packet> packet, uint32_t interface);
+    void OnDequeue (Ptr<const Packet> packet);
+    uint32_t GetBacklog () const;
+    void Flush ();
+    void SendHints (const FlowKey & flow, std::vector<Ptr<RcvTime>> hints);
+
+    std::vector<std::pair<uint16_t, uint16_t>> m_ports;
+    Time m_feedbackInterval;
+
+    Ptr<Ipv4L3Protocol> m_ipv4;
+    uint32_t m_interface;
+    Ptr<Queue<Packet>> m_devQueue;
+    Ptr<QueueDisc> m_queueDisc;     /* NULL if the device has no queue disc */
+
+    double_t m_rateBps;             /* dequeue rate while the queue is backlogged */
+    Time m_lastDequeue;
+    uint32_t m_lastDequeueSize;
+    bool m_lastDequeueBacklogged;
+    Time m_lastPrediction;
+
+    std::map<FlowKey, std::vector<Ptr<RcvTime>>> m_pending;
+    EventId m_flushEvent;
+
+    uint64_t m_hintCnt;
+    Time m_predictionSum;
+};  // class ZhugeAgent
+
+};  // namespace ns3
+
+#endif  /* ZHUGE_AGENT_H */